@@ -1,6 +1,7 @@
 #pragma once
 
 #include "math/Common.hpp"
+#include "math/VectorTraits.hpp"
 
 #include <cmath>
 #include <compare>
@@ -9,6 +10,13 @@
 
 namespace RoseCommon
 {
+	/**
+	 * @brief Whether a color component type holds values in range 0 - 1 rather than 0 - 255.
+	 *        Custom component types, such as half-floats and normalized integers, specialize this.
+	 */
+	template <typename T>
+	inline constexpr bool IsNormalizedColorComponent = std::is_floating_point_v<T>;
+
 	/**
 	 * @brief A straight four-component color using red, green, blue, and alpha data.
 	 * @tparam T The type used for each color component.
@@ -16,7 +24,7 @@ namespace RoseCommon
 	template <typename T>
 	class Color
 	{
-		static constexpr T ourSDRUpperBound = std::is_floating_point_v<T> ? static_cast<T>(1) : static_cast<T>(0xFF);
+		static constexpr T ourSDRUpperBound = IsNormalizedColorComponent<T> ? static_cast<T>(1) : static_cast<T>(0xFF);
 	public:
 
 		//--------------------------------------------------
@@ -154,6 +162,41 @@ namespace RoseCommon
 		#pragma endregion
 	};
 
+	namespace _impl
+	{
+		// Branchless 8-bit channel arithmetic, saturating to range 0 - 255.
+
+		constexpr std::uint8_t SaturatingAdd(std::uint8_t aValue, std::uint8_t anOther)
+		{
+			const std::uint32_t sum = static_cast<std::uint32_t>(aValue) + anOther;
+			return static_cast<std::uint8_t>(sum | (0u - (sum >> 8)));
+		}
+
+		constexpr std::uint8_t SaturatingSubtract(std::uint8_t aValue, std::uint8_t anOther)
+		{
+			const std::int32_t difference = static_cast<std::int32_t>(aValue) - anOther;
+			return static_cast<std::uint8_t>(difference & ~(difference >> 31));
+		}
+
+		// Multiply as if both were in range 0 - 1, truncating. Multiplying by 0x8081 and shifting is an exact floor(x / 255) for any product of two bytes.
+		constexpr std::uint8_t NormalizedMultiply(std::uint8_t aValue, std::uint8_t anOther)
+		{
+			return static_cast<std::uint8_t>((static_cast<std::uint32_t>(aValue) * anOther * 0x8081u) >> 23);
+		}
+	}
+
+	namespace Math::_impl
+	{
+		template <typename T>
+		struct VectorTraits<Color<T>>
+		{
+			using Component = T;
+			static constexpr std::size_t Count = 4;
+			static constexpr T Get(const Color<T>& aColor, std::size_t anIndex) { return anIndex == 0 ? aColor.A : (anIndex == 1 ? aColor.R : (anIndex == 2 ? aColor.G : aColor.B)); }
+			static constexpr void Set(Color<T>& aColor, std::size_t anIndex, T aComponent) { (anIndex == 0 ? aColor.A : (anIndex == 1 ? aColor.R : (anIndex == 2 ? aColor.G : aColor.B))) = aComponent; }
+		};
+	}
+
 	template<typename T>
 	constexpr Color<T>::Color()
 		: R(0), G(0), B(0), A(0)
@@ -174,6 +217,13 @@ namespace RoseCommon
 			G /= 0xFF;
 			B /= 0xFF;
 		}
+		else if constexpr (IsNormalizedColorComponent<T>)
+		{
+			A = static_cast<T>(((aPackedArgbValue >> 24) & 0xFF) / 255.f);
+			R = static_cast<T>(((aPackedArgbValue >> 16) & 0xFF) / 255.f);
+			G = static_cast<T>(((aPackedArgbValue >> 8) & 0xFF) / 255.f);
+			B = static_cast<T>(((aPackedArgbValue >> 0) & 0xFF) / 255.f);
+		}
 	}
 
 	template<typename T>
@@ -195,9 +245,9 @@ namespace RoseCommon
 	template<typename T>
 	constexpr float Color<T>::GetBrightness() const
 	{
-		const float r = static_cast<float>(R) / ourSDRUpperBound;
-		const float g = static_cast<float>(G) / ourSDRUpperBound;
-		const float b = static_cast<float>(B) / ourSDRUpperBound;
+		const float r = static_cast<float>(R) / static_cast<float>(ourSDRUpperBound);
+		const float g = static_cast<float>(G) / static_cast<float>(ourSDRUpperBound);
+		const float b = static_cast<float>(B) / static_cast<float>(ourSDRUpperBound);
 
 		return std::max({ r, g, b });
 	}
@@ -208,9 +258,9 @@ namespace RoseCommon
 		if (R == G && G == B)
 			return 0.f;
 
-		const float r = static_cast<float>(R) / ourSDRUpperBound;
-		const float g = static_cast<float>(G) / ourSDRUpperBound;
-		const float b = static_cast<float>(B) / ourSDRUpperBound;
+		const float r = static_cast<float>(R) / static_cast<float>(ourSDRUpperBound);
+		const float g = static_cast<float>(G) / static_cast<float>(ourSDRUpperBound);
+		const float b = static_cast<float>(B) / static_cast<float>(ourSDRUpperBound);
 
 		const float max = std::max({ r, g, b });
 		const float min = std::min({ r, g, b });
@@ -234,9 +284,9 @@ namespace RoseCommon
 	template<typename T>
 	constexpr float Color<T>::GetSaturation() const
 	{
-		const float r = static_cast<float>(R) / ourSDRUpperBound;
-		const float g = static_cast<float>(G) / ourSDRUpperBound;
-		const float b = static_cast<float>(B) / ourSDRUpperBound;
+		const float r = static_cast<float>(R) / static_cast<float>(ourSDRUpperBound);
+		const float g = static_cast<float>(G) / static_cast<float>(ourSDRUpperBound);
+		const float b = static_cast<float>(B) / static_cast<float>(ourSDRUpperBound);
 
 		const float max = std::max({ r, g, b });
 		const float min = std::min({ r, g, b });
@@ -271,6 +321,13 @@ namespace RoseCommon
 			g = static_cast<std::uint8_t>(G * 0xFF);
 			b = static_cast<std::uint8_t>(B * 0xFF);
 		}
+		else if constexpr (IsNormalizedColorComponent<T>)
+		{
+			a = static_cast<std::uint8_t>(static_cast<float>(A) * 0xFF);
+			r = static_cast<std::uint8_t>(static_cast<float>(R) * 0xFF);
+			g = static_cast<std::uint8_t>(static_cast<float>(G) * 0xFF);
+			b = static_cast<std::uint8_t>(static_cast<float>(B) * 0xFF);
+		}
 		else
 		{
 			a = A;
@@ -332,7 +389,7 @@ namespace RoseCommon
 	template <typename T>
 	constexpr void Color<T>::operator+=(const Color& aColor)
 	{
-		if constexpr (std::is_floating_point_v<T>)
+		if constexpr (IsNormalizedColorComponent<T>)
 		{
 			A = Math::Clamp<T>(A + aColor.A, 0, 1);
 			R += aColor.R;
@@ -341,24 +398,17 @@ namespace RoseCommon
 		}
 		else
 		{
-			const int result[] = {
-				static_cast<int>(A) + static_cast<int>(aColor.A),
-				static_cast<int>(R) + static_cast<int>(aColor.R),
-				static_cast<int>(G) + static_cast<int>(aColor.G),
-				static_cast<int>(B) + static_cast<int>(aColor.B)
-			};
-
-			A = static_cast<std::uint8_t>(std::min(result[0], 0xFF));
-			R = static_cast<std::uint8_t>(std::min(result[1], 0xFF));
-			G = static_cast<std::uint8_t>(std::min(result[2], 0xFF));
-			B = static_cast<std::uint8_t>(std::min(result[3], 0xFF));
+			A = _impl::SaturatingAdd(A, aColor.A);
+			R = _impl::SaturatingAdd(R, aColor.R);
+			G = _impl::SaturatingAdd(G, aColor.G);
+			B = _impl::SaturatingAdd(B, aColor.B);
 		}
 	}
 
 	template <typename T>
 	constexpr void Color<T>::operator-=(const Color& aColor)
 	{
-		if constexpr (std::is_floating_point_v<T>)
+		if constexpr (IsNormalizedColorComponent<T>)
 		{
 			A = Math::Clamp<T>(A - aColor.A, 0, 1);
 			R -= aColor.R;
@@ -367,24 +417,17 @@ namespace RoseCommon
 		}
 		else
 		{
-			const int result[] = {
-				static_cast<int>(A) - static_cast<int>(aColor.A),
-				static_cast<int>(R) - static_cast<int>(aColor.R),
-				static_cast<int>(G) - static_cast<int>(aColor.G),
-				static_cast<int>(B) - static_cast<int>(aColor.B)
-			};
-
-			A = static_cast<std::uint8_t>(std::max(result[0], 0));
-			R = static_cast<std::uint8_t>(std::max(result[1], 0));
-			G = static_cast<std::uint8_t>(std::max(result[2], 0));
-			B = static_cast<std::uint8_t>(std::max(result[3], 0));
+			A = _impl::SaturatingSubtract(A, aColor.A);
+			R = _impl::SaturatingSubtract(R, aColor.R);
+			G = _impl::SaturatingSubtract(G, aColor.G);
+			B = _impl::SaturatingSubtract(B, aColor.B);
 		}
 	}
 
 	template <typename T>
 	constexpr void Color<T>::operator*=(const Color& aColor)
 	{
-		if constexpr (std::is_floating_point_v<T>)
+		if constexpr (IsNormalizedColorComponent<T>)
 		{
 			A = Math::Clamp<T>(A * aColor.A, 0, 1);
 			R *= aColor.R;
@@ -393,17 +436,17 @@ namespace RoseCommon
 		}
 		else
 		{
-			A = static_cast<std::uint8_t>(((A / 255.f) * (aColor.A / 255.f)) * 255.f);
-			R = static_cast<std::uint8_t>(((R / 255.f) * (aColor.R / 255.f)) * 255.f);
-			G = static_cast<std::uint8_t>(((G / 255.f) * (aColor.G / 255.f)) * 255.f);
-			B = static_cast<std::uint8_t>(((B / 255.f) * (aColor.B / 255.f)) * 255.f);
+			A = _impl::NormalizedMultiply(A, aColor.A);
+			R = _impl::NormalizedMultiply(R, aColor.R);
+			G = _impl::NormalizedMultiply(G, aColor.G);
+			B = _impl::NormalizedMultiply(B, aColor.B);
 		}
 	}
 
 	template <typename T>
 	constexpr void Color<T>::operator*=(float aScalar)
 	{
-		if constexpr (std::is_floating_point_v<T>)
+		if constexpr (IsNormalizedColorComponent<T>)
 			operator*=(Color(
 				aScalar,
 				aScalar,
@@ -0,0 +1,180 @@
+#pragma once
+
+#include "Color.hpp"
+#include "Simd.hpp"
+
+#include <cstdint>
+#include <span>
+
+namespace RoseCommon
+{
+	namespace ColorArithmetic
+	{
+		/**
+		 * @brief Add colors onto others, saturating each channel like Color::operator+=().
+		 *        Processes 16 or 32 channels per instruction, on the calling thread.
+		 * @param someTargets The colors to add to.
+		 * @param someSources The colors to add, at least as many as the targets.
+		 */
+		void Add(std::span<Color<std::uint8_t>> someTargets, std::span<const Color<std::uint8_t>> someSources);
+
+		/**
+		 * @brief Multiply colors with others as if each channel was in range 0 - 1, like Color::operator*=().
+		 *        Processes 8 or 16 channels per instruction, on the calling thread.
+		 * @param someTargets The colors to multiply.
+		 * @param someSources The colors to multiply with, at least as many as the targets.
+		 */
+		void Multiply(std::span<Color<std::uint8_t>> someTargets, std::span<const Color<std::uint8_t>> someSources);
+
+		/**
+		 * @brief Multiply every channel of colors with the same value as if both were in range 0 - 1.
+		 *        Gives the same result as multiplying with a color of that value in every channel, on the calling thread.
+		 * @param someTargets The colors to multiply.
+		 * @param aScale The value to multiply each channel with.
+		 */
+		void Multiply(std::span<Color<std::uint8_t>> someTargets, std::uint8_t aScale);
+
+		/**
+		 * @brief Subtract colors from others, saturating each channel like Color::operator-=().
+		 *        Processes 16 or 32 channels per instruction, on the calling thread.
+		 * @param someTargets The colors to subtract from.
+		 * @param someSources The colors to subtract, at least as many as the targets.
+		 */
+		void Subtract(std::span<Color<std::uint8_t>> someTargets, std::span<const Color<std::uint8_t>> someSources);
+	}
+}
+
+namespace RoseCommon
+{
+	namespace ColorArithmetic::_impl
+	{
+		// Apply a byte-wise operation to every channel, first in the widest registers available and then one at a time.
+		template <typename Operation>
+		void ForEachChannel(std::span<Color<std::uint8_t>> someTargets, std::span<const Color<std::uint8_t>> someSources)
+		{
+			const Operation operation;
+			std::uint8_t* targets = reinterpret_cast<std::uint8_t*>(someTargets.data());
+			const std::uint8_t* sources = reinterpret_cast<const std::uint8_t*>(someSources.data());
+			const std::size_t channelCount = someTargets.size() * 4;
+			std::size_t i = 0;
+
+#if defined(ROSECOMMON_SIMD_AVX2)
+			for (; i + 32 <= channelCount; i += 32)
+			{
+				__m256i* target = reinterpret_cast<__m256i*>(targets + i);
+				_mm256_storeu_si256(target, operation(_mm256_loadu_si256(target), _mm256_loadu_si256(reinterpret_cast<const __m256i*>(sources + i))));
+			}
+#endif
+
+#if defined(ROSECOMMON_SIMD_SSE2)
+			for (; i + 16 <= channelCount; i += 16)
+			{
+				__m128i* target = reinterpret_cast<__m128i*>(targets + i);
+				_mm_storeu_si128(target, operation(_mm_loadu_si128(target), _mm_loadu_si128(reinterpret_cast<const __m128i*>(sources + i))));
+			}
+#endif
+
+			for (; i < channelCount; ++i)
+				targets[i] = operation(targets[i], sources[i]);
+		}
+
+		// Same as above with one value for every channel, broadcast once into each register width.
+		template <typename Operation>
+		void ForEachChannel(std::span<Color<std::uint8_t>> someTargets, std::uint8_t aValue)
+		{
+			const Operation operation;
+			std::uint8_t* targets = reinterpret_cast<std::uint8_t*>(someTargets.data());
+			const std::size_t channelCount = someTargets.size() * 4;
+			std::size_t i = 0;
+
+#if defined(ROSECOMMON_SIMD_AVX2)
+			const __m256i values256 = _mm256_set1_epi8(static_cast<char>(aValue));
+			for (; i + 32 <= channelCount; i += 32)
+			{
+				__m256i* target = reinterpret_cast<__m256i*>(targets + i);
+				_mm256_storeu_si256(target, operation(_mm256_loadu_si256(target), values256));
+			}
+#endif
+
+#if defined(ROSECOMMON_SIMD_SSE2)
+			const __m128i values128 = _mm_set1_epi8(static_cast<char>(aValue));
+			for (; i + 16 <= channelCount; i += 16)
+			{
+				__m128i* target = reinterpret_cast<__m128i*>(targets + i);
+				_mm_storeu_si128(target, operation(_mm_loadu_si128(target), values128));
+			}
+#endif
+
+			for (; i < channelCount; ++i)
+				targets[i] = operation(targets[i], aValue);
+		}
+
+		struct AddChannels
+		{
+#if defined(ROSECOMMON_SIMD_AVX2)
+			__m256i operator()(__m256i someValues, __m256i someOthers) const { return _mm256_adds_epu8(someValues, someOthers); }
+#endif
+#if defined(ROSECOMMON_SIMD_SSE2)
+			__m128i operator()(__m128i someValues, __m128i someOthers) const { return _mm_adds_epu8(someValues, someOthers); }
+#endif
+			std::uint8_t operator()(std::uint8_t aValue, std::uint8_t anOther) const { return RoseCommon::_impl::SaturatingAdd(aValue, anOther); }
+		};
+
+		struct SubtractChannels
+		{
+#if defined(ROSECOMMON_SIMD_AVX2)
+			__m256i operator()(__m256i someValues, __m256i someOthers) const { return _mm256_subs_epu8(someValues, someOthers); }
+#endif
+#if defined(ROSECOMMON_SIMD_SSE2)
+			__m128i operator()(__m128i someValues, __m128i someOthers) const { return _mm_subs_epu8(someValues, someOthers); }
+#endif
+			std::uint8_t operator()(std::uint8_t aValue, std::uint8_t anOther) const { return RoseCommon::_impl::SaturatingSubtract(aValue, anOther); }
+		};
+
+		// Products of two bytes fit in 16 bits, and the high half of multiplying by 0x8081 shifted by 7 is an exact floor(x / 255).
+		struct MultiplyChannels
+		{
+#if defined(ROSECOMMON_SIMD_AVX2)
+			__m256i operator()(__m256i someValues, __m256i someOthers) const
+			{
+				const __m256i zero = _mm256_setzero_si256();
+				const __m256i divisor = _mm256_set1_epi16(static_cast<short>(0x8081));
+				const __m256i low = _mm256_srli_epi16(_mm256_mulhi_epu16(_mm256_mullo_epi16(_mm256_unpacklo_epi8(someValues, zero), _mm256_unpacklo_epi8(someOthers, zero)), divisor), 7);
+				const __m256i high = _mm256_srli_epi16(_mm256_mulhi_epu16(_mm256_mullo_epi16(_mm256_unpackhi_epi8(someValues, zero), _mm256_unpackhi_epi8(someOthers, zero)), divisor), 7);
+				return _mm256_packus_epi16(low, high);
+			}
+#endif
+#if defined(ROSECOMMON_SIMD_SSE2)
+			__m128i operator()(__m128i someValues, __m128i someOthers) const
+			{
+				const __m128i zero = _mm_setzero_si128();
+				const __m128i divisor = _mm_set1_epi16(static_cast<short>(0x8081));
+				const __m128i low = _mm_srli_epi16(_mm_mulhi_epu16(_mm_mullo_epi16(_mm_unpacklo_epi8(someValues, zero), _mm_unpacklo_epi8(someOthers, zero)), divisor), 7);
+				const __m128i high = _mm_srli_epi16(_mm_mulhi_epu16(_mm_mullo_epi16(_mm_unpackhi_epi8(someValues, zero), _mm_unpackhi_epi8(someOthers, zero)), divisor), 7);
+				return _mm_packus_epi16(low, high);
+			}
+#endif
+			std::uint8_t operator()(std::uint8_t aValue, std::uint8_t anOther) const { return RoseCommon::_impl::NormalizedMultiply(aValue, anOther); }
+		};
+	}
+
+	inline void ColorArithmetic::Add(std::span<Color<std::uint8_t>> someTargets, std::span<const Color<std::uint8_t>> someSources)
+	{
+		_impl::ForEachChannel<_impl::AddChannels>(someTargets, someSources);
+	}
+
+	inline void ColorArithmetic::Multiply(std::span<Color<std::uint8_t>> someTargets, std::span<const Color<std::uint8_t>> someSources)
+	{
+		_impl::ForEachChannel<_impl::MultiplyChannels>(someTargets, someSources);
+	}
+
+	inline void ColorArithmetic::Multiply(std::span<Color<std::uint8_t>> someTargets, std::uint8_t aScale)
+	{
+		_impl::ForEachChannel<_impl::MultiplyChannels>(someTargets, aScale);
+	}
+
+	inline void ColorArithmetic::Subtract(std::span<Color<std::uint8_t>> someTargets, std::span<const Color<std::uint8_t>> someSources)
+	{
+		_impl::ForEachChannel<_impl::SubtractChannels>(someTargets, someSources);
+	}
+}
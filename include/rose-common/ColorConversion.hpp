@@ -0,0 +1,587 @@
+#pragma once
+
+#include "Color.hpp"
+#include "Parallel.hpp"
+#include "Simd.hpp"
+#include "math/Common.hpp"
+
+#include <array>
+#include <bit>
+#include <cmath>
+#include <cstdint>
+#include <span>
+
+namespace RoseCommon
+{
+	/**
+	 * @brief A color in the hue, saturation, brightness model, matching the values of Color::GetHue(), GetSaturation() and GetBrightness().
+	 */
+	struct HSVColor
+	{
+		/**
+		 * @brief The hue, as an angle in the hue circle from 0 up to 360.
+		 */
+		float Hue = 0;
+
+		/**
+		 * @brief The saturation, in range 0 - 1.
+		 */
+		float Saturation = 0;
+
+		/**
+		 * @brief The brightness, in range 0 - 1.
+		 */
+		float Brightness = 0;
+
+		/**
+		 * @brief The alpha, in range 0 - 1.
+		 */
+		float Alpha = 0;
+	};
+
+	namespace ColorConversion
+	{
+		/**
+		 * @brief Convert colors from 8-bit components to floating-point components in range 0 - 1.
+		 * @param someColors The colors to convert.
+		 * @param someResults A buffer for the converted colors, at least as large as the input.
+		 */
+		void Convert(std::span<const Color<std::uint8_t>> someColors, std::span<Color<float>> someResults);
+
+		/**
+		 * @brief Convert colors from floating-point components to 8-bit components, rounding to nearest and clamping to range 0 - 255.
+		 * @param someColors The colors to convert.
+		 * @param someResults A buffer for the converted colors, at least as large as the input.
+		 */
+		void Convert(std::span<const Color<float>> someColors, std::span<Color<std::uint8_t>> someResults);
+
+		/**
+		 * @brief Pack colors into 32-bit unsigned integers with the format 0xAARRGGBB, like Color::ToARGB().
+		 * @param someColors The colors to pack.
+		 * @param someResults A buffer for the packed colors, at least as large as the input.
+		 */
+		void PackARGB(std::span<const Color<std::uint8_t>> someColors, std::span<std::uint32_t> someResults);
+
+		/**
+		 * @brief Pack colors into 32-bit unsigned integers with the format 0xAARRGGBB.
+		 *        Unlike Color::ToARGB(), components are rounded to nearest and clamped rather than truncated.
+		 * @param someColors The colors to pack.
+		 * @param someResults A buffer for the packed colors, at least as large as the input.
+		 */
+		void PackARGB(std::span<const Color<float>> someColors, std::span<std::uint32_t> someResults);
+
+		/**
+		 * @brief Unpack 32-bit unsigned integers with the format 0xAARRGGBB into colors, like the packed Color constructor.
+		 * @param somePackedColors The packed colors.
+		 * @param someResults A buffer for the unpacked colors, at least as large as the input.
+		 */
+		void UnpackARGB(std::span<const std::uint32_t> somePackedColors, std::span<Color<std::uint8_t>> someResults);
+
+		/**
+		 * @brief Unpack 32-bit unsigned integers with the format 0xAARRGGBB into colors, like the packed Color constructor.
+		 * @param somePackedColors The packed colors.
+		 * @param someResults A buffer for the unpacked colors, at least as large as the input.
+		 */
+		void UnpackARGB(std::span<const std::uint32_t> somePackedColors, std::span<Color<float>> someResults);
+
+		/**
+		 * @brief Convert colors to the hue, saturation, brightness model.
+		 * @param someColors The colors to convert, with components in range 0 - 1.
+		 * @param someResults A buffer for the converted colors, at least as large as the input.
+		 */
+		void ToHSV(std::span<const Color<float>> someColors, std::span<HSVColor> someResults);
+
+		/**
+		 * @brief Convert colors from the hue, saturation, brightness model.
+		 * @param someColors The colors to convert, with hues in range 0 - 360.
+		 * @param someResults A buffer for the converted colors, at least as large as the input.
+		 */
+		void FromHSV(std::span<const HSVColor> someColors, std::span<Color<float>> someResults);
+
+		/**
+		 * @brief Convert an sRGB encoded component to linear light.
+		 * @param aValue The encoded component, in range 0 - 1.
+		 */
+		float SRGBToLinear(float aValue);
+
+		/**
+		 * @brief Convert a linear light component to sRGB encoding.
+		 * @param aValue The linear component, in range 0 - 1.
+		 */
+		float LinearToSRGB(float aValue);
+
+		/**
+		 * @brief Convert an sRGB encoded color to linear light, using a lookup table. Alpha is already linear and only rescaled.
+		 * @param aColor The encoded color.
+		 */
+		Color<float> ToLinear(const Color<std::uint8_t>& aColor);
+
+		/**
+		 * @brief Convert a linear light color to sRGB encoding, using a piecewise linear table accurate to within about half a step.
+		 *        Alpha is kept linear and rounded to nearest.
+		 * @param aColor The linear color, with components in range 0 - 1.
+		 */
+		Color<std::uint8_t> ToSRGB(const Color<float>& aColor);
+
+		/**
+		 * @brief Convert sRGB encoded colors to linear light, using a lookup table. Alpha is already linear and only rescaled.
+		 * @param someColors The encoded colors.
+		 * @param someResults A buffer for the linear colors, at least as large as the input.
+		 */
+		void ToLinear(std::span<const Color<std::uint8_t>> someColors, std::span<Color<float>> someResults);
+
+		/**
+		 * @brief Convert linear light colors to sRGB encoding, using a piecewise linear table accurate to within about half a step.
+		 *        Alpha is kept linear and rounded to nearest.
+		 * @param someColors The linear colors, with components in range 0 - 1.
+		 * @param someResults A buffer for the encoded colors, at least as large as the input.
+		 */
+		void ToSRGB(std::span<const Color<float>> someColors, std::span<Color<std::uint8_t>> someResults);
+	}
+}
+
+namespace RoseCommon
+{
+	namespace ColorConversion::_impl
+	{
+		// Enough pixels per chunk for the thread overhead to vanish next to the memory traffic.
+		constexpr std::size_t GrainSize = 1 << 16;
+
+		// The number of pixels deinterleaved at a time for the HSV kernels.
+		constexpr std::size_t BlockSize = 64;
+
+		template <typename Function>
+		void ForEachChunk(std::size_t aCount, Function&& aFunction)
+		{
+			Parallel::ForEachChunk(aCount, Parallel::GetChunkCount(aCount, GrainSize), [&](std::size_t, std::size_t aBegin, std::size_t anEnd)
+			{
+				aFunction(aBegin, anEnd);
+			});
+		}
+
+		inline std::uint8_t ToByte(float aValue)
+		{
+			// Round to nearest even like the SIMD conversion, and clamp like its saturating packs.
+			return static_cast<std::uint8_t>(Math::Clamp<float>(std::nearbyint(aValue * 255.f), 0.f, 255.f));
+		}
+
+		inline std::uint32_t ReverseBytes(std::uint32_t aValue)
+		{
+			return (aValue >> 24) | ((aValue >> 8) & 0x0000FF00u) | ((aValue << 8) & 0x00FF0000u) | (aValue << 24);
+		}
+
+#if defined(ROSECOMMON_SIMD_SSE2)
+		inline __m128i ReverseBytes(__m128i someValues)
+		{
+			const __m128i byteMask = _mm_set1_epi32(0x0000FF00);
+			return _mm_or_si128(
+				_mm_or_si128(_mm_srli_epi32(someValues, 24), _mm_and_si128(_mm_srli_epi32(someValues, 8), byteMask)),
+				_mm_or_si128(_mm_slli_epi32(_mm_and_si128(someValues, byteMask), 8), _mm_slli_epi32(someValues, 24))
+			);
+		}
+
+		// Widen four pixels of 8-bit components in memory order into four vectors of floats in range 0 - 1.
+		inline void WidenBytes(__m128i somePixels, __m128 (&someResults)[4])
+		{
+			const __m128i zero = _mm_setzero_si128();
+			const __m128 scale = _mm_set1_ps(1.f / 255.f);
+			const __m128i low = _mm_unpacklo_epi8(somePixels, zero);
+			const __m128i high = _mm_unpackhi_epi8(somePixels, zero);
+			someResults[0] = _mm_mul_ps(_mm_cvtepi32_ps(_mm_unpacklo_epi16(low, zero)), scale);
+			someResults[1] = _mm_mul_ps(_mm_cvtepi32_ps(_mm_unpackhi_epi16(low, zero)), scale);
+			someResults[2] = _mm_mul_ps(_mm_cvtepi32_ps(_mm_unpacklo_epi16(high, zero)), scale);
+			someResults[3] = _mm_mul_ps(_mm_cvtepi32_ps(_mm_unpackhi_epi16(high, zero)), scale);
+		}
+
+		// Narrow four pixels of float components into 8-bit components in memory order, rounding to nearest and saturating.
+		inline __m128i NarrowFloats(const float* someComponents)
+		{
+			const __m128 scale = _mm_set1_ps(255.f);
+			const __m128i pixel0 = _mm_cvtps_epi32(_mm_mul_ps(_mm_loadu_ps(someComponents + 0), scale));
+			const __m128i pixel1 = _mm_cvtps_epi32(_mm_mul_ps(_mm_loadu_ps(someComponents + 4), scale));
+			const __m128i pixel2 = _mm_cvtps_epi32(_mm_mul_ps(_mm_loadu_ps(someComponents + 8), scale));
+			const __m128i pixel3 = _mm_cvtps_epi32(_mm_mul_ps(_mm_loadu_ps(someComponents + 12), scale));
+			return _mm_packus_epi16(_mm_packs_epi32(pixel0, pixel1), _mm_packs_epi32(pixel2, pixel3));
+		}
+#endif
+
+		// Convert 8-bit pixels to float pixels, optionally reversing the component order of each pixel.
+		template <bool ReverseOrder>
+		void WidenPixels(const std::uint8_t* someSource, float* someTarget, std::size_t aBegin, std::size_t anEnd)
+		{
+			std::size_t i = aBegin;
+
+#if defined(ROSECOMMON_SIMD_SSE2)
+			for (; i + 4 <= anEnd; i += 4)
+			{
+				__m128 pixels[4];
+				WidenBytes(_mm_loadu_si128(reinterpret_cast<const __m128i*>(someSource + i * 4)), pixels);
+				for (std::size_t p = 0; p < 4; ++p)
+				{
+					if constexpr (ReverseOrder)
+						pixels[p] = _mm_shuffle_ps(pixels[p], pixels[p], _MM_SHUFFLE(0, 1, 2, 3));
+					_mm_storeu_ps(someTarget + (i + p) * 4, pixels[p]);
+				}
+			}
+#endif
+
+			for (; i < anEnd; ++i)
+			{
+				for (std::size_t c = 0; c < 4; ++c)
+					someTarget[i * 4 + c] = someSource[i * 4 + (ReverseOrder ? 3 - c : c)] * (1.f / 255.f);
+			}
+		}
+
+		// Convert float pixels to 8-bit pixels, optionally reversing the component order of each pixel.
+		template <bool ReverseOrder>
+		void NarrowPixels(const float* someSource, std::uint8_t* someTarget, std::size_t aBegin, std::size_t anEnd)
+		{
+			std::size_t i = aBegin;
+
+#if defined(ROSECOMMON_SIMD_SSE2)
+			for (; i + 4 <= anEnd; i += 4)
+			{
+				__m128i pixels = NarrowFloats(someSource + i * 4);
+				if constexpr (ReverseOrder)
+					pixels = ReverseBytes(pixels);
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(someTarget + i * 4), pixels);
+			}
+#endif
+
+			for (; i < anEnd; ++i)
+			{
+				for (std::size_t c = 0; c < 4; ++c)
+					someTarget[i * 4 + (ReverseOrder ? 3 - c : c)] = ToByte(someSource[i * 4 + c]);
+			}
+		}
+
+		inline void ReversePixels(const std::uint32_t* someSource, std::uint32_t* someTarget, std::size_t aBegin, std::size_t anEnd)
+		{
+			std::size_t i = aBegin;
+
+#if defined(ROSECOMMON_SIMD_SSE2)
+			for (; i + 4 <= anEnd; i += 4)
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(someTarget + i), ReverseBytes(_mm_loadu_si128(reinterpret_cast<const __m128i*>(someSource + i))));
+#endif
+
+			for (; i < anEnd; ++i)
+				someTarget[i] = ReverseBytes(someSource[i]);
+		}
+
+		template <typename Pack>
+		void ToHSV(const float* someR, const float* someG, const float* someB, float* someHue, float* someSaturation, float* someBrightness)
+		{
+			const Pack r = Pack::Load(someR);
+			const Pack g = Pack::Load(someG);
+			const Pack b = Pack::Load(someB);
+
+			const Pack zero = Pack::Broadcast(0.f);
+			const Pack max = Pack::Max(Pack::Max(r, g), b);
+			const Pack min = Pack::Min(Pack::Min(r, g), b);
+			const Pack delta = max - min;
+
+			// Pick the hue formula of the largest component, preferring red, then green, like Color::GetHue().
+			const Pack redHue = (g - b) / delta;
+			const Pack wrappedRedHue = Pack::Select(redHue < zero, redHue + Pack::Broadcast(6.f), redHue);
+			const Pack greenHue = Pack::Broadcast(2.f) + (b - r) / delta;
+			const Pack blueHue = Pack::Broadcast(4.f) + (r - g) / delta;
+
+			Pack hue = Pack::Select(g >= max, greenHue, blueHue);
+			hue = Pack::Select(r >= max, wrappedRedHue, hue);
+			hue = Pack::Select(delta > zero, hue * Pack::Broadcast(60.f), zero);
+
+			Pack::Select(max > zero, delta / max, zero).Store(someSaturation);
+			hue.Store(someHue);
+			max.Store(someBrightness);
+		}
+
+		template <typename Pack>
+		void FromHSV(const float* someHue, const float* someSaturation, const float* someBrightness, float* someR, float* someG, float* someB)
+		{
+			const Pack sector = Pack::Load(someHue) * Pack::Broadcast(1.f / 60.f);
+			const Pack saturation = Pack::Load(someSaturation);
+			const Pack brightness = Pack::Load(someBrightness);
+			const Pack chroma = brightness * saturation;
+
+			const Pack zero = Pack::Broadcast(0.f);
+			const Pack one = Pack::Broadcast(1.f);
+			const Pack four = Pack::Broadcast(4.f);
+			const Pack six = Pack::Broadcast(6.f);
+
+			// Each component is f(n) = V - V * S * max(0, min(k, 4 - k, 1)), with k = (n + H / 60) mod 6.
+			auto component = [&](float anOffset)
+			{
+				Pack k = sector + Pack::Broadcast(anOffset);
+				k = Pack::Select(k >= six, k - six, k);
+				const Pack ramp = Pack::Max(zero, Pack::Min(Pack::Min(k, four - k), one));
+				return brightness - chroma * ramp;
+			};
+
+			component(5.f).Store(someR);
+			component(3.f).Store(someG);
+			component(1.f).Store(someB);
+		}
+
+		// Encoding splits the range from 2^-13 up to 1 into eight linear pieces per octave, indexed straight from the float bits.
+		// Anything below 2^-13 encodes to zero.
+		constexpr std::uint32_t SRGBEncodeMinBits = (127 - 13) << 23;
+		constexpr std::uint32_t SRGBEncodeAlmostOneBits = 0x3F7FFFFF;
+		constexpr std::size_t SRGBEncodePieceShift = 20;
+		constexpr std::size_t SRGBEncodePieceCount = 13 * 8;
+
+		struct SRGBEncodePiece
+		{
+			float Bias;
+			float Scale;
+		};
+
+		using SRGBEncodeTable = std::array<SRGBEncodePiece, SRGBEncodePieceCount>;
+
+		inline const std::array<float, 256>& GetSRGBDecodeTable()
+		{
+			static const std::array<float, 256> table = []()
+			{
+				std::array<float, 256> values;
+				for (std::size_t i = 0; i < values.size(); ++i)
+					values[i] = SRGBToLinear(static_cast<float>(i) / 255.f);
+				return values;
+			}();
+			return table;
+		}
+
+		inline const SRGBEncodeTable& GetSRGBEncodeTable()
+		{
+			static const SRGBEncodeTable table = []()
+			{
+				constexpr std::uint32_t sampleCount = 16;
+
+				auto encode = [](std::uint32_t someBits) { return 255.0 * LinearToSRGB(std::bit_cast<float>(someBits)); };
+
+				SRGBEncodeTable pieces;
+				for (std::size_t i = 0; i < pieces.size(); ++i)
+				{
+					const std::uint32_t startBits = SRGBEncodeMinBits + static_cast<std::uint32_t>(i << SRGBEncodePieceShift);
+					const std::uint32_t pieceBits = 1u << SRGBEncodePieceShift;
+					const double start = encode(startBits);
+					const double scale = encode(startBits + pieceBits) - start;
+
+					// Center the line within the error band of the curve, then add a half to turn truncation into rounding.
+					double minError = 0, maxError = 0;
+					for (std::uint32_t s = 1; s < sampleCount; ++s)
+					{
+						const double error = encode(startBits + pieceBits * s / sampleCount) - (start + scale * static_cast<double>(s) / sampleCount);
+						minError = Math::Min(minError, error);
+						maxError = Math::Max(maxError, error);
+					}
+
+					pieces[i] = SRGBEncodePiece{ static_cast<float>(start + (minError + maxError) / 2 + 0.5), static_cast<float>(scale) };
+				}
+				return pieces;
+			}();
+			return table;
+		}
+
+		inline std::uint8_t EncodeSRGB(float aValue, const SRGBEncodeTable& aTable)
+		{
+			const float minValue = std::bit_cast<float>(SRGBEncodeMinBits);
+			const float almostOne = std::bit_cast<float>(SRGBEncodeAlmostOneBits);
+
+			// Written so that NaN falls through to the minimum.
+			const float clamped = aValue > minValue ? (aValue < almostOne ? aValue : almostOne) : minValue;
+			const std::uint32_t bits = std::bit_cast<std::uint32_t>(clamped);
+			const SRGBEncodePiece& piece = aTable[(bits - SRGBEncodeMinBits) >> SRGBEncodePieceShift];
+			const float amount = static_cast<float>(bits & ((1u << SRGBEncodePieceShift) - 1)) * (1.f / (1u << SRGBEncodePieceShift));
+			return static_cast<std::uint8_t>(piece.Bias + piece.Scale * amount);
+		}
+
+#if defined(ROSECOMMON_SIMD_SSE2)
+		// Encode one pixel of floats in memory order into 32-bit integers, keeping the alpha in the first lane linear.
+		inline __m128i EncodeSRGB(__m128 aPixel, const SRGBEncodeTable& aTable)
+		{
+			const __m128 clamped = _mm_min_ps(_mm_max_ps(aPixel, _mm_castsi128_ps(_mm_set1_epi32(SRGBEncodeMinBits))), _mm_castsi128_ps(_mm_set1_epi32(SRGBEncodeAlmostOneBits)));
+			const __m128i bits = _mm_castps_si128(clamped);
+
+			alignas(16) std::uint32_t pieces[4];
+			_mm_store_si128(reinterpret_cast<__m128i*>(pieces), _mm_srli_epi32(_mm_sub_epi32(bits, _mm_set1_epi32(SRGBEncodeMinBits)), SRGBEncodePieceShift));
+
+			const SRGBEncodePiece& piece0 = aTable[pieces[0]];
+			const SRGBEncodePiece& piece1 = aTable[pieces[1]];
+			const SRGBEncodePiece& piece2 = aTable[pieces[2]];
+			const SRGBEncodePiece& piece3 = aTable[pieces[3]];
+			const __m128 bias = _mm_setr_ps(piece0.Bias, piece1.Bias, piece2.Bias, piece3.Bias);
+			const __m128 scale = _mm_setr_ps(piece0.Scale, piece1.Scale, piece2.Scale, piece3.Scale);
+
+			const __m128 amount = _mm_mul_ps(_mm_cvtepi32_ps(_mm_and_si128(bits, _mm_set1_epi32((1 << SRGBEncodePieceShift) - 1))), _mm_set1_ps(1.f / (1 << SRGBEncodePieceShift)));
+			const __m128i encoded = _mm_cvttps_epi32(_mm_add_ps(bias, _mm_mul_ps(scale, amount)));
+			const __m128i alpha = _mm_cvtps_epi32(_mm_mul_ps(aPixel, _mm_set1_ps(255.f)));
+
+			const __m128i alphaMask = _mm_setr_epi32(-1, 0, 0, 0);
+			return _mm_or_si128(_mm_and_si128(alphaMask, alpha), _mm_andnot_si128(alphaMask, encoded));
+		}
+#endif
+	}
+
+	inline void ColorConversion::Convert(std::span<const Color<std::uint8_t>> someColors, std::span<Color<float>> someResults)
+	{
+		const std::uint8_t* source = reinterpret_cast<const std::uint8_t*>(someColors.data());
+		float* target = reinterpret_cast<float*>(someResults.data());
+		_impl::ForEachChunk(someColors.size(), [&](std::size_t aBegin, std::size_t anEnd) { _impl::WidenPixels<false>(source, target, aBegin, anEnd); });
+	}
+
+	inline void ColorConversion::Convert(std::span<const Color<float>> someColors, std::span<Color<std::uint8_t>> someResults)
+	{
+		const float* source = reinterpret_cast<const float*>(someColors.data());
+		std::uint8_t* target = reinterpret_cast<std::uint8_t*>(someResults.data());
+		_impl::ForEachChunk(someColors.size(), [&](std::size_t aBegin, std::size_t anEnd) { _impl::NarrowPixels<false>(source, target, aBegin, anEnd); });
+	}
+
+	inline void ColorConversion::PackARGB(std::span<const Color<std::uint8_t>> someColors, std::span<std::uint32_t> someResults)
+	{
+		const std::uint32_t* source = reinterpret_cast<const std::uint32_t*>(someColors.data());
+		_impl::ForEachChunk(someColors.size(), [&](std::size_t aBegin, std::size_t anEnd) { _impl::ReversePixels(source, someResults.data(), aBegin, anEnd); });
+	}
+
+	inline void ColorConversion::PackARGB(std::span<const Color<float>> someColors, std::span<std::uint32_t> someResults)
+	{
+		const float* source = reinterpret_cast<const float*>(someColors.data());
+		std::uint8_t* target = reinterpret_cast<std::uint8_t*>(someResults.data());
+		_impl::ForEachChunk(someColors.size(), [&](std::size_t aBegin, std::size_t anEnd) { _impl::NarrowPixels<true>(source, target, aBegin, anEnd); });
+	}
+
+	inline void ColorConversion::UnpackARGB(std::span<const std::uint32_t> somePackedColors, std::span<Color<std::uint8_t>> someResults)
+	{
+		std::uint32_t* target = reinterpret_cast<std::uint32_t*>(someResults.data());
+		_impl::ForEachChunk(somePackedColors.size(), [&](std::size_t aBegin, std::size_t anEnd) { _impl::ReversePixels(somePackedColors.data(), target, aBegin, anEnd); });
+	}
+
+	inline void ColorConversion::UnpackARGB(std::span<const std::uint32_t> somePackedColors, std::span<Color<float>> someResults)
+	{
+		const std::uint8_t* source = reinterpret_cast<const std::uint8_t*>(somePackedColors.data());
+		float* target = reinterpret_cast<float*>(someResults.data());
+		_impl::ForEachChunk(somePackedColors.size(), [&](std::size_t aBegin, std::size_t anEnd) { _impl::WidenPixels<true>(source, target, aBegin, anEnd); });
+	}
+
+	inline void ColorConversion::ToHSV(std::span<const Color<float>> someColors, std::span<HSVColor> someResults)
+	{
+		_impl::ForEachChunk(someColors.size(), [&](std::size_t aBegin, std::size_t anEnd)
+		{
+			using Block = std::array<float, _impl::BlockSize>;
+			Block r, g, b, hue, saturation, brightness;
+
+			for (std::size_t first = aBegin; first < anEnd; first += _impl::BlockSize)
+			{
+				const std::size_t count = Math::Min<std::size_t>(_impl::BlockSize, anEnd - first);
+
+				for (std::size_t i = 0; i < count; ++i)
+				{
+					r[i] = someColors[first + i].R;
+					g[i] = someColors[first + i].G;
+					b[i] = someColors[first + i].B;
+				}
+
+				Simd::ForEachPack<float>(count, [&]<typename Pack>(std::size_t anIndex)
+				{
+					_impl::ToHSV<Pack>(&r[anIndex], &g[anIndex], &b[anIndex], &hue[anIndex], &saturation[anIndex], &brightness[anIndex]);
+				});
+
+				for (std::size_t i = 0; i < count; ++i)
+					someResults[first + i] = HSVColor{ hue[i], saturation[i], brightness[i], someColors[first + i].A };
+			}
+		});
+	}
+
+	inline void ColorConversion::FromHSV(std::span<const HSVColor> someColors, std::span<Color<float>> someResults)
+	{
+		_impl::ForEachChunk(someColors.size(), [&](std::size_t aBegin, std::size_t anEnd)
+		{
+			using Block = std::array<float, _impl::BlockSize>;
+			Block hue, saturation, brightness, r, g, b;
+
+			for (std::size_t first = aBegin; first < anEnd; first += _impl::BlockSize)
+			{
+				const std::size_t count = Math::Min<std::size_t>(_impl::BlockSize, anEnd - first);
+
+				for (std::size_t i = 0; i < count; ++i)
+				{
+					hue[i] = someColors[first + i].Hue;
+					saturation[i] = someColors[first + i].Saturation;
+					brightness[i] = someColors[first + i].Brightness;
+				}
+
+				Simd::ForEachPack<float>(count, [&]<typename Pack>(std::size_t anIndex)
+				{
+					_impl::FromHSV<Pack>(&hue[anIndex], &saturation[anIndex], &brightness[anIndex], &r[anIndex], &g[anIndex], &b[anIndex]);
+				});
+
+				for (std::size_t i = 0; i < count; ++i)
+					someResults[first + i] = Color<float>(someColors[first + i].Alpha, r[i], g[i], b[i]);
+			}
+		});
+	}
+
+	inline float ColorConversion::SRGBToLinear(float aValue)
+	{
+		if (aValue <= 0.04045f)
+			return aValue / 12.92f;
+
+		return std::pow((aValue + 0.055f) / 1.055f, 2.4f);
+	}
+
+	inline float ColorConversion::LinearToSRGB(float aValue)
+	{
+		if (aValue <= 0.0031308f)
+			return aValue * 12.92f;
+
+		return 1.055f * std::pow(aValue, 1.f / 2.4f) - 0.055f;
+	}
+
+	inline Color<float> ColorConversion::ToLinear(const Color<std::uint8_t>& aColor)
+	{
+		const std::array<float, 256>& table = _impl::GetSRGBDecodeTable();
+		return Color<float>(aColor.A * (1.f / 255.f), table[aColor.R], table[aColor.G], table[aColor.B]);
+	}
+
+	inline Color<std::uint8_t> ColorConversion::ToSRGB(const Color<float>& aColor)
+	{
+		const _impl::SRGBEncodeTable& table = _impl::GetSRGBEncodeTable();
+		return Color<std::uint8_t>(_impl::ToByte(aColor.A), _impl::EncodeSRGB(aColor.R, table), _impl::EncodeSRGB(aColor.G, table), _impl::EncodeSRGB(aColor.B, table));
+	}
+
+	inline void ColorConversion::ToLinear(std::span<const Color<std::uint8_t>> someColors, std::span<Color<float>> someResults)
+	{
+		const std::array<float, 256>& table = _impl::GetSRGBDecodeTable();
+		_impl::ForEachChunk(someColors.size(), [&](std::size_t aBegin, std::size_t anEnd)
+		{
+			for (std::size_t i = aBegin; i < anEnd; ++i)
+			{
+				const Color<std::uint8_t>& color = someColors[i];
+				someResults[i] = Color<float>(color.A * (1.f / 255.f), table[color.R], table[color.G], table[color.B]);
+			}
+		});
+	}
+
+	inline void ColorConversion::ToSRGB(std::span<const Color<float>> someColors, std::span<Color<std::uint8_t>> someResults)
+	{
+		const _impl::SRGBEncodeTable& table = _impl::GetSRGBEncodeTable();
+		_impl::ForEachChunk(someColors.size(), [&](std::size_t aBegin, std::size_t anEnd)
+		{
+			std::size_t i = aBegin;
+
+#if defined(ROSECOMMON_SIMD_SSE2)
+			const float* source = reinterpret_cast<const float*>(someColors.data());
+			std::uint8_t* target = reinterpret_cast<std::uint8_t*>(someResults.data());
+			for (; i + 4 <= anEnd; i += 4)
+			{
+				const __m128i pixel0 = _impl::EncodeSRGB(_mm_loadu_ps(source + i * 4 + 0), table);
+				const __m128i pixel1 = _impl::EncodeSRGB(_mm_loadu_ps(source + i * 4 + 4), table);
+				const __m128i pixel2 = _impl::EncodeSRGB(_mm_loadu_ps(source + i * 4 + 8), table);
+				const __m128i pixel3 = _impl::EncodeSRGB(_mm_loadu_ps(source + i * 4 + 12), table);
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(target + i * 4), _mm_packus_epi16(_mm_packs_epi32(pixel0, pixel1), _mm_packs_epi32(pixel2, pixel3)));
+			}
+#endif
+
+			for (; i < anEnd; ++i)
+				someResults[i] = ToSRGB(someColors[i]);
+		});
+	}
+}
@@ -0,0 +1,628 @@
+#pragma once
+
+#include "Color.hpp"
+#include "ColorArithmetic.hpp"
+#include "Parallel.hpp"
+#include "Simd.hpp"
+#include "math/Common.hpp"
+#include "math/Geometry.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+namespace RoseCommon
+{
+	/**
+	 * @brief A non-owning view of a two-dimensional grid of colors, where rows are a fixed stride apart in memory.
+	 *        The compositing methods mirror the Color operators, process several pixels at a time, and split large images into bands of rows processed concurrently.
+	 * @tparam T The color component type, either a floating-point type or std::uint8_t. A const component type makes a read-only view.
+	 */
+	template <typename T>
+	class ImageView
+	{
+	public:
+
+		//--------------------------------------------------
+		// * Types
+		//--------------------------------------------------
+		#pragma region Types
+
+		using Component = std::remove_const_t<T>;
+		using Pixel = std::conditional_t<std::is_const_v<T>, const Color<Component>, Color<Component>>;
+
+		static_assert(std::is_floating_point_v<Component> || std::is_same_v<Component, std::uint8_t>, "Image components must be floating-point or 8-bit.");
+
+		#pragma endregion
+
+		//--------------------------------------------------
+		// * Construction
+		//--------------------------------------------------
+		#pragma region Construction
+
+		/**
+		 * @brief Initialize an empty view.
+		 */
+		ImageView() = default;
+
+		/**
+		 * @brief Initialize a view of existing pixel data.
+		 * @param someData The first pixel of the first row.
+		 * @param aWidth The number of pixels per row.
+		 * @param aHeight The number of rows.
+		 * @param aStride The number of pixels from the start of one row to the start of the next, at least the width.
+		 */
+		ImageView(Pixel* someData, std::size_t aWidth, std::size_t aHeight, std::size_t aStride);
+
+		#pragma endregion
+
+		//--------------------------------------------------
+		// * Properties
+		//--------------------------------------------------
+		#pragma region Properties
+
+		/**
+		 * @brief Get the area covered by the view, located at (0, 0).
+		 */
+		Math::Rectangle<int> Bounds() const { return Math::Rectangle<int>(Math::Size<int>(static_cast<int>(myWidth), static_cast<int>(myHeight))); }
+
+		/**
+		 * @brief Get the first pixel of the first row.
+		 */
+		Pixel* Data() const { return myData; }
+
+		/**
+		 * @brief Get the number of rows.
+		 */
+		std::size_t Height() const { return myHeight; }
+
+		/**
+		 * @brief Get the number of pixels from the start of one row to the start of the next.
+		 */
+		std::size_t Stride() const { return myStride; }
+
+		/**
+		 * @brief Get the number of pixels per row.
+		 */
+		std::size_t Width() const { return myWidth; }
+
+		#pragma endregion
+
+		//--------------------------------------------------
+		// * Methods
+		//--------------------------------------------------
+		#pragma region Methods
+
+		/**
+		 * @brief Get a pixel.
+		 * @param anX The column of the pixel.
+		 * @param aY The row of the pixel.
+		 */
+		Pixel& GetPixel(std::size_t anX, std::size_t aY) const;
+
+		/**
+		 * @brief Get the pixels of a row.
+		 * @param aY The index of the row.
+		 */
+		std::span<Pixel> GetRow(std::size_t aY) const;
+
+		/**
+		 * @brief Get a view of part of the image.
+		 * @param aRectangle The area of the view, which must lie within its bounds.
+		 */
+		ImageView GetSubView(const Math::Rectangle<int>& aRectangle) const;
+
+		/**
+		 * @brief Copy another image onto this one, clipped to the bounds of both.
+		 * @param aSource The image to copy from.
+		 * @param aPosition Where to place the top-left corner of the source.
+		 */
+		void Blit(ImageView<const Component> aSource, const Math::Point<int>& aPosition = Math::Point<int>(0, 0)) const requires(!std::is_const_v<T>);
+
+		/**
+		 * @brief Add another image to this one, like Color::operator+=().
+		 * @param aSource The image to add, clipped to the bounds of both.
+		 * @param aPosition Where to place the top-left corner of the source.
+		 */
+		void BlendAdd(ImageView<const Component> aSource, const Math::Point<int>& aPosition = Math::Point<int>(0, 0)) const requires(!std::is_const_v<T>);
+
+		/**
+		 * @brief Multiply this image with another, like Color::operator*=().
+		 * @param aSource The image to multiply with, clipped to the bounds of both.
+		 * @param aPosition Where to place the top-left corner of the source.
+		 */
+		void BlendMultiply(ImageView<const Component> aSource, const Math::Point<int>& aPosition = Math::Point<int>(0, 0)) const requires(!std::is_const_v<T>);
+
+		/**
+		 * @brief Draw another image over this one, where both have premultiplied alpha.
+		 * @param aSource The image to draw, clipped to the bounds of both.
+		 * @param aPosition Where to place the top-left corner of the source.
+		 */
+		void BlendOver(ImageView<const Component> aSource, const Math::Point<int>& aPosition = Math::Point<int>(0, 0)) const requires(!std::is_const_v<T>);
+
+		/**
+		 * @brief Set every pixel to a color.
+		 * @param aColor The color to fill with.
+		 */
+		void Fill(const Color<Component>& aColor) const requires(!std::is_const_v<T>);
+
+		/**
+		 * @brief Multiply every pixel by a scalar, like Color::operator*=(float).
+		 * @param aScalar The amount to scale by. For 8-bit images it is clamped to range 0 - 1.
+		 */
+		void Scale(float aScalar) const requires(!std::is_const_v<T>);
+
+		#pragma endregion
+
+		//--------------------------------------------------
+		// * Operators
+		//--------------------------------------------------
+		#pragma region Operators
+
+		operator ImageView<const Component>() const requires(!std::is_const_v<T>) { return ImageView<const Component>(myData, myWidth, myHeight, myStride); }
+
+		#pragma endregion
+
+	private:
+		template <typename Kernel>
+		void ForEachRowPair(const ImageView<const Component>& aSource, const Math::Point<int>& aPosition, Kernel&& aKernel) const;
+
+		Pixel* myData = nullptr;
+		std::size_t myWidth = 0;
+		std::size_t myHeight = 0;
+		std::size_t myStride = 0;
+	};
+
+	/**
+	 * @brief A two-dimensional grid of colors, stored contiguously row by row.
+	 *        Drawing and compositing is done through views of the image.
+	 * @tparam T The color component type, either a floating-point type or std::uint8_t.
+	 */
+	template <typename T>
+	class Image
+	{
+	public:
+
+		//--------------------------------------------------
+		// * Construction
+		//--------------------------------------------------
+		#pragma region Construction
+
+		/**
+		 * @brief Initialize an empty image.
+		 */
+		Image() = default;
+
+		/**
+		 * @brief Initialize an image of a specific size.
+		 * @param aWidth The number of pixels per row.
+		 * @param aHeight The number of rows.
+		 * @param aColor The initial color of every pixel.
+		 */
+		Image(std::size_t aWidth, std::size_t aHeight, const Color<T>& aColor = Color<T>());
+
+		#pragma endregion
+
+		//--------------------------------------------------
+		// * Properties
+		//--------------------------------------------------
+		#pragma region Properties
+
+		/**
+		 * @brief Get the area covered by the image, located at (0, 0).
+		 */
+		Math::Rectangle<int> Bounds() const { return GetView().Bounds(); }
+
+		/**
+		 * @brief Get the pixels, row by row.
+		 */
+		std::span<Color<T>> Data() { return myPixels; }
+
+		/**
+		 * @brief Get the pixels, row by row.
+		 */
+		std::span<const Color<T>> Data() const { return myPixels; }
+
+		/**
+		 * @brief Get the number of rows.
+		 */
+		std::size_t Height() const { return myHeight; }
+
+		/**
+		 * @brief Get the number of pixels per row.
+		 */
+		std::size_t Width() const { return myWidth; }
+
+		#pragma endregion
+
+		//--------------------------------------------------
+		// * Methods
+		//--------------------------------------------------
+		#pragma region Methods
+
+		/**
+		 * @brief Get a pixel.
+		 * @param anX The column of the pixel.
+		 * @param aY The row of the pixel.
+		 */
+		Color<T>& GetPixel(std::size_t anX, std::size_t aY) { return GetView().GetPixel(anX, aY); }
+
+		/**
+		 * @brief Get a pixel.
+		 * @param anX The column of the pixel.
+		 * @param aY The row of the pixel.
+		 */
+		const Color<T>& GetPixel(std::size_t anX, std::size_t aY) const { return GetView().GetPixel(anX, aY); }
+
+		/**
+		 * @brief Get the pixels of a row.
+		 * @param aY The index of the row.
+		 */
+		std::span<Color<T>> GetRow(std::size_t aY) { return GetView().GetRow(aY); }
+
+		/**
+		 * @brief Get the pixels of a row.
+		 * @param aY The index of the row.
+		 */
+		std::span<const Color<T>> GetRow(std::size_t aY) const { return GetView().GetRow(aY); }
+
+		/**
+		 * @brief Get a view of part of the image.
+		 * @param aRectangle The area of the view, which must lie within the image.
+		 */
+		ImageView<T> GetSubView(const Math::Rectangle<int>& aRectangle) { return GetView().GetSubView(aRectangle); }
+
+		/**
+		 * @brief Get a read-only view of part of the image.
+		 * @param aRectangle The area of the view, which must lie within the image.
+		 */
+		ImageView<const T> GetSubView(const Math::Rectangle<int>& aRectangle) const { return GetView().GetSubView(aRectangle); }
+
+		/**
+		 * @brief Get a view of the whole image.
+		 */
+		ImageView<T> GetView() { return ImageView<T>(myPixels.data(), myWidth, myHeight, myWidth); }
+
+		/**
+		 * @brief Get a read-only view of the whole image.
+		 */
+		ImageView<const T> GetView() const { return ImageView<const T>(myPixels.data(), myWidth, myHeight, myWidth); }
+
+		#pragma endregion
+
+		//--------------------------------------------------
+		// * Operators
+		//--------------------------------------------------
+		#pragma region Operators
+
+		operator ImageView<T>() { return GetView(); }
+		operator ImageView<const T>() const { return GetView(); }
+
+		#pragma endregion
+
+	private:
+		std::vector<Color<T>> myPixels;
+		std::size_t myWidth = 0;
+		std::size_t myHeight = 0;
+	};
+}
+
+namespace RoseCommon
+{
+	namespace _impl
+	{
+		// Enough pixels per band for the thread overhead to vanish next to the memory traffic.
+		constexpr std::size_t ImageGrainSize = 1 << 16;
+
+		template <typename Function>
+		void ForEachRowBand(std::size_t aWidth, std::size_t aHeight, Function&& aFunction)
+		{
+			const std::size_t grainRows = Math::Max<std::size_t>(1, ImageGrainSize / Math::Max<std::size_t>(1, aWidth));
+			Parallel::ForEachChunk(aHeight, Parallel::GetChunkCount(aHeight, grainRows), [&](std::size_t, std::size_t aBegin, std::size_t anEnd)
+			{
+				aFunction(aBegin, anEnd);
+			});
+		}
+
+		// Divide by 255 with rounding, exact for the product of two 8-bit values.
+		constexpr std::uint32_t DivideBy255(std::uint32_t aValue)
+		{
+			return (aValue + 128 + ((aValue + 128) >> 8)) >> 8;
+		}
+
+#if defined(ROSECOMMON_SIMD_SSE2)
+		inline __m128i DivideBy255(__m128i someValues)
+		{
+			const __m128i rounded = _mm_add_epi16(someValues, _mm_set1_epi16(128));
+			return _mm_srli_epi16(_mm_add_epi16(rounded, _mm_srli_epi16(rounded, 8)), 8);
+		}
+#endif
+
+		// Float rows are processed as flat channels, and packs start on a pixel so alpha is every fourth lane from the first.
+		inline constexpr float ImageAlphaLanes[8] = { 1.f, 0.f, 0.f, 0.f, 1.f, 0.f, 0.f, 0.f };
+
+		template <typename Pack>
+		Pack ClampAlpha(const Pack& someChannels, std::size_t anIndex)
+		{
+			const typename Pack::Mask isAlpha = Pack::Load(ImageAlphaLanes + (anIndex & 3)) > Pack::Broadcast(0.f);
+			return Pack::Select(isAlpha, Pack::Min(Pack::Max(someChannels, Pack::Broadcast(0.f)), Pack::Broadcast(1.f)), someChannels);
+		}
+
+		// Load the alpha of each pixel covered by the pack into all four of its lanes.
+		template <typename Pack>
+		Pack LoadPixelAlphas(const float* someChannels, std::size_t anIndex)
+		{
+#if defined(ROSECOMMON_SIMD_AVX)
+			if constexpr (std::is_same_v<Pack, Simd::FloatPack>)
+				return _mm256_permute_ps(_mm256_loadu_ps(someChannels + anIndex), _MM_SHUFFLE(0, 0, 0, 0));
+#elif defined(ROSECOMMON_SIMD_SSE2)
+			if constexpr (std::is_same_v<Pack, Simd::FloatPack>)
+			{
+				const __m128 pixel = _mm_loadu_ps(someChannels + anIndex);
+				return _mm_shuffle_ps(pixel, pixel, _MM_SHUFFLE(0, 0, 0, 0));
+			}
+#endif
+			return Pack::Broadcast(someChannels[anIndex & ~std::size_t(3)]);
+		}
+
+		template <typename T>
+		struct ImageKernels
+		{
+			static void Add(Color<T>* someTargets, const Color<T>* someSources, std::size_t aCount)
+			{
+				if constexpr (std::is_same_v<T, std::uint8_t>)
+				{
+					ColorArithmetic::Add(std::span(someTargets, aCount), std::span(someSources, aCount));
+				}
+				else if constexpr (std::is_same_v<T, float>)
+				{
+					float* targets = &someTargets->A;
+					const float* sources = &someSources->A;
+					Simd::ForEachPack<float>(aCount * 4, [&]<typename Pack>(std::size_t anIndex)
+					{
+						ClampAlpha(Pack::Load(targets + anIndex) + Pack::Load(sources + anIndex), anIndex).Store(targets + anIndex);
+					});
+				}
+				else
+				{
+					for (std::size_t i = 0; i < aCount; ++i)
+						someTargets[i] += someSources[i];
+				}
+			}
+
+			static void Multiply(Color<T>* someTargets, const Color<T>* someSources, std::size_t aCount)
+			{
+				if constexpr (std::is_same_v<T, std::uint8_t>)
+				{
+					ColorArithmetic::Multiply(std::span(someTargets, aCount), std::span(someSources, aCount));
+				}
+				else if constexpr (std::is_same_v<T, float>)
+				{
+					float* targets = &someTargets->A;
+					const float* sources = &someSources->A;
+					Simd::ForEachPack<float>(aCount * 4, [&]<typename Pack>(std::size_t anIndex)
+					{
+						ClampAlpha(Pack::Load(targets + anIndex) * Pack::Load(sources + anIndex), anIndex).Store(targets + anIndex);
+					});
+				}
+				else
+				{
+					for (std::size_t i = 0; i < aCount; ++i)
+						someTargets[i] *= someSources[i];
+				}
+			}
+
+			static void Scale(Color<T>* someTargets, T aScale, std::size_t aCount)
+			{
+				if constexpr (std::is_same_v<T, std::uint8_t>)
+				{
+					ColorArithmetic::Multiply(std::span(someTargets, aCount), aScale);
+				}
+				else if constexpr (std::is_same_v<T, float>)
+				{
+					float* targets = &someTargets->A;
+					Simd::ForEachPack<float>(aCount * 4, [&]<typename Pack>(std::size_t anIndex)
+					{
+						ClampAlpha(Pack::Load(targets + anIndex) * Pack::Broadcast(aScale), anIndex).Store(targets + anIndex);
+					});
+				}
+				else
+				{
+					const Color<T> scale(aScale, aScale, aScale, aScale);
+					for (std::size_t i = 0; i < aCount; ++i)
+						someTargets[i] *= scale;
+				}
+			}
+
+			static void Over(Color<T>* someTargets, const Color<T>* someSources, std::size_t aCount)
+			{
+				if constexpr (std::is_same_v<T, float>)
+				{
+					float* targets = &someTargets->A;
+					const float* sources = &someSources->A;
+					Simd::ForEachPack<float>(aCount * 4, [&]<typename Pack>(std::size_t anIndex)
+					{
+						const Pack inverseAlpha = Pack::Broadcast(1.f) - LoadPixelAlphas<Pack>(sources, anIndex);
+						(Pack::Load(sources + anIndex) + Pack::Load(targets + anIndex) * inverseAlpha).Store(targets + anIndex);
+					});
+					return;
+				}
+
+				std::size_t i = 0;
+
+#if defined(ROSECOMMON_SIMD_SSE2)
+				if constexpr (std::is_same_v<T, std::uint8_t>)
+				{
+					const __m128i zero = _mm_setzero_si128();
+					const __m128i range = _mm_set1_epi16(255);
+
+					// Scale the two pixels in each half of the target by the inverse alpha of the matching source pixels.
+					auto scaleHalf = [&](__m128i aTargetHalf, __m128i aSourceHalf)
+					{
+						const __m128i alpha = _mm_shufflehi_epi16(_mm_shufflelo_epi16(aSourceHalf, _MM_SHUFFLE(0, 0, 0, 0)), _MM_SHUFFLE(0, 0, 0, 0));
+						return DivideBy255(_mm_mullo_epi16(aTargetHalf, _mm_sub_epi16(range, alpha)));
+					};
+
+					for (; i + 4 <= aCount; i += 4)
+					{
+						__m128i* target = reinterpret_cast<__m128i*>(someTargets + i);
+						const __m128i targets = _mm_loadu_si128(target);
+						const __m128i sources = _mm_loadu_si128(reinterpret_cast<const __m128i*>(someSources + i));
+
+						const __m128i low = scaleHalf(_mm_unpacklo_epi8(targets, zero), _mm_unpacklo_epi8(sources, zero));
+						const __m128i high = scaleHalf(_mm_unpackhi_epi8(targets, zero), _mm_unpackhi_epi8(sources, zero));
+						_mm_storeu_si128(target, _mm_adds_epu8(sources, _mm_packus_epi16(low, high)));
+					}
+				}
+#endif
+
+				for (; i < aCount; ++i)
+				{
+					Color<T>& target = someTargets[i];
+					const Color<T>& source = someSources[i];
+
+					if constexpr (std::is_floating_point_v<T>)
+					{
+						const T inverseAlpha = T(1) - source.A;
+						target = Color<T>(source.A + target.A * inverseAlpha, source.R + target.R * inverseAlpha, source.G + target.G * inverseAlpha, source.B + target.B * inverseAlpha);
+					}
+					else
+					{
+						const std::uint32_t inverseAlpha = 255u - source.A;
+						auto blend = [&](std::uint8_t aSource, std::uint8_t aTarget) { return static_cast<std::uint8_t>(Math::Min<std::uint32_t>(aSource + DivideBy255(aTarget * inverseAlpha), 255u)); };
+						target = Color<T>(blend(source.A, target.A), blend(source.R, target.R), blend(source.G, target.G), blend(source.B, target.B));
+					}
+				}
+			}
+		};
+	}
+
+	template <typename T>
+	ImageView<T>::ImageView(Pixel* someData, std::size_t aWidth, std::size_t aHeight, std::size_t aStride)
+		: myData(someData)
+		, myWidth(aWidth)
+		, myHeight(aHeight)
+		, myStride(aStride)
+	{
+		if (aStride < aWidth)
+			throw std::invalid_argument("Image stride must be at least the width.");
+	}
+
+	template <typename T>
+	typename ImageView<T>::Pixel& ImageView<T>::GetPixel(std::size_t anX, std::size_t aY) const
+	{
+		if (anX >= myWidth || aY >= myHeight)
+			throw std::out_of_range("Pixel coordinates out of range.");
+
+		return myData[aY * myStride + anX];
+	}
+
+	template <typename T>
+	std::span<typename ImageView<T>::Pixel> ImageView<T>::GetRow(std::size_t aY) const
+	{
+		if (aY >= myHeight)
+			throw std::out_of_range("Row index out of range.");
+
+		return std::span<Pixel>(myData + aY * myStride, myWidth);
+	}
+
+	template <typename T>
+	ImageView<T> ImageView<T>::GetSubView(const Math::Rectangle<int>& aRectangle) const
+	{
+		if (!Bounds().Contains(aRectangle))
+			throw std::out_of_range("Sub-view must lie within the image.");
+
+		return ImageView(
+			myData + static_cast<std::size_t>(aRectangle.Y) * myStride + static_cast<std::size_t>(aRectangle.X),
+			static_cast<std::size_t>(aRectangle.Width),
+			static_cast<std::size_t>(aRectangle.Height),
+			myStride
+		);
+	}
+
+	template <typename T>
+	void ImageView<T>::Blit(ImageView<const Component> aSource, const Math::Point<int>& aPosition) const requires(!std::is_const_v<T>)
+	{
+		ForEachRowPair(aSource, aPosition, [](Color<Component>* someTargets, const Color<Component>* someSources, std::size_t aCount)
+		{
+			std::copy_n(someSources, aCount, someTargets);
+		});
+	}
+
+	template <typename T>
+	void ImageView<T>::BlendAdd(ImageView<const Component> aSource, const Math::Point<int>& aPosition) const requires(!std::is_const_v<T>)
+	{
+		ForEachRowPair(aSource, aPosition, &_impl::ImageKernels<Component>::Add);
+	}
+
+	template <typename T>
+	void ImageView<T>::BlendMultiply(ImageView<const Component> aSource, const Math::Point<int>& aPosition) const requires(!std::is_const_v<T>)
+	{
+		ForEachRowPair(aSource, aPosition, &_impl::ImageKernels<Component>::Multiply);
+	}
+
+	template <typename T>
+	void ImageView<T>::BlendOver(ImageView<const Component> aSource, const Math::Point<int>& aPosition) const requires(!std::is_const_v<T>)
+	{
+		ForEachRowPair(aSource, aPosition, &_impl::ImageKernels<Component>::Over);
+	}
+
+	template <typename T>
+	void ImageView<T>::Fill(const Color<Component>& aColor) const requires(!std::is_const_v<T>)
+	{
+		_impl::ForEachRowBand(myWidth, myHeight, [&](std::size_t aBegin, std::size_t anEnd)
+		{
+			for (std::size_t y = aBegin; y < anEnd; ++y)
+				std::fill_n(myData + y * myStride, myWidth, aColor);
+		});
+	}
+
+	template <typename T>
+	void ImageView<T>::Scale(float aScalar) const requires(!std::is_const_v<T>)
+	{
+		// Scaling is multiplication by a uniform color, so the same channel math keeps the results identical to the operator.
+		Component scale;
+		if constexpr (std::is_floating_point_v<Component>)
+			scale = static_cast<Component>(aScalar);
+		else
+			scale = static_cast<Component>(Math::Clamp<float>(aScalar, 0.f, 1.f) * 0xFF);
+
+		_impl::ForEachRowBand(myWidth, myHeight, [&](std::size_t aBegin, std::size_t anEnd)
+		{
+			for (std::size_t y = aBegin; y < anEnd; ++y)
+				_impl::ImageKernels<Component>::Scale(myData + y * myStride, scale, myWidth);
+		});
+	}
+
+	template <typename T>
+	template <typename Kernel>
+	void ImageView<T>::ForEachRowPair(const ImageView<const Component>& aSource, const Math::Point<int>& aPosition, Kernel&& aKernel) const
+	{
+		const std::optional<Math::Rectangle<int>> region = Bounds().Intersection(Math::Rectangle<int>(aPosition, Math::Size<int>(static_cast<int>(aSource.Width()), static_cast<int>(aSource.Height()))));
+		if (!region)
+			return;
+
+		const std::size_t width = static_cast<std::size_t>(region->Width);
+		const std::size_t targetX = static_cast<std::size_t>(region->X);
+		const std::size_t targetY = static_cast<std::size_t>(region->Y);
+		const std::size_t sourceX = static_cast<std::size_t>(region->X - aPosition.X);
+		const std::size_t sourceY = static_cast<std::size_t>(region->Y - aPosition.Y);
+
+		_impl::ForEachRowBand(width, static_cast<std::size_t>(region->Height), [&](std::size_t aBegin, std::size_t anEnd)
+		{
+			for (std::size_t y = aBegin; y < anEnd; ++y)
+				aKernel(myData + (targetY + y) * myStride + targetX, aSource.Data() + (sourceY + y) * aSource.Stride() + sourceX, width);
+		});
+	}
+
+	template <typename T>
+	Image<T>::Image(std::size_t aWidth, std::size_t aHeight, const Color<T>& aColor)
+		: myPixels(aWidth * aHeight, aColor)
+		, myWidth(aWidth)
+		, myHeight(aHeight)
+	{ }
+}
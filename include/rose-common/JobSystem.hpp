@@ -0,0 +1,284 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <vector>
+
+namespace RoseCommon::Parallel
+{
+	class JobSystem;
+
+	namespace _impl
+	{
+		struct Job;
+		struct Worker;
+	}
+
+	/**
+	 * @brief A reference to a scheduled job, for waiting on it or scheduling other jobs after it.
+	 */
+	class JobHandle
+	{
+	public:
+		JobHandle() = default;
+
+		/**
+		 * @brief Whether the handle refers to a job.
+		 */
+		bool IsValid() const { return myJob != nullptr; }
+
+		/**
+		 * @brief Whether the job has finished running. Invalid handles count as done.
+		 */
+		bool IsDone() const;
+
+	private:
+		friend class JobSystem;
+
+		explicit JobHandle(std::shared_ptr<_impl::Job> aJob) : myJob(std::move(aJob)) { }
+
+		std::shared_ptr<_impl::Job> myJob;
+	};
+
+	/**
+	 * @brief Runs jobs on a fixed set of named worker threads, which balance the load by stealing work from each other.
+	 *        Each worker has its own Chase-Lev deque, which it pushes and pops new jobs at the bottom of, while idle workers steal from the top.
+	 *        Jobs scheduled from other threads go into a shared injection queue. Idle workers spin with an increasing backoff before sleeping.
+	 *        Threads waiting for a job run other jobs in the meantime, so jobs can schedule and wait for jobs of their own.
+	 *        Each job runs in a PROFILE_SCOPE, so they show up per thread in profiling data.
+	 */
+	class JobSystem
+	{
+	public:
+
+		//--------------------------------------------------
+		// * Construction
+		//--------------------------------------------------
+		#pragma region Construction
+
+		/**
+		 * @brief Start the worker threads.
+		 * @param aWorkerCount The number of worker threads. Threads waiting on jobs help out as well,
+		 *                     so one less than the number of hardware threads keeps every core busy.
+		 * @param aShouldPinWorkers Whether to lock each worker to its own core, to keep its caches warm. The first core is left to the main thread.
+		 */
+		explicit JobSystem(std::size_t aWorkerCount, bool aShouldPinWorkers = false);
+
+		/**
+		 * @brief Finish any remaining jobs, then stop the worker threads.
+		 */
+		~JobSystem();
+
+		JobSystem(const JobSystem&) = delete;
+		JobSystem& operator=(const JobSystem&) = delete;
+
+		/**
+		 * @brief Get a shared job system, with one worker less than the number of hardware threads, started the first time it's needed.
+		 */
+		static JobSystem& GetDefault();
+
+		#pragma endregion
+
+		//--------------------------------------------------
+		// * Properties
+		//--------------------------------------------------
+		#pragma region Properties
+
+		/**
+		 * @brief Get the number of worker threads.
+		 */
+		std::size_t GetWorkerCount() const { return myWorkers.size(); }
+
+		#pragma endregion
+
+		//--------------------------------------------------
+		// * Methods
+		//--------------------------------------------------
+		#pragma region Methods
+
+		/**
+		 * @brief Schedule a function to run on the workers.
+		 * @param aFunction The function to run. An exception it throws is passed on to whoever waits for the job.
+		 * @param someDependencies Jobs which have to finish before this one starts.
+		 * @return A handle to the job.
+		 */
+		JobHandle Schedule(std::function<void()> aFunction, std::span<const JobHandle> someDependencies = { });
+
+		/**
+		 * @brief Schedule a function to run once a job has finished.
+		 * @param aJob The job to continue from.
+		 * @param aFunction The function to run.
+		 * @return A handle to the continuation.
+		 */
+		JobHandle Then(const JobHandle& aJob, std::function<void()> aFunction) { return Schedule(std::move(aFunction), std::span<const JobHandle>(&aJob, 1)); }
+
+		/**
+		 * @brief Wait for a job to finish, running other jobs in the meantime and sleeping while there are none.
+		 *        Rethrows the exception the job threw, if any.
+		 * @param aJob The job to wait for.
+		 */
+		void Wait(const JobHandle& aJob);
+
+		/**
+		 * @brief Call a function over a number of elements, split into ranges which are run concurrently.
+		 *        The elements are halved recursively down to the grain size, which lets idle workers steal large ranges first.
+		 *        The call returns once every element is done.
+		 * @param aCount The number of elements.
+		 * @param aGrainSize The largest number of elements not worth splitting any further.
+		 * @param aFunction Called as aFunction(begin, end) for each range.
+		 */
+		template <typename Function>
+		void ParallelFor(std::size_t aCount, std::size_t aGrainSize, Function&& aFunction);
+
+		/**
+		 * @brief Combine values calculated over a number of elements, split into ranges which are calculated concurrently.
+		 *        The ranges and the order they're combined in only depend on the count and grain size, and not on the number of threads
+		 *        or which thread ran what, so floating-point results are the same every time.
+		 * @param aCount The number of elements.
+		 * @param aGrainSize The largest number of elements not worth splitting any further.
+		 * @param anIdentity The result for no elements.
+		 * @param aMapFunction Called as aMapFunction(begin, end) for each range, returning its value.
+		 * @param aReduceFunction Called as aReduceFunction(first, second) to combine the values of two neighbouring ranges.
+		 * @return The combined value.
+		 */
+		template <typename T, typename MapFunction, typename ReduceFunction>
+		T ParallelReduce(std::size_t aCount, std::size_t aGrainSize, T anIdentity, MapFunction&& aMapFunction, ReduceFunction&& aReduceFunction);
+
+		#pragma endregion
+
+	private:
+		template <typename Function>
+		void ParallelForRange(std::size_t aBegin, std::size_t anEnd, std::size_t aGrainSize, Function& aFunction);
+
+		template <typename T, typename MapFunction, typename ReduceFunction>
+		T ParallelReduceRange(std::size_t aBegin, std::size_t anEnd, std::size_t aGrainSize, MapFunction& aMapFunction, ReduceFunction& aReduceFunction);
+
+		void WorkerLoop(std::size_t aWorkerIndex, bool aShouldPin);
+
+		void Enqueue(_impl::Job* aJob);
+		_impl::Job* FindJob();
+		void Execute(_impl::Job* aJob);
+
+		std::vector<std::unique_ptr<_impl::Worker>> myWorkers;
+
+		std::mutex myInjectionMutex;
+		std::deque<_impl::Job*> myInjectionQueue;
+		std::atomic<std::size_t> myInjectionCount;
+
+		std::mutex mySleepMutex;
+		std::condition_variable mySleepCondition;
+		std::atomic<std::uint64_t> myWorkEpoch;
+		std::atomic<std::uint32_t> mySleepingCount;
+		std::atomic_bool myIsStopping;
+	};
+}
+
+namespace RoseCommon::Parallel
+{
+	template <typename Function>
+	void JobSystem::ParallelFor(std::size_t aCount, std::size_t aGrainSize, Function&& aFunction)
+	{
+		if (aCount > 0)
+			ParallelForRange(0, aCount, std::max<std::size_t>(aGrainSize, 1), aFunction);
+	}
+
+	template <typename T, typename MapFunction, typename ReduceFunction>
+	T JobSystem::ParallelReduce(std::size_t aCount, std::size_t aGrainSize, T anIdentity, MapFunction&& aMapFunction, ReduceFunction&& aReduceFunction)
+	{
+		if (aCount == 0)
+			return anIdentity;
+
+		return ParallelReduceRange<T>(0, aCount, std::max<std::size_t>(aGrainSize, 1), aMapFunction, aReduceFunction);
+	}
+
+	template <typename Function>
+	void JobSystem::ParallelForRange(std::size_t aBegin, std::size_t anEnd, std::size_t aGrainSize, Function& aFunction)
+	{
+		// Hand off the upper halves and keep splitting the lower one, so the largest pieces are the first ones up for stealing.
+		std::vector<JobHandle> upperHalves;
+		while (anEnd - aBegin > aGrainSize)
+		{
+			const std::size_t middle = aBegin + (anEnd - aBegin) / 2;
+			upperHalves.push_back(Schedule([this, middle, anEnd, aGrainSize, &aFunction]() { ParallelForRange(middle, anEnd, aGrainSize, aFunction); }));
+			anEnd = middle;
+		}
+
+		// Wait for every half even if one failed, since they all refer to the function.
+		std::exception_ptr exception;
+		try
+		{
+			aFunction(aBegin, anEnd);
+		}
+		catch (...)
+		{
+			exception = std::current_exception();
+		}
+
+		for (auto it = upperHalves.rbegin(); it != upperHalves.rend(); ++it)
+		{
+			try
+			{
+				Wait(*it);
+			}
+			catch (...)
+			{
+				if (!exception)
+					exception = std::current_exception();
+			}
+		}
+
+		if (exception)
+			std::rethrow_exception(exception);
+	}
+
+	template <typename T, typename MapFunction, typename ReduceFunction>
+	T JobSystem::ParallelReduceRange(std::size_t aBegin, std::size_t anEnd, std::size_t aGrainSize, MapFunction& aMapFunction, ReduceFunction& aReduceFunction)
+	{
+		if (anEnd - aBegin <= aGrainSize)
+			return aMapFunction(aBegin, anEnd);
+
+		const std::size_t middle = aBegin + (anEnd - aBegin) / 2;
+		std::optional<T> upper;
+		const JobHandle upperJob = Schedule([this, &upper, middle, anEnd, aGrainSize, &aMapFunction, &aReduceFunction]()
+		{
+			upper.emplace(ParallelReduceRange<T>(middle, anEnd, aGrainSize, aMapFunction, aReduceFunction));
+		});
+
+		std::optional<T> lower;
+		std::exception_ptr exception;
+		try
+		{
+			lower.emplace(ParallelReduceRange<T>(aBegin, middle, aGrainSize, aMapFunction, aReduceFunction));
+		}
+		catch (...)
+		{
+			exception = std::current_exception();
+		}
+
+		// The upper half writes to this frame, so it has to finish before leaving even on failure.
+		try
+		{
+			Wait(upperJob);
+		}
+		catch (...)
+		{
+			if (!exception)
+				exception = std::current_exception();
+		}
+
+		if (exception)
+			std::rethrow_exception(exception);
+
+		return aReduceFunction(std::move(*lower), std::move(*upper));
+	}
+}
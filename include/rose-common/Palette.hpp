@@ -0,0 +1,577 @@
+#pragma once
+
+#include "Color.hpp"
+#include "Image.hpp"
+#include "Parallel.hpp"
+#include "math/Common.hpp"
+#include "math/KdTree.hpp"
+#include "math/Vector.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+namespace RoseCommon
+{
+	/**
+	 * @brief How to spread the error of mapping colors to a palette.
+	 */
+	enum class Dithering : std::uint8_t
+	{
+		/**
+		 * @brief Map each pixel to its nearest palette entry.
+		 */
+		None,
+
+		/**
+		 * @brief Offset each pixel by an 8x8 Bayer threshold before mapping it.
+		 */
+		Ordered,
+
+		/**
+		 * @brief Diffuse the error of each pixel onto its unvisited neighbors with Floyd-Steinberg weights.
+		 */
+		FloydSteinberg
+	};
+
+	/**
+	 * @brief A set of up to 256 opaque colors, for mapping images to 8-bit indices.
+	 *
+	 *        Exact nearest-entry queries search a k-d tree of the colors. Mapping whole images instead uses a
+	 *        32x32x32 lookup table holding the entry nearest to the center of each cell, which is built along with the palette.
+	 */
+	class Palette
+	{
+	public:
+
+		//--------------------------------------------------
+		// * Static constants
+		//--------------------------------------------------
+		#pragma region Static constants
+
+		/**
+		 * @brief The largest number of colors in a palette.
+		 */
+		static constexpr std::size_t MaxSize = 256;
+
+		/**
+		 * @brief The number of bits per channel used to index the lookup table and the generation histograms.
+		 */
+		static constexpr std::size_t LookupBits = 5;
+
+		/**
+		 * @brief Rows are dithered with Floyd-Steinberg in independent bands of this height, so bands can run concurrently with results that do not depend on the thread count.
+		 */
+		static constexpr std::size_t DiffusionBandHeight = 64;
+
+		#pragma endregion
+
+		//--------------------------------------------------
+		// * Construction
+		//--------------------------------------------------
+		#pragma region Construction
+
+		/**
+		 * @brief Initialize an empty palette.
+		 */
+		Palette() = default;
+
+		/**
+		 * @brief Initialize from a set of colors. Alpha is ignored.
+		 * @param someColors Between 1 and 256 colors.
+		 */
+		explicit Palette(std::span<const Color<std::uint8_t>> someColors);
+
+		/**
+		 * @brief Create a palette for an image by repeatedly splitting the box of colors with the most pixels and widest spread at its median.
+		 * @param anImage The image to create the palette for. Alpha is ignored.
+		 * @param aColorCount The number of colors to create, between 1 and 256. Images with fewer distinct colors get smaller palettes.
+		 */
+		static Palette CreateMedianCut(ImageView<const std::uint8_t> anImage, std::size_t aColorCount = MaxSize);
+
+		/**
+		 * @brief Create a palette for an image by refining a median cut palette with k-means clustering.
+		 * @param anImage The image to create the palette for. Alpha is ignored.
+		 * @param aColorCount The number of colors to create, between 1 and 256. Images with fewer distinct colors get smaller palettes.
+		 * @param anIterationCount The number of k-means iterations.
+		 */
+		static Palette CreateKMeans(ImageView<const std::uint8_t> anImage, std::size_t aColorCount = MaxSize, std::size_t anIterationCount = 8);
+
+		#pragma endregion
+
+		//--------------------------------------------------
+		// * Properties
+		//--------------------------------------------------
+		#pragma region Properties
+
+		/**
+		 * @brief Get the colors of the palette.
+		 */
+		std::span<const Color<std::uint8_t>> GetColors() const { return myColors; }
+
+		/**
+		 * @brief Get the number of colors in the palette.
+		 */
+		std::size_t Size() const { return myColors.size(); }
+
+		#pragma endregion
+
+		//--------------------------------------------------
+		// * Methods
+		//--------------------------------------------------
+		#pragma region Methods
+
+		/**
+		 * @brief Find the palette entry closest to a color.
+		 * @param aColor The color to search for. Alpha is ignored.
+		 * @return The index of the closest entry.
+		 */
+		std::uint8_t FindNearest(const Color<std::uint8_t>& aColor) const;
+
+		/**
+		 * @brief Find the palette entry closest to a color through the lookup table, which is exact to within the size of a table cell.
+		 * @param aColor The color to search for. Alpha is ignored.
+		 * @return The index of the entry.
+		 */
+		std::uint8_t Lookup(const Color<std::uint8_t>& aColor) const { return myLookup[GetLookupIndex(aColor.R, aColor.G, aColor.B)]; }
+
+		/**
+		 * @brief Map every pixel of an image to a palette entry, through the lookup table.
+		 * @param anImage The image to map. Alpha is ignored.
+		 * @param someIndices A buffer for the palette index of each pixel, row by row, at least as large as the image.
+		 * @param aDithering How to spread the mapping error between pixels.
+		 */
+		void Map(ImageView<const std::uint8_t> anImage, std::span<std::uint8_t> someIndices, Dithering aDithering = Dithering::None) const;
+
+		#pragma endregion
+
+	private:
+		struct WeightedColor
+		{
+			Math::Vector3<float> Value;
+			std::uint32_t Count;
+		};
+
+		static constexpr std::size_t GetLookupIndex(std::uint8_t aRed, std::uint8_t aGreen, std::uint8_t aBlue)
+		{
+			constexpr std::size_t shift = 8 - LookupBits;
+			return ((aRed >> shift) << (LookupBits * 2)) | ((aGreen >> shift) << LookupBits) | (aBlue >> shift);
+		}
+
+		static std::vector<WeightedColor> BuildHistogram(ImageView<const std::uint8_t> anImage);
+		static std::vector<Math::Vector3<float>> MedianCut(std::span<WeightedColor> someColors, std::size_t aColorCount);
+		static void RefineKMeans(std::span<const WeightedColor> someColors, std::vector<Math::Vector3<float>>& someCenters, std::size_t anIterationCount);
+		static Palette FromCenters(std::span<const Math::Vector3<float>> someCenters);
+
+		void DiffuseErrors(ImageView<const std::uint8_t> anImage, std::span<std::uint8_t> someIndices, std::size_t aBeginRow, std::size_t anEndRow) const;
+
+	private:
+		std::vector<Color<std::uint8_t>> myColors;
+		Math::KdTree<Math::Vector3<float>> myTree;
+		std::vector<std::uint8_t> myLookup;
+	};
+}
+
+namespace RoseCommon
+{
+	inline Palette::Palette(std::span<const Color<std::uint8_t>> someColors)
+	{
+		if (someColors.empty() || someColors.size() > MaxSize)
+			throw std::invalid_argument("A palette needs between 1 and 256 colors.");
+
+		std::vector<Math::Vector3<float>> points;
+		points.reserve(someColors.size());
+		for (const Color<std::uint8_t>& color : someColors)
+		{
+			myColors.emplace_back(color.R, color.G, color.B);
+			points.emplace_back(color.R, color.G, color.B);
+		}
+
+		myTree.Build(points);
+
+		// Fill the lookup table with the entry nearest to the center of each cell.
+		constexpr std::size_t cellCount = 1 << (LookupBits * 3);
+		constexpr std::size_t cellSize = 1 << (8 - LookupBits);
+		constexpr float cellCenter = (cellSize - 1) / 2.f;
+
+		myLookup.resize(cellCount);
+		Parallel::ForEachChunk(cellCount, Parallel::GetChunkCount(cellCount, 4096), [&](std::size_t, std::size_t aBegin, std::size_t anEnd)
+		{
+			constexpr std::size_t mask = (1 << LookupBits) - 1;
+
+			for (std::size_t cell = aBegin; cell < anEnd; ++cell)
+			{
+				const Math::Vector3<float> center(
+					static_cast<float>((cell >> (LookupBits * 2)) * cellSize) + cellCenter,
+					static_cast<float>(((cell >> LookupBits) & mask) * cellSize) + cellCenter,
+					static_cast<float>((cell & mask) * cellSize) + cellCenter
+				);
+
+				Math::KdTree<Math::Vector3<float>>::Neighbor nearest;
+				myTree.Nearest(center, std::span(&nearest, 1));
+				myLookup[cell] = static_cast<std::uint8_t>(nearest.Index);
+			}
+		});
+	}
+
+	inline Palette Palette::CreateMedianCut(ImageView<const std::uint8_t> anImage, std::size_t aColorCount)
+	{
+		if (aColorCount == 0 || aColorCount > MaxSize)
+			throw std::invalid_argument("A palette needs between 1 and 256 colors.");
+
+		std::vector<WeightedColor> histogram = BuildHistogram(anImage);
+		if (histogram.empty())
+			throw std::invalid_argument("Cannot create a palette for an empty image.");
+
+		return FromCenters(MedianCut(histogram, aColorCount));
+	}
+
+	inline Palette Palette::CreateKMeans(ImageView<const std::uint8_t> anImage, std::size_t aColorCount, std::size_t anIterationCount)
+	{
+		if (aColorCount == 0 || aColorCount > MaxSize)
+			throw std::invalid_argument("A palette needs between 1 and 256 colors.");
+
+		std::vector<WeightedColor> histogram = BuildHistogram(anImage);
+		if (histogram.empty())
+			throw std::invalid_argument("Cannot create a palette for an empty image.");
+
+		std::vector<Math::Vector3<float>> centers = MedianCut(histogram, aColorCount);
+		RefineKMeans(histogram, centers, anIterationCount);
+		return FromCenters(centers);
+	}
+
+	inline std::uint8_t Palette::FindNearest(const Color<std::uint8_t>& aColor) const
+	{
+		Math::KdTree<Math::Vector3<float>>::Neighbor nearest;
+		myTree.Nearest(Math::Vector3<float>(aColor.R, aColor.G, aColor.B), std::span(&nearest, 1));
+		return static_cast<std::uint8_t>(nearest.Index);
+	}
+
+	inline void Palette::Map(ImageView<const std::uint8_t> anImage, std::span<std::uint8_t> someIndices, Dithering aDithering) const
+	{
+		const std::size_t width = anImage.Width();
+
+		switch (aDithering)
+		{
+			case Dithering::None:
+			{
+				_impl::ForEachRowBand(width, anImage.Height(), [&](std::size_t aBegin, std::size_t anEnd)
+				{
+					for (std::size_t y = aBegin; y < anEnd; ++y)
+					{
+						const std::span<const Color<std::uint8_t>> row = anImage.GetRow(y);
+						for (std::size_t x = 0; x < width; ++x)
+							someIndices[y * width + x] = Lookup(row[x]);
+					}
+				});
+				break;
+			}
+
+			case Dithering::Ordered:
+			{
+				static constexpr std::uint8_t bayer[8][8] = {
+					{  0, 32,  8, 40,  2, 34, 10, 42 },
+					{ 48, 16, 56, 24, 50, 18, 58, 26 },
+					{ 12, 44,  4, 36, 14, 46,  6, 38 },
+					{ 60, 28, 52, 20, 62, 30, 54, 22 },
+					{  3, 35, 11, 43,  1, 33,  9, 41 },
+					{ 51, 19, 59, 27, 49, 17, 57, 25 },
+					{ 15, 47,  7, 39, 13, 45,  5, 37 },
+					{ 63, 31, 55, 23, 61, 29, 53, 21 }
+				};
+
+				// Spread the thresholds over the typical distance between entries of an evenly spaced palette of this size.
+				const float spread = 255.f / std::cbrt(static_cast<float>(myColors.size()));
+				std::array<std::array<int, 8>, 8> offsets;
+				for (std::size_t y = 0; y < 8; ++y)
+				{
+					for (std::size_t x = 0; x < 8; ++x)
+						offsets[y][x] = static_cast<int>(std::lround(((bayer[y][x] + 0.5f) / 64.f - 0.5f) * spread));
+				}
+
+				_impl::ForEachRowBand(width, anImage.Height(), [&](std::size_t aBegin, std::size_t anEnd)
+				{
+					auto offset = [](std::uint8_t aValue, int anOffset) { return static_cast<std::uint8_t>(Math::Clamp<int>(aValue + anOffset, 0, 255)); };
+
+					for (std::size_t y = aBegin; y < anEnd; ++y)
+					{
+						const std::span<const Color<std::uint8_t>> row = anImage.GetRow(y);
+						const std::array<int, 8>& rowOffsets = offsets[y & 7];
+						for (std::size_t x = 0; x < width; ++x)
+						{
+							const int amount = rowOffsets[x & 7];
+							someIndices[y * width + x] = myLookup[GetLookupIndex(offset(row[x].R, amount), offset(row[x].G, amount), offset(row[x].B, amount))];
+						}
+					}
+				});
+				break;
+			}
+
+			case Dithering::FloydSteinberg:
+			{
+				const std::size_t bandCount = (anImage.Height() + DiffusionBandHeight - 1) / DiffusionBandHeight;
+				Parallel::ForEachChunk(bandCount, Parallel::GetChunkCount(bandCount, 1), [&](std::size_t, std::size_t aBegin, std::size_t anEnd)
+				{
+					for (std::size_t band = aBegin; band < anEnd; ++band)
+						DiffuseErrors(anImage, someIndices, band * DiffusionBandHeight, Math::Min(anImage.Height(), (band + 1) * DiffusionBandHeight));
+				});
+				break;
+			}
+		}
+	}
+
+	inline std::vector<Palette::WeightedColor> Palette::BuildHistogram(ImageView<const std::uint8_t> anImage)
+	{
+		constexpr std::size_t binCount = 1 << (LookupBits * 3);
+
+		struct Bin
+		{
+			std::uint64_t Sums[3];
+			std::uint32_t Count;
+		};
+
+		// Each chunk of rows counts into its own histogram, which are summed afterwards.
+		const std::size_t height = anImage.Height();
+		const std::size_t chunkCount = Parallel::GetChunkCount(height, Math::Max<std::size_t>(1, (1 << 16) / Math::Max<std::size_t>(1, anImage.Width())));
+		std::vector<std::vector<Bin>> histograms(chunkCount);
+
+		Parallel::ForEachChunk(height, chunkCount, [&](std::size_t aChunk, std::size_t aBegin, std::size_t anEnd)
+		{
+			std::vector<Bin>& histogram = histograms[aChunk];
+			histogram.assign(binCount, Bin{});
+
+			for (std::size_t y = aBegin; y < anEnd; ++y)
+			{
+				for (const Color<std::uint8_t>& color : anImage.GetRow(y))
+				{
+					Bin& bin = histogram[GetLookupIndex(color.R, color.G, color.B)];
+					bin.Sums[0] += color.R;
+					bin.Sums[1] += color.G;
+					bin.Sums[2] += color.B;
+					++bin.Count;
+				}
+			}
+		});
+
+		std::vector<WeightedColor> colors;
+		if (chunkCount == 0 || histograms[0].empty())
+			return colors;
+
+		for (std::size_t i = 0; i < binCount; ++i)
+		{
+			Bin& total = histograms[0][i];
+			for (std::size_t chunk = 1; chunk < chunkCount; ++chunk)
+			{
+				const Bin& bin = histograms[chunk][i];
+				total.Sums[0] += bin.Sums[0];
+				total.Sums[1] += bin.Sums[1];
+				total.Sums[2] += bin.Sums[2];
+				total.Count += bin.Count;
+			}
+
+			if (total.Count == 0)
+				continue;
+
+			const double scale = 1.0 / static_cast<double>(total.Count);
+			colors.push_back(WeightedColor{
+				Math::Vector3<float>(static_cast<float>(total.Sums[0] * scale), static_cast<float>(total.Sums[1] * scale), static_cast<float>(total.Sums[2] * scale)),
+				total.Count
+			});
+		}
+
+		return colors;
+	}
+
+	inline std::vector<Math::Vector3<float>> Palette::MedianCut(std::span<WeightedColor> someColors, std::size_t aColorCount)
+	{
+		struct Box
+		{
+			std::size_t Begin;
+			std::size_t End;
+			std::uint64_t Count;
+			std::size_t Axis;
+			float Range;
+		};
+
+		auto measure = [&](std::size_t aBegin, std::size_t anEnd)
+		{
+			Math::Vector3<float> min = someColors[aBegin].Value;
+			Math::Vector3<float> max = min;
+			std::uint64_t count = 0;
+			for (std::size_t i = aBegin; i < anEnd; ++i)
+			{
+				const Math::Vector3<float>& color = someColors[i].Value;
+				min = Math::Vector3<float>(Math::Min(min.X, color.X), Math::Min(min.Y, color.Y), Math::Min(min.Z, color.Z));
+				max = Math::Vector3<float>(Math::Max(max.X, color.X), Math::Max(max.Y, color.Y), Math::Max(max.Z, color.Z));
+				count += someColors[i].Count;
+			}
+
+			const Math::Vector3<float> range = max - min;
+			const std::size_t axis = range.X >= range.Y && range.X >= range.Z ? 0 : (range.Y >= range.Z ? 1 : 2);
+			return Box{ aBegin, anEnd, count, axis, axis == 0 ? range.X : (axis == 1 ? range.Y : range.Z) };
+		};
+
+		std::vector<Box> boxes;
+		boxes.push_back(measure(0, someColors.size()));
+
+		while (boxes.size() < aColorCount)
+		{
+			// Split the box with the most pixels spread out the widest, weighting by both so that neither tiny nor flat boxes get split.
+			Box* widest = nullptr;
+			for (Box& box : boxes)
+			{
+				if (box.End - box.Begin > 1 && box.Range > 0 && (widest == nullptr || box.Count * box.Range > widest->Count * widest->Range))
+					widest = &box;
+			}
+
+			if (widest == nullptr)
+				break;
+
+			const Box box = *widest;
+			auto component = [&](const WeightedColor& aColor) { return box.Axis == 0 ? aColor.Value.X : (box.Axis == 1 ? aColor.Value.Y : aColor.Value.Z); };
+			std::sort(someColors.begin() + box.Begin, someColors.begin() + box.End, [&](const WeightedColor& aColor, const WeightedColor& anOther) { return component(aColor) < component(anOther); });
+
+			// Split at the weighted median, keeping at least one color on each side.
+			std::size_t split = box.Begin + 1;
+			std::uint64_t count = someColors[box.Begin].Count;
+			while (split < box.End - 1 && count * 2 < box.Count)
+				count += someColors[split++].Count;
+
+			*widest = measure(box.Begin, split);
+			boxes.push_back(measure(split, box.End));
+		}
+
+		std::vector<Math::Vector3<float>> centers;
+		centers.reserve(boxes.size());
+		for (const Box& box : boxes)
+		{
+			Math::Vector3<double> sum;
+			for (std::size_t i = box.Begin; i < box.End; ++i)
+				sum += Math::Vector3<double>(someColors[i].Value) * static_cast<double>(someColors[i].Count);
+
+			centers.push_back(Math::Vector3<float>(sum / static_cast<double>(box.Count)));
+		}
+
+		return centers;
+	}
+
+	inline void Palette::RefineKMeans(std::span<const WeightedColor> someColors, std::vector<Math::Vector3<float>>& someCenters, std::size_t anIterationCount)
+	{
+		struct Cluster
+		{
+			Math::Vector3<double> Sum;
+			std::uint64_t Count = 0;
+		};
+
+		const std::size_t chunkCount = Parallel::GetChunkCount(someColors.size(), 1024);
+		std::vector<std::vector<Cluster>> clusters(chunkCount);
+
+		for (std::size_t iteration = 0; iteration < anIterationCount; ++iteration)
+		{
+			const Math::KdTree<Math::Vector3<float>> tree(someCenters);
+
+			Parallel::ForEachChunk(someColors.size(), chunkCount, [&](std::size_t aChunk, std::size_t aBegin, std::size_t anEnd)
+			{
+				std::vector<Cluster>& chunkClusters = clusters[aChunk];
+				chunkClusters.assign(someCenters.size(), Cluster{});
+
+				for (std::size_t i = aBegin; i < anEnd; ++i)
+				{
+					Math::KdTree<Math::Vector3<float>>::Neighbor nearest;
+					tree.Nearest(someColors[i].Value, std::span(&nearest, 1));
+
+					Cluster& cluster = chunkClusters[nearest.Index];
+					cluster.Sum += Math::Vector3<double>(someColors[i].Value) * static_cast<double>(someColors[i].Count);
+					cluster.Count += someColors[i].Count;
+				}
+			});
+
+			bool hasMoved = false;
+			for (std::size_t center = 0; center < someCenters.size(); ++center)
+			{
+				Cluster total;
+				for (const std::vector<Cluster>& chunkClusters : clusters)
+				{
+					total.Sum += chunkClusters[center].Sum;
+					total.Count += chunkClusters[center].Count;
+				}
+
+				// Centers which lost all their colors stay where they are.
+				if (total.Count == 0)
+					continue;
+
+				const Math::Vector3<float> mean(total.Sum / static_cast<double>(total.Count));
+				hasMoved |= mean != someCenters[center];
+				someCenters[center] = mean;
+			}
+
+			if (!hasMoved)
+				break;
+		}
+	}
+
+	inline Palette Palette::FromCenters(std::span<const Math::Vector3<float>> someCenters)
+	{
+		std::vector<Color<std::uint8_t>> colors;
+		colors.reserve(someCenters.size());
+		for (const Math::Vector3<float>& center : someCenters)
+		{
+			auto toByte = [](float aValue) { return static_cast<std::uint8_t>(Math::Clamp<float>(std::round(aValue), 0.f, 255.f)); };
+			colors.emplace_back(toByte(center.X), toByte(center.Y), toByte(center.Z));
+		}
+
+		return Palette(colors);
+	}
+
+	inline void Palette::DiffuseErrors(ImageView<const std::uint8_t> anImage, std::span<std::uint8_t> someIndices, std::size_t aBeginRow, std::size_t anEndRow) const
+	{
+		const std::size_t width = anImage.Width();
+
+		// Errors for the current and next row in sixteenths, with a pixel of padding on either side so the edges need no checks.
+		std::vector<std::array<int, 3>> currentErrors(width + 2);
+		std::vector<std::array<int, 3>> nextErrors(width + 2);
+
+		for (std::size_t y = aBeginRow; y < anEndRow; ++y)
+		{
+			const std::span<const Color<std::uint8_t>> row = anImage.GetRow(y);
+			std::fill(nextErrors.begin(), nextErrors.end(), std::array<int, 3>{ });
+
+			// Alternate the direction of each row to avoid the error drifting into diagonal streaks.
+			const bool isReversed = (y & 1) != 0;
+			const std::ptrdiff_t step = isReversed ? -1 : 1;
+
+			for (std::size_t i = 0; i < width; ++i)
+			{
+				const std::size_t x = isReversed ? width - 1 - i : i;
+				const std::size_t padded = x + 1;
+
+				// Round the sixteenths to nearest with a shift, since dividing would truncate negative errors toward zero and bias them.
+				const std::uint8_t wanted[3] = {
+					static_cast<std::uint8_t>(Math::Clamp<int>(row[x].R + ((currentErrors[padded][0] + 8) >> 4), 0, 255)),
+					static_cast<std::uint8_t>(Math::Clamp<int>(row[x].G + ((currentErrors[padded][1] + 8) >> 4), 0, 255)),
+					static_cast<std::uint8_t>(Math::Clamp<int>(row[x].B + ((currentErrors[padded][2] + 8) >> 4), 0, 255))
+				};
+
+				const std::uint8_t index = myLookup[GetLookupIndex(wanted[0], wanted[1], wanted[2])];
+				someIndices[y * width + x] = index;
+
+				const Color<std::uint8_t>& chosen = myColors[index];
+				const int errors[3] = { wanted[0] - chosen.R, wanted[1] - chosen.G, wanted[2] - chosen.B };
+
+				for (std::size_t c = 0; c < 3; ++c)
+				{
+					currentErrors[padded + step][c] += errors[c] * 7;
+					nextErrors[padded - step][c] += errors[c] * 3;
+					nextErrors[padded][c] += errors[c] * 5;
+					nextErrors[padded + step][c] += errors[c];
+				}
+			}
+
+			currentErrors.swap(nextErrors);
+		}
+	}
+}
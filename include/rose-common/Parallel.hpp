@@ -0,0 +1,88 @@
+#pragma once
+
+#include "JobSystem.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <exception>
+#include <thread>
+#include <vector>
+
+namespace RoseCommon::Parallel
+{
+	/**
+	 * @brief Get the number of threads worth splitting work across, being at least one.
+	 */
+	inline std::size_t GetWorkerCount()
+	{
+		return std::max<std::size_t>(std::thread::hardware_concurrency(), 1);
+	}
+
+	/**
+	 * @brief Calculate how many chunks to split a number of elements into.
+	 * @param aCount The number of elements.
+	 * @param aGrainSize The smallest number of elements worth giving a chunk of its own.
+	 * @return A chunk count between one and the worker count.
+	 */
+	inline std::size_t GetChunkCount(std::size_t aCount, std::size_t aGrainSize)
+	{
+		const std::size_t chunksByGrain = aCount / std::max<std::size_t>(aGrainSize, 1);
+		return std::clamp<std::size_t>(chunksByGrain, 1, GetWorkerCount());
+	}
+
+	/**
+	 * @brief Split a number of elements into evenly sized contiguous chunks and process them concurrently on the default job system.
+	 *        The first chunk is processed on the calling thread, which then helps with the others, and the call returns once all chunks are done.
+	 *        Rethrows the first exception a chunk threw, if any.
+	 * @param aCount The number of elements.
+	 * @param aChunkCount The number of chunks to split the elements into.
+	 * @param aFunction Called as aFunction(chunkIndex, begin, end) for each chunk.
+	 */
+	template <typename Function>
+	void ForEachChunk(std::size_t aCount, std::size_t aChunkCount, Function&& aFunction)
+	{
+		aChunkCount = std::clamp<std::size_t>(aChunkCount, 1, std::max<std::size_t>(aCount, 1));
+
+		auto chunkBegin = [&](std::size_t aChunk) { return aCount * aChunk / aChunkCount; };
+
+		if (aChunkCount == 1)
+		{
+			aFunction(std::size_t(0), std::size_t(0), aCount);
+			return;
+		}
+
+		JobSystem& jobSystem = JobSystem::GetDefault();
+
+		std::vector<JobHandle> chunks;
+		chunks.reserve(aChunkCount - 1);
+		for (std::size_t i = 1; i < aChunkCount; ++i)
+			chunks.push_back(jobSystem.Schedule([&, i]() { aFunction(i, chunkBegin(i), chunkBegin(i + 1)); }));
+
+		// Every chunk refers to this frame, so they all have to finish before leaving, even when one fails.
+		std::exception_ptr exception;
+		try
+		{
+			aFunction(std::size_t(0), chunkBegin(0), chunkBegin(1));
+		}
+		catch (...)
+		{
+			exception = std::current_exception();
+		}
+
+		for (const JobHandle& chunk : chunks)
+		{
+			try
+			{
+				jobSystem.Wait(chunk);
+			}
+			catch (...)
+			{
+				if (!exception)
+					exception = std::current_exception();
+			}
+		}
+
+		if (exception)
+			std::rethrow_exception(exception);
+	}
+}
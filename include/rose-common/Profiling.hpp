@@ -2,10 +2,13 @@
 
 #include "MacroHelpers.hpp"
 
+#include <atomic>
 #include <chrono>
 #include <map>
 #include <memory>
+#include <optional>
 #include <string>
+#include <thread>
 #include <vector>
 
 namespace RoseCommon::Profiling
@@ -19,6 +22,7 @@ namespace RoseCommon::Profiling
 		unsigned int Level = 0;
 		const char* FileAndLine = nullptr;
 		const char* Function = nullptr;
+		std::thread::id ThreadId;
 		std::chrono::high_resolution_clock::time_point StartTime;
 		std::chrono::high_resolution_clock::time_point EndTime;
 		std::chrono::microseconds AverageDuration = std::chrono::microseconds(0);
@@ -39,6 +43,7 @@ namespace RoseCommon::Profiling
 	{
 		const char* FileAndLine = nullptr;
 		const char* Function = nullptr;
+		std::thread::id ThreadId;
 		std::chrono::high_resolution_clock::time_point Time;
 
 		std::string Label;
@@ -60,8 +65,7 @@ namespace RoseCommon::Profiling
 
 	/**
 	 * @brief A profiler that measures and reports back the data of marked up code.
-	 * 
-	 * @todo Expand to allow multi-threaded profiling.
+	 *        Code on any thread can be profiled, with each frame keeping the thread it ran on and its level within that thread.
 	 */
 	class Profiler
 	{
@@ -93,6 +97,7 @@ namespace RoseCommon::Profiling
 	public:
 		/**
 		 * @brief A class which collects data from the function that creates it, and upon destruction, reports the data to the running profiler.
+		 *        Nothing is collected if no profiler was running when it was created, so scopes are cheap to leave in hot code.
 		 */
 		struct FrameSubmitScope
 		{
@@ -101,6 +106,7 @@ namespace RoseCommon::Profiling
 
 		private:
 			ProfilingFrame myFrame;
+			bool myIsSubmitting;
 		};
 
 		/**
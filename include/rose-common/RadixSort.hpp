@@ -0,0 +1,120 @@
+#pragma once
+
+#include "Parallel.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <numeric>
+#include <span>
+#include <type_traits>
+#include <vector>
+
+namespace RoseCommon
+{
+	/**
+	 * @brief Stably sort a set of unsigned integer keys, such as Morton codes, without moving them.
+	 *        Uses a least-significant-digit radix sort over 8-bit digits, skipping digits shared by every key.
+	 *        Large inputs are counted and scattered in parallel chunks.
+	 * @tparam Key An unsigned integer type.
+	 * @param someKeys The keys to sort.
+	 * @param aPermutation A buffer the size of the key count, which receives the indices of the keys in sorted order.
+	 */
+	template <typename Key>
+	void RadixSort(std::span<const Key> someKeys, std::span<std::uint32_t> aPermutation);
+
+	/**
+	 * @brief Stably sort a set of unsigned integer keys, such as Morton codes, without moving them.
+	 * @tparam Key An unsigned integer type.
+	 * @param someKeys The keys to sort.
+	 * @return The indices of the keys in sorted order.
+	 */
+	template <typename Key>
+	std::vector<std::uint32_t> RadixSort(std::span<const Key> someKeys);
+}
+
+namespace RoseCommon
+{
+	template <typename Key>
+	void RadixSort(std::span<const Key> someKeys, std::span<std::uint32_t> aPermutation)
+	{
+		static_assert(std::is_unsigned_v<Key>, "Radix sort keys must be unsigned integers.");
+
+		constexpr std::size_t digitBits = 8;
+		constexpr std::size_t digitCount = 1 << digitBits;
+		constexpr std::size_t passCount = sizeof(Key) * 8 / digitBits;
+		constexpr std::size_t grainSize = 1 << 16;
+
+		using Histogram = std::array<std::uint32_t, digitCount>;
+
+		const std::size_t count = someKeys.size();
+		const std::size_t chunkCount = Parallel::GetChunkCount(count, grainSize);
+
+		// Keys are carried along with the indices so each pass reads them sequentially.
+		std::vector<Key> keys(someKeys.begin(), someKeys.end());
+		std::vector<Key> keysScratch(count);
+		std::vector<std::uint32_t> indices(count);
+		std::vector<std::uint32_t> indicesScratch(count);
+		std::iota(indices.begin(), indices.end(), 0);
+
+		std::vector<Histogram> histograms(chunkCount);
+
+		for (std::size_t pass = 0; pass < passCount; ++pass)
+		{
+			const std::size_t shift = pass * digitBits;
+
+			Parallel::ForEachChunk(count, chunkCount, [&](std::size_t aChunk, std::size_t aBegin, std::size_t anEnd)
+			{
+				Histogram& histogram = histograms[aChunk];
+				histogram.fill(0);
+				for (std::size_t i = aBegin; i < anEnd; ++i)
+					++histogram[(keys[i] >> shift) & (digitCount - 1)];
+			});
+
+			// Turn the counts into each chunk's starting offset per digit, ordered by digit and then by chunk to keep the sort stable.
+			bool isSharedDigit = false;
+			std::uint32_t offset = 0;
+			for (std::size_t digit = 0; digit < digitCount; ++digit)
+			{
+				std::uint32_t digitTotal = 0;
+				for (Histogram& histogram : histograms)
+				{
+					const std::uint32_t digitCountInChunk = histogram[digit];
+					histogram[digit] = offset;
+					offset += digitCountInChunk;
+					digitTotal += digitCountInChunk;
+				}
+
+				if (digitTotal == count)
+					isSharedDigit = true;
+			}
+
+			if (isSharedDigit)
+				continue;
+
+			Parallel::ForEachChunk(count, chunkCount, [&](std::size_t aChunk, std::size_t aBegin, std::size_t anEnd)
+			{
+				Histogram& offsets = histograms[aChunk];
+				for (std::size_t i = aBegin; i < anEnd; ++i)
+				{
+					const std::uint32_t destination = offsets[(keys[i] >> shift) & (digitCount - 1)]++;
+					keysScratch[destination] = keys[i];
+					indicesScratch[destination] = indices[i];
+				}
+			});
+
+			keys.swap(keysScratch);
+			indices.swap(indicesScratch);
+		}
+
+		std::copy(indices.begin(), indices.end(), aPermutation.begin());
+	}
+
+	template <typename Key>
+	std::vector<std::uint32_t> RadixSort(std::span<const Key> someKeys)
+	{
+		std::vector<std::uint32_t> permutation(someKeys.size());
+		RadixSort<Key>(someKeys, permutation);
+		return permutation;
+	}
+}
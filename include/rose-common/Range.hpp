@@ -1,66 +1,225 @@
 #pragma once
 
+#include "JobSystem.hpp"
+
+#include <algorithm>
+#include <compare>
+#include <cstddef>
+#include <iterator>
+#include <stdexcept>
 #include <type_traits>
 
 namespace RoseCommon
 {
     /**
-     * @brief A number range which can be iterated through.
+     * @brief A number range which can be iterated through, from the first value up to but not including the last, a step at a time.
+     *        The iterators are random-access, so ranges work with the standard range algorithms and can be split across threads.
+     *        As they return values rather than references, older algorithms going by the iterator category see them as input iterators, like those of std::views::iota.
      * @tparam T The integer type to use.
      */
     template<typename T>
     class Range
     {
+        static_assert(std::is_integral_v<T>, "Ranges are made of integers.");
+
+        // Stepping is done in an unsigned type, where wrapping around is well-defined even for the end position of a range near the limits.
+        // It's at least as wide as unsigned int, so small types aren't promoted to a signed int which could overflow.
+        using Unsigned = std::common_type_t<std::make_unsigned_t<T>, unsigned int>;
+
     public:
         class Iterator
         {
         public:
-            Iterator(const T& aValue) noexcept
+            using iterator_concept = std::random_access_iterator_tag;
+            using iterator_category = std::input_iterator_tag;
+            using value_type = T;
+            using difference_type = std::ptrdiff_t;
+            using pointer = const T*;
+            using reference = T;
+
+            Iterator() noexcept = default;
+
+            Iterator(const T& aValue, const T& aStep, difference_type anIndex) noexcept
                 : myValue(aValue)
+                , myStep(aStep)
+                , myIndex(anIndex)
             {}
 
-            const T& operator*() const noexcept { return myValue; }
+            T operator*() const noexcept { return myValue; }
             const T* operator->() const noexcept { return &myValue; }
-            Iterator& operator++() noexcept { ++myValue; return *this; }
+            T operator[](difference_type anOffset) const noexcept { return *(*this + anOffset); }
+
+            Iterator& operator++() noexcept { return *this += 1; }
+            Iterator& operator--() noexcept { return *this -= 1; }
+            Iterator operator++(int) noexcept { Iterator previous = *this; ++*this; return previous; }
+            Iterator operator--(int) noexcept { Iterator previous = *this; --*this; return previous; }
 
-            friend bool operator==(const Iterator& aLHV, const Iterator aRHV) noexcept {
-                return aLHV.myValue == aRHV.myValue;
+            Iterator& operator+=(difference_type anOffset) noexcept {
+                myValue = static_cast<T>(static_cast<Unsigned>(myValue) + static_cast<Unsigned>(anOffset) * static_cast<Unsigned>(myStep));
+                myIndex += anOffset;
+                return *this;
             }
-            friend bool operator!=(const Iterator& aLHV, const Iterator aRHV) noexcept {
-                return aLHV.myValue != aRHV.myValue;
+            Iterator& operator-=(difference_type anOffset) noexcept { return *this += -anOffset; }
+
+            friend Iterator operator+(Iterator anIterator, difference_type anOffset) noexcept { return anIterator += anOffset; }
+            friend Iterator operator+(difference_type anOffset, Iterator anIterator) noexcept { return anIterator += anOffset; }
+            friend Iterator operator-(Iterator anIterator, difference_type anOffset) noexcept { return anIterator -= anOffset; }
+            friend difference_type operator-(const Iterator& aLHV, const Iterator& aRHV) noexcept { return aLHV.myIndex - aRHV.myIndex; }
+
+            friend bool operator==(const Iterator& aLHV, const Iterator& aRHV) noexcept {
+                return aLHV.myIndex == aRHV.myIndex;
+            }
+            friend std::strong_ordering operator<=>(const Iterator& aLHV, const Iterator& aRHV) noexcept {
+                return aLHV.myIndex <=> aRHV.myIndex;
             }
 
         private:
-            T myValue;
+            T myValue = T(0);
+            T myStep = T(1);
+            difference_type myIndex = 0;
         };
 
+        class ChunkView;
+
     public:
-        Range(const T& aFirst, const T& aLast) noexcept
+        /**
+         * @brief Initialize a range.
+         * @param aFirst The first value.
+         * @param aLast The value to stop before, which the range doesn't go past even if a step skips over it.
+         * @param aStep The difference between consecutive values, negative for a descending range.
+         */
+        Range(const T& aFirst, const T& aLast, const T& aStep = T(1))
             : myFirst(aFirst)
             , myLast(aLast)
-        { }
-
-        Range(T&& aFirst, T&& aLast) noexcept
-            : myFirst(std::move(aFirst))
-            , myLast(std::move(aLast))
-        { }
-
-        Range(Range&& anOther) noexcept
-            : myFirst(std::move(anOther.aFirst))
-            , myLast(std::move(anOther.aLast))
-        { }
-
-        Range& operator=(Range&& anOther) noexcept {
-            myFirst = std::move(anOther.myFirst);
-            myLast = std::move(anOther.myLast);
-            return *this;
+            , myStep(aStep)
+        {
+            if (aStep == T(0))
+                throw std::invalid_argument("A range can't have a step of zero.");
+        }
+
+        Range(const Range& anOther) noexcept = default;
+        Range(Range&& anOther) noexcept = default;
+
+        Range& operator=(const Range& anOther) noexcept = default;
+        Range& operator=(Range&& anOther) noexcept = default;
+
+        /**
+         * @brief Split the range into consecutive sub-ranges, such as for handing each to a different thread.
+         * @param aChunkSize The number of values in each chunk, except the last one which holds what's left.
+         */
+        ChunkView Chunks(std::size_t aChunkSize) const { return ChunkView(*this, aChunkSize); }
+
+        /**
+         * @brief Get a sub-range of the values at some positions in this one, with the same step.
+         * @param aBegin The position of the first value to include.
+         * @param anEnd The position after the last value to include.
+         */
+        Range Slice(std::size_t aBegin, std::size_t anEnd) const noexcept {
+            Range slice(*this);
+            slice.myFirst = begin()[static_cast<std::ptrdiff_t>(aBegin)];
+            slice.myLast = anEnd < size() ? begin()[static_cast<std::ptrdiff_t>(anEnd)] : myLast;
+            return slice;
         }
 
-        Iterator begin() const noexcept { return myFirst; }
-        Iterator end() const noexcept { return myLast; }
+        const T& GetFirst() const noexcept { return myFirst; }
+        const T& GetLast() const noexcept { return myLast; }
+        const T& GetStep() const noexcept { return myStep; }
+
+        T operator[](std::size_t anIndex) const noexcept { return begin()[static_cast<std::ptrdiff_t>(anIndex)]; }
+
+        Iterator begin() const noexcept { return Iterator(myFirst, myStep, 0); }
+        Iterator end() const noexcept { return begin() + static_cast<std::ptrdiff_t>(size()); }
+
+        std::size_t size() const noexcept {
+            const bool isAscending = myStep > T(0);
+            if (isAscending ? myLast <= myFirst : myLast >= myFirst)
+                return 0;
+
+            const Unsigned distance = isAscending ? Unsigned(myLast) - Unsigned(myFirst) : Unsigned(myFirst) - Unsigned(myLast);
+            const Unsigned stepSize = isAscending ? Unsigned(myStep) : Unsigned(Unsigned(0) - Unsigned(myStep));
+            return static_cast<std::size_t>((distance - 1) / stepSize) + 1;
+        }
+        bool empty() const noexcept { return size() == 0; }
 
     private:
         T myFirst;
         T myLast;
+        T myStep;
     };
-}
\ No newline at end of file
+
+    /**
+     * @brief A view of a range as consecutive sub-ranges of a fixed number of values each, with the last one holding what's left.
+     */
+    template <typename T>
+    class Range<T>::ChunkView
+    {
+    public:
+        class Iterator
+        {
+        public:
+            using iterator_category = std::input_iterator_tag;
+            using value_type = Range<T>;
+            using difference_type = std::ptrdiff_t;
+
+            Iterator(const ChunkView& aView, std::size_t anIndex) noexcept
+                : myView(&aView)
+                , myIndex(anIndex)
+            {}
+
+            Range<T> operator*() const noexcept { return (*myView)[myIndex]; }
+            Iterator& operator++() noexcept { ++myIndex; return *this; }
+            Iterator operator++(int) noexcept { Iterator previous = *this; ++myIndex; return previous; }
+
+            friend bool operator==(const Iterator& aLHV, const Iterator& aRHV) noexcept {
+                return aLHV.myIndex == aRHV.myIndex;
+            }
+
+        private:
+            const ChunkView* myView;
+            std::size_t myIndex;
+        };
+
+        ChunkView(const Range<T>& aRange, std::size_t aChunkSize)
+            : myRange(aRange)
+            , myChunkSize(aChunkSize)
+        {
+            if (aChunkSize == 0)
+                throw std::invalid_argument("Chunks need to hold at least one value.");
+        }
+
+        /**
+         * @brief Get a chunk.
+         * @param anIndex The index of the chunk, which has to be less than the chunk count.
+         */
+        Range operator[](std::size_t anIndex) const noexcept {
+            const std::size_t begin = anIndex * myChunkSize;
+            return myRange.Slice(begin, begin + std::min(myChunkSize, myRange.size() - begin));
+        }
+
+        Iterator begin() const noexcept { return Iterator(*this, 0); }
+        Iterator end() const noexcept { return Iterator(*this, size()); }
+        std::size_t size() const noexcept { return (myRange.size() + myChunkSize - 1) / myChunkSize; }
+        bool empty() const noexcept { return myRange.empty(); }
+
+    private:
+        Range<T> myRange;
+        std::size_t myChunkSize;
+    };
+
+    /**
+     * @brief Call a function for each value in a range, with the values split into contiguous chunks processed concurrently.
+     *        The call returns once every value is done.
+     * @param aRange The values to process.
+     * @param aFunction Called as aFunction(value) for each value in the range.
+     * @param aGrainSize The largest number of values not worth splitting any further, to keep small loops from paying for threads.
+     */
+    template <typename T, typename Function>
+    void ParallelFor(const Range<T>& aRange, Function&& aFunction, std::size_t aGrainSize = 1)
+    {
+        Parallel::JobSystem::GetDefault().ParallelFor(aRange.size(), aGrainSize, [&](std::size_t aBegin, std::size_t anEnd)
+        {
+            for (const T value : aRange.Slice(aBegin, anEnd))
+                aFunction(value);
+        });
+    }
+}
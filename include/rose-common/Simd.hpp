@@ -0,0 +1,314 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <type_traits>
+
+/*
+ * Instruction set detection.
+ *
+ * The SIMD paths are chosen at compile-time from what the compiler is allowed to emit,
+ * no runtime dispatch is done. Define ROSECOMMON_SIMD_DISABLE to force the scalar fallbacks.
+ *
+ * Packs only expose exactly rounded operations, so each lane gives the same result as ScalarPack does,
+ * which keeps the vectorized paths usable in deterministic builds (see math/Determinism.hpp).
+ * Approximations such as reciprocal estimates and fused multiply-adds are deliberately left out.
+ */
+#if !defined(ROSECOMMON_SIMD_DISABLE)
+	#if defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+		#define ROSECOMMON_SIMD_SSE2 1
+	#endif
+
+	#if defined(ROSECOMMON_SIMD_SSE2) && defined(__AVX__)
+		#define ROSECOMMON_SIMD_AVX 1
+	#endif
+
+	#if defined(ROSECOMMON_SIMD_AVX) && defined(__AVX2__)
+		#define ROSECOMMON_SIMD_AVX2 1
+	#endif
+
+	// MSVC has no F16C define, but every CPU with AVX2 also has F16C.
+	#if defined(ROSECOMMON_SIMD_AVX) && (defined(__F16C__) || (defined(_MSC_VER) && defined(__AVX2__)))
+		#define ROSECOMMON_SIMD_F16C 1
+	#endif
+
+	// MSVC has no BMI2 define, but every CPU with AVX2 also has BMI2.
+	#if (defined(__x86_64__) || defined(_M_X64)) && (defined(__BMI2__) || (defined(_MSC_VER) && defined(__AVX2__)))
+		#define ROSECOMMON_SIMD_BMI2 1
+	#endif
+#endif
+
+#if defined(ROSECOMMON_SIMD_SSE2) || defined(ROSECOMMON_SIMD_BMI2)
+	#include <immintrin.h>
+#endif
+
+namespace RoseCommon::Simd
+{
+	//--------------------------------------------------
+	// * Result masks
+	//--------------------------------------------------
+	#pragma region Result masks
+
+	/**
+	 * @brief The number of elements described by each word of a result mask.
+	 *        Element N of a batch is stored in bit (N % MaskWordBits) of word (N / MaskWordBits).
+	 */
+	constexpr std::size_t MaskWordBits = 64;
+
+	/**
+	 * @brief Calculate how many mask words are needed to hold a result bit for each element.
+	 * @param anElementCount The number of elements in the batch.
+	 * @return The number of 64-bit words needed.
+	 */
+	constexpr std::size_t GetMaskWordCount(std::size_t anElementCount) { return (anElementCount + MaskWordBits - 1) / MaskWordBits; }
+
+	/**
+	 * @brief Clear the mask words used by a batch of the specified size.
+	 * @param someMasks The mask words to clear.
+	 * @param anElementCount The number of elements in the batch.
+	 */
+	inline void ClearMask(std::span<std::uint64_t> someMasks, std::size_t anElementCount)
+	{
+		const std::size_t wordCount = GetMaskWordCount(anElementCount);
+		for (std::size_t i = 0; i < wordCount && i < someMasks.size(); ++i)
+			someMasks[i] = 0;
+	}
+
+	/**
+	 * @brief Get the result bit of a single element.
+	 * @param someMasks The mask words to read from.
+	 * @param anIndex The index of the element.
+	 * @return Whether the element's bit is set.
+	 */
+	constexpr bool GetMaskBit(std::span<const std::uint64_t> someMasks, std::size_t anIndex)
+	{
+		return ((someMasks[anIndex / MaskWordBits] >> (anIndex % MaskWordBits)) & 1) != 0;
+	}
+
+	/**
+	 * @brief Set the result bits for a group of consecutive elements.
+	 *        The group must not cross a word boundary, which holds for any power-of-two group size aligned to its own size.
+	 * @param someMasks The mask words to write to. The affected bits are expected to be cleared beforehand.
+	 * @param aFirstIndex The index of the first element in the group.
+	 * @param someBits The result bits of the group, with the first element in the lowest bit.
+	 */
+	inline void WriteMaskBits(std::span<std::uint64_t> someMasks, std::size_t aFirstIndex, std::uint64_t someBits)
+	{
+		someMasks[aFirstIndex / MaskWordBits] |= someBits << (aFirstIndex % MaskWordBits);
+	}
+
+	#pragma endregion
+
+	//--------------------------------------------------
+	// * Packs
+	//--------------------------------------------------
+	#pragma region Packs
+
+	/**
+	 * @brief A single-lane stand-in for a SIMD register, used for types without a vectorized implementation and for loop tails.
+	 * @tparam T The type of the lane.
+	 */
+	template <typename T>
+	class ScalarPack
+	{
+	public:
+		/**
+		 * @brief The result of a lane comparison.
+		 */
+		class Mask
+		{
+		public:
+			constexpr Mask(bool aValue) : myValue(aValue) { }
+
+			/**
+			 * @brief Get one bit per lane, with the first lane in the lowest bit.
+			 */
+			constexpr std::uint32_t MoveMask() const { return myValue ? 1u : 0u; }
+
+			constexpr Mask operator&(const Mask& aMask) const { return myValue && aMask.myValue; }
+			constexpr Mask operator|(const Mask& aMask) const { return myValue || aMask.myValue; }
+			constexpr Mask operator~() const { return !myValue; }
+
+		private:
+			friend class ScalarPack;
+			bool myValue;
+		};
+
+		static constexpr std::size_t Width = 1;
+
+		constexpr ScalarPack(T aValue) : myValue(aValue) { }
+
+		static constexpr ScalarPack Broadcast(T aValue) { return aValue; }
+		static constexpr ScalarPack Load(const T* aSource) { return *aSource; }
+		constexpr void Store(T* aTarget) const { *aTarget = myValue; }
+
+		static constexpr ScalarPack Abs(const ScalarPack& aPack) { return aPack.myValue < T(0) ? -aPack.myValue : (aPack.myValue == T(0) ? T(0) : aPack.myValue); }
+		static constexpr ScalarPack Max(const ScalarPack& aPack1, const ScalarPack& aPack2) { return aPack1.myValue > aPack2.myValue ? aPack1.myValue : aPack2.myValue; }
+		static constexpr ScalarPack Min(const ScalarPack& aPack1, const ScalarPack& aPack2) { return aPack1.myValue < aPack2.myValue ? aPack1.myValue : aPack2.myValue; }
+		static constexpr ScalarPack Select(const Mask& aMask, const ScalarPack& aTrue, const ScalarPack& aFalse) { return aMask.myValue ? aTrue : aFalse; }
+
+		constexpr ScalarPack operator-() const { return -myValue; }
+		constexpr ScalarPack operator+(const ScalarPack& aPack) const { return myValue + aPack.myValue; }
+		constexpr ScalarPack operator-(const ScalarPack& aPack) const { return myValue - aPack.myValue; }
+		constexpr ScalarPack operator*(const ScalarPack& aPack) const { return myValue * aPack.myValue; }
+		constexpr ScalarPack operator/(const ScalarPack& aPack) const { return myValue / aPack.myValue; }
+
+		constexpr Mask operator<(const ScalarPack& aPack) const { return myValue < aPack.myValue; }
+		constexpr Mask operator<=(const ScalarPack& aPack) const { return myValue <= aPack.myValue; }
+		constexpr Mask operator>(const ScalarPack& aPack) const { return myValue > aPack.myValue; }
+		constexpr Mask operator>=(const ScalarPack& aPack) const { return myValue >= aPack.myValue; }
+
+	private:
+		T myValue;
+	};
+
+#if defined(ROSECOMMON_SIMD_AVX)
+
+	/**
+	 * @brief Eight single-precision lanes in an AVX register.
+	 */
+	class FloatPack
+	{
+	public:
+		class Mask
+		{
+		public:
+			Mask(__m256 aValue) : myValue(aValue) { }
+
+			std::uint32_t MoveMask() const { return static_cast<std::uint32_t>(_mm256_movemask_ps(myValue)); }
+
+			Mask operator&(const Mask& aMask) const { return _mm256_and_ps(myValue, aMask.myValue); }
+			Mask operator|(const Mask& aMask) const { return _mm256_or_ps(myValue, aMask.myValue); }
+			Mask operator~() const { return _mm256_xor_ps(myValue, _mm256_castsi256_ps(_mm256_set1_epi32(-1))); }
+
+		private:
+			friend class FloatPack;
+			__m256 myValue;
+		};
+
+		static constexpr std::size_t Width = 8;
+
+		FloatPack(__m256 aValue) : myValue(aValue) { }
+
+		static FloatPack Broadcast(float aValue) { return _mm256_set1_ps(aValue); }
+		static FloatPack Load(const float* aSource) { return _mm256_loadu_ps(aSource); }
+		void Store(float* aTarget) const { _mm256_storeu_ps(aTarget, myValue); }
+
+		static FloatPack Abs(const FloatPack& aPack) { return _mm256_andnot_ps(_mm256_set1_ps(-0.f), aPack.myValue); }
+		static FloatPack Max(const FloatPack& aPack1, const FloatPack& aPack2) { return _mm256_max_ps(aPack1.myValue, aPack2.myValue); }
+		static FloatPack Min(const FloatPack& aPack1, const FloatPack& aPack2) { return _mm256_min_ps(aPack1.myValue, aPack2.myValue); }
+		static FloatPack Select(const Mask& aMask, const FloatPack& aTrue, const FloatPack& aFalse) { return _mm256_blendv_ps(aFalse.myValue, aTrue.myValue, aMask.myValue); }
+
+		FloatPack operator-() const { return _mm256_xor_ps(myValue, _mm256_set1_ps(-0.f)); }
+		FloatPack operator+(const FloatPack& aPack) const { return _mm256_add_ps(myValue, aPack.myValue); }
+		FloatPack operator-(const FloatPack& aPack) const { return _mm256_sub_ps(myValue, aPack.myValue); }
+		FloatPack operator*(const FloatPack& aPack) const { return _mm256_mul_ps(myValue, aPack.myValue); }
+		FloatPack operator/(const FloatPack& aPack) const { return _mm256_div_ps(myValue, aPack.myValue); }
+
+		Mask operator<(const FloatPack& aPack) const { return _mm256_cmp_ps(myValue, aPack.myValue, _CMP_LT_OQ); }
+		Mask operator<=(const FloatPack& aPack) const { return _mm256_cmp_ps(myValue, aPack.myValue, _CMP_LE_OQ); }
+		Mask operator>(const FloatPack& aPack) const { return _mm256_cmp_ps(myValue, aPack.myValue, _CMP_GT_OQ); }
+		Mask operator>=(const FloatPack& aPack) const { return _mm256_cmp_ps(myValue, aPack.myValue, _CMP_GE_OQ); }
+
+	private:
+		__m256 myValue;
+	};
+
+#elif defined(ROSECOMMON_SIMD_SSE2)
+
+	/**
+	 * @brief Four single-precision lanes in an SSE register.
+	 */
+	class FloatPack
+	{
+	public:
+		class Mask
+		{
+		public:
+			Mask(__m128 aValue) : myValue(aValue) { }
+
+			std::uint32_t MoveMask() const { return static_cast<std::uint32_t>(_mm_movemask_ps(myValue)); }
+
+			Mask operator&(const Mask& aMask) const { return _mm_and_ps(myValue, aMask.myValue); }
+			Mask operator|(const Mask& aMask) const { return _mm_or_ps(myValue, aMask.myValue); }
+			Mask operator~() const { return _mm_xor_ps(myValue, _mm_castsi128_ps(_mm_set1_epi32(-1))); }
+
+		private:
+			friend class FloatPack;
+			__m128 myValue;
+		};
+
+		static constexpr std::size_t Width = 4;
+
+		FloatPack(__m128 aValue) : myValue(aValue) { }
+
+		static FloatPack Broadcast(float aValue) { return _mm_set1_ps(aValue); }
+		static FloatPack Load(const float* aSource) { return _mm_loadu_ps(aSource); }
+		void Store(float* aTarget) const { _mm_storeu_ps(aTarget, myValue); }
+
+		static FloatPack Abs(const FloatPack& aPack) { return _mm_andnot_ps(_mm_set1_ps(-0.f), aPack.myValue); }
+		static FloatPack Max(const FloatPack& aPack1, const FloatPack& aPack2) { return _mm_max_ps(aPack1.myValue, aPack2.myValue); }
+		static FloatPack Min(const FloatPack& aPack1, const FloatPack& aPack2) { return _mm_min_ps(aPack1.myValue, aPack2.myValue); }
+		static FloatPack Select(const Mask& aMask, const FloatPack& aTrue, const FloatPack& aFalse) { return _mm_or_ps(_mm_and_ps(aMask.myValue, aTrue.myValue), _mm_andnot_ps(aMask.myValue, aFalse.myValue)); }
+
+		FloatPack operator-() const { return _mm_xor_ps(myValue, _mm_set1_ps(-0.f)); }
+		FloatPack operator+(const FloatPack& aPack) const { return _mm_add_ps(myValue, aPack.myValue); }
+		FloatPack operator-(const FloatPack& aPack) const { return _mm_sub_ps(myValue, aPack.myValue); }
+		FloatPack operator*(const FloatPack& aPack) const { return _mm_mul_ps(myValue, aPack.myValue); }
+		FloatPack operator/(const FloatPack& aPack) const { return _mm_div_ps(myValue, aPack.myValue); }
+
+		Mask operator<(const FloatPack& aPack) const { return _mm_cmplt_ps(myValue, aPack.myValue); }
+		Mask operator<=(const FloatPack& aPack) const { return _mm_cmple_ps(myValue, aPack.myValue); }
+		Mask operator>(const FloatPack& aPack) const { return _mm_cmpgt_ps(myValue, aPack.myValue); }
+		Mask operator>=(const FloatPack& aPack) const { return _mm_cmpge_ps(myValue, aPack.myValue); }
+
+	private:
+		__m128 myValue;
+	};
+
+#endif
+
+	namespace _impl
+	{
+		template <typename T>
+		struct NativePack { using Type = ScalarPack<T>; };
+
+#if defined(ROSECOMMON_SIMD_SSE2)
+		template <>
+		struct NativePack<float> { using Type = FloatPack; };
+#endif
+	}
+
+	/**
+	 * @brief The widest pack available for a lane type on the current target.
+	 *        Falls back to ScalarPack for types without a vectorized implementation.
+	 */
+	template <typename T>
+	using NativePack = typename _impl::NativePack<T>::Type;
+
+	/**
+	 * @brief Run a kernel over a range of elements, one pack at a time.
+	 *        The kernel is a generic lambda taking the pack type as a template parameter and the first element index,
+	 *        it is called with the native pack for as long as whole packs fit, and with ScalarPack for the remaining elements.
+	 * @tparam T The lane type of the data being processed.
+	 * @param anElementCount The number of elements to process.
+	 * @param aKernel The kernel to run, invoked as aKernel.template operator()<Pack>(anIndex).
+	 */
+	template <typename T, typename Kernel>
+	void ForEachPack(std::size_t anElementCount, Kernel&& aKernel)
+	{
+		std::size_t i = 0;
+
+		if constexpr (NativePack<T>::Width > 1)
+		{
+			for (; i + NativePack<T>::Width <= anElementCount; i += NativePack<T>::Width)
+				aKernel.template operator()<NativePack<T>>(i);
+		}
+
+		for (; i < anElementCount; ++i)
+			aKernel.template operator()<ScalarPack<T>>(i);
+	}
+
+	#pragma endregion
+}
@@ -0,0 +1,443 @@
+#pragma once
+
+#include "Common.hpp"
+#include "Geometry.hpp"
+#include "Matrix.hpp"
+#include "Trigonometry.hpp"
+#include "Vector.hpp"
+
+#include "../Parallel.hpp"
+#include "../Simd.hpp"
+
+#include <optional>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+
+namespace RoseCommon::Math
+{
+	/**
+	 * @brief A two-dimensional affine transformation, stored as the 3x2 part of a row-major 3x3 matrix that does not change.
+	 *        Uses the same row-vector convention as Matrix3D, so A * B applies A first and B second.
+	 * @tparam T The type to use for each cell.
+	 */
+	template <typename T>
+	class AffineTransform2D
+	{
+	public:
+
+		//--------------------------------------------------
+		// * Types
+		//--------------------------------------------------
+		#pragma region Types
+
+		using ComponentType = T;
+
+		#pragma endregion
+
+		//--------------------------------------------------
+		// * Static constants
+		//--------------------------------------------------
+		#pragma region Static constants
+
+		/**
+		 * @brief Initialize an identity transform.
+		 * @return The identity transform.
+		 */
+		static constexpr AffineTransform2D Identity() { return AffineTransform2D(); }
+
+		#pragma endregion
+
+		//--------------------------------------------------
+		// * Construction
+		//--------------------------------------------------
+		#pragma region Construction
+
+		/**
+		 * @brief Initialize to the identity transform.
+		 */
+		constexpr AffineTransform2D();
+
+		/**
+		 * @brief Initialize with the specified cells, where a point (x, y) is transformed to (x * M11 + y * M21 + M31, x * M12 + y * M22 + M32).
+		 */
+		constexpr AffineTransform2D(T anM11, T anM12, T anM21, T anM22, T anM31, T anM32);
+
+		/**
+		 * @brief Initialize from the first two columns of a 3x3 matrix, as used by Point::operator*().
+		 * @param aMatrix The matrix to convert, whose last column is assumed to be (0, 0, 1).
+		 */
+		constexpr explicit AffineTransform2D(const Matrix<3, 3, T>& aMatrix);
+
+		/**
+		 * @brief Create a transform which rotates around the origin.
+		 * @param anAngle The angle to rotate by, in radians.
+		 */
+		static constexpr AffineTransform2D CreateRotation(T anAngle) requires(IsFractional<T>);
+
+		/**
+		 * @brief Create a transform which rotates around a center point.
+		 * @param anAngle The angle to rotate by, in radians.
+		 * @param aCenterPoint The point to rotate around.
+		 */
+		static constexpr AffineTransform2D CreateRotation(T anAngle, const Point<T>& aCenterPoint) requires(IsFractional<T>);
+
+		/**
+		 * @brief Create a transform which scales from the origin.
+		 * @param anXScale The horizontal scale.
+		 * @param aYScale The vertical scale.
+		 */
+		static constexpr AffineTransform2D CreateScale(T anXScale, T aYScale);
+
+		/**
+		 * @brief Create a transform which scales from a center point.
+		 * @param anXScale The horizontal scale.
+		 * @param aYScale The vertical scale.
+		 * @param aCenterPoint The point to scale from.
+		 */
+		static constexpr AffineTransform2D CreateScale(T anXScale, T aYScale, const Point<T>& aCenterPoint);
+
+		/**
+		 * @brief Create a transform which skews along each axis.
+		 * @param anXAngle The angle to skew horizontally by, in radians.
+		 * @param aYAngle The angle to skew vertically by, in radians.
+		 */
+		static constexpr AffineTransform2D CreateSkew(T anXAngle, T aYAngle) requires(IsFractional<T>);
+
+		/**
+		 * @brief Create a transform which moves by an offset.
+		 * @param anX The horizontal offset.
+		 * @param aY The vertical offset.
+		 */
+		static constexpr AffineTransform2D CreateTranslation(T anX, T aY);
+
+		/**
+		 * @brief Create a transform which moves by an offset.
+		 * @param anOffset The offset.
+		 */
+		static constexpr AffineTransform2D CreateTranslation(const Vector2<T>& anOffset) { return CreateTranslation(anOffset.X, anOffset.Y); }
+
+		#pragma endregion
+
+		//--------------------------------------------------
+		// * Properties
+		//--------------------------------------------------
+		#pragma region Properties
+
+		T M11, M12;
+		T M21, M22;
+		T M31, M32;
+
+		/**
+		 * @brief Get the translation part of the transform.
+		 */
+		constexpr Vector2<T> GetTranslation() const { return Vector2<T>(M31, M32); }
+
+		/**
+		 * @brief Set the translation part of the transform.
+		 */
+		constexpr void SetTranslation(const Vector2<T>& aTranslation);
+
+		/**
+		 * @brief Check whether the transform leaves everything unchanged.
+		 */
+		constexpr bool IsIdentity() const { return *this == Identity(); }
+
+		#pragma endregion
+
+		//--------------------------------------------------
+		// * Methods
+		//--------------------------------------------------
+		#pragma region Methods
+
+		/**
+		 * @brief Calculate the determinant, being the factor areas are scaled by.
+		 */
+		constexpr T Determinant() const { return M11 * M22 - M12 * M21; }
+
+		/**
+		 * @brief Calculate the inverse transform in closed form.
+		 * @return The inverse, or nothing if the transform collapses areas to a line or point.
+		 */
+		constexpr std::optional<AffineTransform2D> Inverse() const;
+
+		/**
+		 * @brief Transform a point, including translation.
+		 */
+		constexpr Point<T> TransformPoint(const Point<T>& aPoint) const;
+
+		/**
+		 * @brief Transform a direction or offset, excluding translation.
+		 */
+		constexpr Vector2<T> TransformVector(const Vector2<T>& aVector) const;
+
+		/**
+		 * @brief Get the smallest axis-aligned rectangle which contains a rectangle after being transformed.
+		 *        Uses the absolute values of the linear part, so is exact for the transformed corners without evaluating all four of them.
+		 * @param aRectangle The rectangle to transform.
+		 * @return The transformed bounding rectangle.
+		 */
+		constexpr Rectangle<T> TransformBounds(const Rectangle<T>& aRectangle) const;
+
+		/**
+		 * @brief Transform many points, including translation. Single-precision floats are transformed with SSE/AVX, in parallel for large spans.
+		 * @param somePoints The points to transform.
+		 * @param outPoints A buffer for the transformed points, at least as large as the input. May be the same as the input.
+		 */
+		void TransformPoints(std::span<const Point<T>> somePoints, std::span<Point<T>> outPoints) const;
+
+		/**
+		 * @brief Transform many directions or offsets, excluding translation. Single-precision floats are transformed with SSE/AVX, in parallel for large spans.
+		 * @param someVectors The vectors to transform.
+		 * @param outVectors A buffer for the transformed vectors, at least as large as the input. May be the same as the input.
+		 */
+		void TransformVectors(std::span<const Vector2<T>> someVectors, std::span<Vector2<T>> outVectors) const;
+
+		#pragma endregion
+
+		//--------------------------------------------------
+		// * Operators
+		//--------------------------------------------------
+		#pragma region Operators
+
+		explicit constexpr operator Matrix<3, 3, T>() const;
+
+		constexpr AffineTransform2D operator*(const AffineTransform2D& aTransform) const;
+		constexpr AffineTransform2D& operator*=(const AffineTransform2D& aTransform) { return *this = *this * aTransform; }
+
+		inline constexpr friend Point<T> operator*(const Point<T>& aPoint, const AffineTransform2D& aTransform) { return aTransform.TransformPoint(aPoint); }
+
+		constexpr bool operator==(const AffineTransform2D& aTransform) const = default;
+
+		#pragma endregion
+
+	private:
+		// Transform interleaved coordinate pairs as (x, y) * M + (Translate ? (M31, M32) : 0), using that each output lane is one input lane times one cell plus the swapped lane times another.
+		template <bool Translate>
+		void TransformPairs(const T* someCoordinates, T* outCoordinates, std::size_t aCount) const;
+	};
+}
+
+namespace RoseCommon::Math
+{
+	template <typename T>
+	constexpr AffineTransform2D<T>::AffineTransform2D()
+		: AffineTransform2D(T(1), T(0), T(0), T(1), T(0), T(0))
+	{
+
+	}
+
+	template <typename T>
+	constexpr AffineTransform2D<T>::AffineTransform2D(T anM11, T anM12, T anM21, T anM22, T anM31, T anM32)
+		: M11(anM11), M12(anM12)
+		, M21(anM21), M22(anM22)
+		, M31(anM31), M32(anM32)
+	{
+
+	}
+
+	template <typename T>
+	constexpr AffineTransform2D<T>::AffineTransform2D(const Matrix<3, 3, T>& aMatrix)
+		: M11(aMatrix.GetCell(0, 0)), M12(aMatrix.GetCell(1, 0))
+		, M21(aMatrix.GetCell(0, 1)), M22(aMatrix.GetCell(1, 1))
+		, M31(aMatrix.GetCell(0, 2)), M32(aMatrix.GetCell(1, 2))
+	{
+
+	}
+
+	template <typename T>
+	constexpr AffineTransform2D<T> AffineTransform2D<T>::CreateRotation(T anAngle) requires(IsFractional<T>)
+	{
+		const T c = Math::Cosine<T>(anAngle);
+		const T s = Math::Sine<T>(anAngle);
+
+		return AffineTransform2D(c, s, -s, c, T(0), T(0));
+	}
+
+	template <typename T>
+	constexpr AffineTransform2D<T> AffineTransform2D<T>::CreateRotation(T anAngle, const Point<T>& aCenterPoint) requires(IsFractional<T>)
+	{
+		AffineTransform2D result = CreateRotation(anAngle);
+		result.M31 = aCenterPoint.X * (T(1) - result.M11) + aCenterPoint.Y * result.M12;
+		result.M32 = aCenterPoint.Y * (T(1) - result.M11) - aCenterPoint.X * result.M12;
+		return result;
+	}
+
+	template <typename T>
+	constexpr AffineTransform2D<T> AffineTransform2D<T>::CreateScale(T anXScale, T aYScale)
+	{
+		return AffineTransform2D(anXScale, T(0), T(0), aYScale, T(0), T(0));
+	}
+
+	template <typename T>
+	constexpr AffineTransform2D<T> AffineTransform2D<T>::CreateScale(T anXScale, T aYScale, const Point<T>& aCenterPoint)
+	{
+		return AffineTransform2D(anXScale, T(0), T(0), aYScale, aCenterPoint.X * (T(1) - anXScale), aCenterPoint.Y * (T(1) - aYScale));
+	}
+
+	template <typename T>
+	constexpr AffineTransform2D<T> AffineTransform2D<T>::CreateSkew(T anXAngle, T aYAngle) requires(IsFractional<T>)
+	{
+		return AffineTransform2D(T(1), Math::Tangent<T>(aYAngle), Math::Tangent<T>(anXAngle), T(1), T(0), T(0));
+	}
+
+	template <typename T>
+	constexpr AffineTransform2D<T> AffineTransform2D<T>::CreateTranslation(T anX, T aY)
+	{
+		return AffineTransform2D(T(1), T(0), T(0), T(1), anX, aY);
+	}
+
+	template <typename T>
+	constexpr void AffineTransform2D<T>::SetTranslation(const Vector2<T>& aTranslation)
+	{
+		M31 = aTranslation.X;
+		M32 = aTranslation.Y;
+	}
+
+	template <typename T>
+	constexpr std::optional<AffineTransform2D<T>> AffineTransform2D<T>::Inverse() const
+	{
+		const T determinant = Determinant();
+		if (determinant == T(0))
+			return { };
+
+		const T inverseDeterminant = T(1) / determinant;
+
+		const T m11 = M22 * inverseDeterminant;
+		const T m12 = -M12 * inverseDeterminant;
+		const T m21 = -M21 * inverseDeterminant;
+		const T m22 = M11 * inverseDeterminant;
+
+		return AffineTransform2D(
+			m11, m12,
+			m21, m22,
+			-(M31 * m11 + M32 * m21), -(M31 * m12 + M32 * m22)
+		);
+	}
+
+	template <typename T>
+	constexpr Point<T> AffineTransform2D<T>::TransformPoint(const Point<T>& aPoint) const
+	{
+		return Point<T>(
+			aPoint.X * M11 + aPoint.Y * M21 + M31,
+			aPoint.X * M12 + aPoint.Y * M22 + M32
+		);
+	}
+
+	template <typename T>
+	constexpr Vector2<T> AffineTransform2D<T>::TransformVector(const Vector2<T>& aVector) const
+	{
+		return Vector2<T>(
+			aVector.X * M11 + aVector.Y * M21,
+			aVector.X * M12 + aVector.Y * M22
+		);
+	}
+
+	template <typename T>
+	constexpr Rectangle<T> AffineTransform2D<T>::TransformBounds(const Rectangle<T>& aRectangle) const
+	{
+		const T halfWidth = aRectangle.Width / T(2);
+		const T halfHeight = aRectangle.Height / T(2);
+
+		const Point<T> center = TransformPoint(Point<T>(aRectangle.X + halfWidth, aRectangle.Y + halfHeight));
+		const T extentX = Math::Abs(M11) * halfWidth + Math::Abs(M21) * halfHeight;
+		const T extentY = Math::Abs(M12) * halfWidth + Math::Abs(M22) * halfHeight;
+
+		return Rectangle<T>(Point<T>(center.X - extentX, center.Y - extentY), Size<T>(extentX * T(2), extentY * T(2)));
+	}
+
+	template <typename T>
+	void AffineTransform2D<T>::TransformPoints(std::span<const Point<T>> somePoints, std::span<Point<T>> outPoints) const
+	{
+		static_assert(sizeof(Point<T>) == sizeof(T) * 2, "Points need to be tightly packed coordinate pairs.");
+
+		if (outPoints.size() < somePoints.size())
+			throw std::invalid_argument("The output buffer needs to be at least as large as the input.");
+
+		TransformPairs<true>(reinterpret_cast<const T*>(somePoints.data()), reinterpret_cast<T*>(outPoints.data()), somePoints.size());
+	}
+
+	template <typename T>
+	void AffineTransform2D<T>::TransformVectors(std::span<const Vector2<T>> someVectors, std::span<Vector2<T>> outVectors) const
+	{
+		static_assert(sizeof(Vector2<T>) == sizeof(T) * 2, "Vectors need to be tightly packed coordinate pairs.");
+
+		if (outVectors.size() < someVectors.size())
+			throw std::invalid_argument("The output buffer needs to be at least as large as the input.");
+
+		TransformPairs<false>(reinterpret_cast<const T*>(someVectors.data()), reinterpret_cast<T*>(outVectors.data()), someVectors.size());
+	}
+
+	template <typename T>
+	template <bool Translate>
+	void AffineTransform2D<T>::TransformPairs(const T* someCoordinates, T* outCoordinates, std::size_t aCount) const
+	{
+		Parallel::ForEachChunk(aCount, Parallel::GetChunkCount(aCount, 1 << 16), [&](std::size_t, std::size_t aBegin, std::size_t anEnd)
+		{
+			std::size_t i = aBegin;
+
+			if constexpr (std::is_same_v<T, float>)
+			{
+#if defined(ROSECOMMON_SIMD_AVX)
+				const __m256 same = _mm256_setr_ps(M11, M22, M11, M22, M11, M22, M11, M22);
+				const __m256 swapped = _mm256_setr_ps(M21, M12, M21, M12, M21, M12, M21, M12);
+				const __m256 translation = Translate ? _mm256_setr_ps(M31, M32, M31, M32, M31, M32, M31, M32) : _mm256_setzero_ps();
+
+				for (; i + 4 <= anEnd; i += 4)
+				{
+					const __m256 pairs = _mm256_loadu_ps(someCoordinates + i * 2);
+					const __m256 result = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(pairs, same), _mm256_mul_ps(_mm256_permute_ps(pairs, _MM_SHUFFLE(2, 3, 0, 1)), swapped)), translation);
+					_mm256_storeu_ps(outCoordinates + i * 2, result);
+				}
+#elif defined(ROSECOMMON_SIMD_SSE2)
+				const __m128 same = _mm_setr_ps(M11, M22, M11, M22);
+				const __m128 swapped = _mm_setr_ps(M21, M12, M21, M12);
+				const __m128 translation = Translate ? _mm_setr_ps(M31, M32, M31, M32) : _mm_setzero_ps();
+
+				for (; i + 2 <= anEnd; i += 2)
+				{
+					const __m128 pairs = _mm_loadu_ps(someCoordinates + i * 2);
+					const __m128 result = _mm_add_ps(_mm_add_ps(_mm_mul_ps(pairs, same), _mm_mul_ps(_mm_shuffle_ps(pairs, pairs, _MM_SHUFFLE(2, 3, 0, 1)), swapped)), translation);
+					_mm_storeu_ps(outCoordinates + i * 2, result);
+				}
+#endif
+			}
+
+			for (; i < anEnd; ++i)
+			{
+				const T x = someCoordinates[i * 2];
+				const T y = someCoordinates[i * 2 + 1];
+				outCoordinates[i * 2] = x * M11 + y * M21 + (Translate ? M31 : T(0));
+				outCoordinates[i * 2 + 1] = x * M12 + y * M22 + (Translate ? M32 : T(0));
+			}
+		});
+	}
+
+	template <typename T>
+	constexpr AffineTransform2D<T>::operator Matrix<3, 3, T>() const
+	{
+		Matrix<3, 3, T> result = Matrix<3, 3, T>::Identity();
+
+		result.GetCell(0, 0) = M11;
+		result.GetCell(1, 0) = M12;
+		result.GetCell(0, 1) = M21;
+		result.GetCell(1, 1) = M22;
+		result.GetCell(0, 2) = M31;
+		result.GetCell(1, 2) = M32;
+
+		return result;
+	}
+
+	template <typename T>
+	constexpr AffineTransform2D<T> AffineTransform2D<T>::operator*(const AffineTransform2D& aTransform) const
+	{
+		return AffineTransform2D(
+			M11 * aTransform.M11 + M12 * aTransform.M21,
+			M11 * aTransform.M12 + M12 * aTransform.M22,
+			M21 * aTransform.M11 + M22 * aTransform.M21,
+			M21 * aTransform.M12 + M22 * aTransform.M22,
+			M31 * aTransform.M11 + M32 * aTransform.M21 + aTransform.M31,
+			M31 * aTransform.M12 + M32 * aTransform.M22 + aTransform.M32
+		);
+	}
+}
@@ -0,0 +1,307 @@
+#pragma once
+
+#include "Common.hpp"
+#include "Spline.hpp"
+#include "Vector.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <span>
+#include <vector>
+
+namespace RoseCommon::Math
+{
+	/**
+	 * @brief A distance-based parameterization of a spline, for moving along it at a constant speed.
+	 *
+	 *        Each segment is adaptively subdivided until Gauss-Legendre quadrature of its speed converges,
+	 *        and the subdivision points are stored as a table of times and cumulative distances.
+	 *        Distances are mapped back to times with a binary search of the table followed by a few safeguarded Newton steps.
+	 *
+	 * @tparam Value The type of value being interpolated, either a scalar or one of Vector2, Vector3 or Vector4.
+	 * @tparam T The type of the time parameter, matching the value components.
+	 */
+	template <typename Value, typename T = typename _impl::VectorTraits<Value>::Component>
+	class ArcLengthTable
+	{
+	public:
+
+		//--------------------------------------------------
+		// * Construction
+		//--------------------------------------------------
+		#pragma region Construction
+
+		/**
+		 * @brief Initialize an empty table.
+		 */
+		ArcLengthTable() = default;
+
+		/**
+		 * @brief Initialize and build the table for a spline.
+		 * @param aSpline The spline to parameterize. It is copied into the table.
+		 * @param aTolerance The relative error allowed when measuring each piece of the curve.
+		 * @param aMaxDepth The number of times a segment can be halved while measuring it.
+		 */
+		explicit ArcLengthTable(const CubicSpline<Value, T>& aSpline, T aTolerance = T(1e-4), std::size_t aMaxDepth = 10);
+
+		#pragma endregion
+
+		//--------------------------------------------------
+		// * Properties
+		//--------------------------------------------------
+		#pragma region Properties
+
+		/**
+		 * @brief Get the cumulative distance at each table entry.
+		 */
+		std::span<const T> GetDistances() const { return myDistances; }
+
+		/**
+		 * @brief Get the spline being parameterized.
+		 */
+		const CubicSpline<Value, T>& GetSpline() const { return mySpline; }
+
+		/**
+		 * @brief Get the spline time at each table entry.
+		 */
+		std::span<const T> GetTimes() const { return myTimes; }
+
+		/**
+		 * @brief Get the total length of the spline.
+		 */
+		T Length() const { return myDistances.empty() ? T(0) : myDistances.back(); }
+
+		#pragma endregion
+
+		//--------------------------------------------------
+		// * Methods
+		//--------------------------------------------------
+		#pragma region Methods
+
+		/**
+		 * @brief Rebuild the table for a spline.
+		 * @param aSpline The spline to parameterize. It is copied into the table.
+		 * @param aTolerance The relative error allowed when measuring each piece of the curve.
+		 * @param aMaxDepth The number of times a segment can be halved while measuring it.
+		 */
+		void Build(const CubicSpline<Value, T>& aSpline, T aTolerance = T(1e-4), std::size_t aMaxDepth = 10);
+
+		/**
+		 * @brief Evaluate the spline at a distance along it.
+		 * @param aDistance The distance from the start of the spline, clamped to its length.
+		 */
+		Value Evaluate(T aDistance) const { return mySpline.Evaluate(GetTime(aDistance)); }
+
+		/**
+		 * @brief Calculate the distance along the spline at a time.
+		 * @param aTime The spline time, clamped to its start and end.
+		 */
+		T GetDistance(T aTime) const;
+
+		/**
+		 * @brief Find the spline time at a distance along it.
+		 * @param aDistance The distance from the start of the spline, clamped to its length.
+		 */
+		T GetTime(T aDistance) const;
+
+		/**
+		 * @brief Find the spline times at many distances. Sorted distances reuse the previous table entry instead of searching.
+		 * @param someDistances The distances from the start of the spline.
+		 * @param someTimes A buffer to write the time at each distance into, at least as large as the distance count.
+		 */
+		void GetTimes(std::span<const T> someDistances, std::span<T> someTimes) const;
+
+		#pragma endregion
+
+	private:
+		T GetSpeed(std::size_t aSegment, T aTime) const;
+		T Integrate(std::size_t aSegment, T aStart, T anEnd) const;
+		void Subdivide(std::size_t aSegment, T aStart, T anEnd, T aLength, std::size_t aDepth, std::size_t aMaxDepth);
+
+		std::size_t FindEntry(T aDistance) const;
+		T SolveTime(std::size_t anEntry, T aDistance) const;
+
+	private:
+		CubicSpline<Value, T> mySpline;
+		std::vector<T> myTimes;
+		std::vector<T> myDistances;
+		T myTolerance = T(1e-4);
+	};
+}
+
+namespace RoseCommon::Math
+{
+	template <typename Value, typename T>
+	ArcLengthTable<Value, T>::ArcLengthTable(const CubicSpline<Value, T>& aSpline, T aTolerance, std::size_t aMaxDepth)
+	{
+		Build(aSpline, aTolerance, aMaxDepth);
+	}
+
+	template <typename Value, typename T>
+	void ArcLengthTable<Value, T>::Build(const CubicSpline<Value, T>& aSpline, T aTolerance, std::size_t aMaxDepth)
+	{
+		mySpline = aSpline;
+		myTolerance = aTolerance;
+		myTimes.clear();
+		myDistances.clear();
+
+		if (mySpline.SegmentCount() == 0)
+			return;
+
+		const std::span<const T> knots = mySpline.GetKnots();
+		myTimes.push_back(knots.front());
+		myDistances.push_back(T(0));
+
+		for (std::size_t segment = 0; segment < mySpline.SegmentCount(); ++segment)
+			Subdivide(segment, knots[segment], knots[segment + 1], Integrate(segment, knots[segment], knots[segment + 1]), 0, aMaxDepth);
+	}
+
+	template <typename Value, typename T>
+	T ArcLengthTable<Value, T>::GetDistance(T aTime) const
+	{
+		if (myTimes.empty())
+			return T(0);
+
+		aTime = Math::Clamp<T>(aTime, myTimes.front(), myTimes.back());
+
+		const std::size_t entry = Math::Min<std::size_t>(
+			static_cast<std::size_t>(std::upper_bound(myTimes.begin(), myTimes.end(), aTime) - myTimes.begin()) - 1,
+			myTimes.size() - 2
+		);
+
+		const T start = myTimes[entry];
+		return myDistances[entry] + Integrate(mySpline.FindSegment((start + myTimes[entry + 1]) / 2), start, aTime);
+	}
+
+	template <typename Value, typename T>
+	T ArcLengthTable<Value, T>::GetTime(T aDistance) const
+	{
+		if (myTimes.empty())
+			return T(0);
+
+		aDistance = Math::Clamp<T>(aDistance, T(0), Length());
+		return SolveTime(FindEntry(aDistance), aDistance);
+	}
+
+	template <typename Value, typename T>
+	void ArcLengthTable<Value, T>::GetTimes(std::span<const T> someDistances, std::span<T> someTimes) const
+	{
+		if (myTimes.empty())
+		{
+			std::fill_n(someTimes.begin(), someDistances.size(), T(0));
+			return;
+		}
+
+		std::size_t entry = 0;
+		for (std::size_t i = 0; i < someDistances.size(); ++i)
+		{
+			const T distance = Math::Clamp<T>(someDistances[i], T(0), Length());
+
+			if (distance < myDistances[entry] || myDistances[entry + 1] < distance)
+				entry = FindEntry(distance);
+
+			someTimes[i] = SolveTime(entry, distance);
+		}
+	}
+
+	template <typename Value, typename T>
+	T ArcLengthTable<Value, T>::GetSpeed(std::size_t aSegment, T aTime) const
+	{
+		using Traits = _impl::VectorTraits<Value>;
+
+		const Value derivative = mySpline.EvaluateSegmentDerivative(aSegment, mySpline.GetSegmentAmount(aSegment, aTime));
+
+		T lengthSquared = T(0);
+		for (std::size_t c = 0; c < Traits::Count; ++c)
+			lengthSquared += Traits::Get(derivative, c) * Traits::Get(derivative, c);
+
+		return std::sqrt(lengthSquared);
+	}
+
+	template <typename Value, typename T>
+	T ArcLengthTable<Value, T>::Integrate(std::size_t aSegment, T aStart, T anEnd) const
+	{
+		// Five-point Gauss-Legendre quadrature, exact for polynomials up to degree nine.
+		constexpr T nodes[] = { T(0), T(-0.5384693101056831), T(0.5384693101056831), T(-0.9061798459386640), T(0.9061798459386640) };
+		constexpr T weights[] = { T(0.5688888888888889), T(0.4786286704993665), T(0.4786286704993665), T(0.2369268850561891), T(0.2369268850561891) };
+
+		const T halfLength = (anEnd - aStart) / 2;
+		const T center = (anEnd + aStart) / 2;
+
+		T sum = T(0);
+		for (std::size_t i = 0; i < 5; ++i)
+			sum += weights[i] * GetSpeed(aSegment, center + halfLength * nodes[i]);
+
+		return sum * halfLength;
+	}
+
+	template <typename Value, typename T>
+	void ArcLengthTable<Value, T>::Subdivide(std::size_t aSegment, T aStart, T anEnd, T aLength, std::size_t aDepth, std::size_t aMaxDepth)
+	{
+		const T middle = (aStart + anEnd) / 2;
+		const T firstHalf = Integrate(aSegment, aStart, middle);
+		const T secondHalf = Integrate(aSegment, middle, anEnd);
+		const T refinedLength = firstHalf + secondHalf;
+
+		// Always split at least once, so the initial guess for the Newton steps stays close.
+		if (aDepth + 1 >= aMaxDepth || (aDepth > 0 && std::abs(refinedLength - aLength) <= myTolerance * refinedLength))
+		{
+			const T distance = myDistances.back();
+			myTimes.push_back(middle);
+			myDistances.push_back(distance + firstHalf);
+			myTimes.push_back(anEnd);
+			myDistances.push_back(distance + refinedLength);
+			return;
+		}
+
+		Subdivide(aSegment, aStart, middle, firstHalf, aDepth + 1, aMaxDepth);
+		Subdivide(aSegment, middle, anEnd, secondHalf, aDepth + 1, aMaxDepth);
+	}
+
+	template <typename Value, typename T>
+	std::size_t ArcLengthTable<Value, T>::FindEntry(T aDistance) const
+	{
+		const std::size_t entry = static_cast<std::size_t>(std::upper_bound(myDistances.begin(), myDistances.end(), aDistance) - myDistances.begin());
+		return Math::Min<std::size_t>(entry > 0 ? entry - 1 : 0, myDistances.size() - 2);
+	}
+
+	template <typename Value, typename T>
+	T ArcLengthTable<Value, T>::SolveTime(std::size_t anEntry, T aDistance) const
+	{
+		constexpr std::size_t maxIterations = 8;
+
+		T low = myTimes[anEntry];
+		T high = myTimes[anEntry + 1];
+		const T startDistance = myDistances[anEntry];
+		const T distanceRange = myDistances[anEntry + 1] - startDistance;
+
+		if (distanceRange <= T(0))
+			return low;
+
+		// Each table entry lies within a single segment.
+		const std::size_t segment = mySpline.FindSegment((low + high) / 2);
+		const T start = low;
+		const T targetError = myTolerance * Math::Max<T>(distanceRange, T(1e-6));
+
+		T time = low + (high - low) * ((aDistance - startDistance) / distanceRange);
+		for (std::size_t i = 0; i < maxIterations; ++i)
+		{
+			const T error = startDistance + Integrate(segment, start, time) - aDistance;
+			if (std::abs(error) <= targetError)
+				break;
+
+			if (error > T(0))
+				high = time;
+			else
+				low = time;
+
+			// Newton step on the distance, falling back to bisection if it leaves the bracket.
+			const T speed = GetSpeed(segment, time);
+			const T nextTime = speed > T(0) ? time - error / speed : low;
+			time = (low < nextTime && nextTime < high) ? nextTime : (low + high) / 2;
+		}
+
+		return time;
+	}
+}
@@ -0,0 +1,703 @@
+#pragma once
+
+#include "Common.hpp"
+#include "Matrix3D.hpp"
+#include "Vector.hpp"
+#include "VectorReduction.hpp"
+
+#include "../Simd.hpp"
+
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <span>
+#include <type_traits>
+#include <vector>
+
+namespace RoseCommon::Math
+{
+	/**
+	 * @brief A three-dimensional box whose sides are aligned with the coordinate axes.
+	 * @tparam T A type for each component.
+	 */
+	template <typename T>
+	class AxisAlignedBox
+	{
+	public:
+
+		//--------------------------------------------------
+		// * Types
+		//--------------------------------------------------
+		#pragma region Types
+
+		using ComponentType = T;
+
+		#pragma endregion
+
+		//--------------------------------------------------
+		// * Static constants
+		//--------------------------------------------------
+		#pragma region Static constants
+
+		/**
+		 * @brief Create an inverted box which contains nothing, and becomes the other box when merged with one.
+		 */
+		static constexpr AxisAlignedBox Empty() { return AxisAlignedBox(Vector3<T>(std::numeric_limits<T>::max()), Vector3<T>(std::numeric_limits<T>::lowest())); }
+
+		#pragma endregion
+
+		//--------------------------------------------------
+		// * Construction
+		//--------------------------------------------------
+		#pragma region Construction
+
+		/**
+		 * @brief Initialize to a zero-sized box at the origin.
+		 */
+		constexpr AxisAlignedBox();
+
+		/**
+		 * @brief Initialize to the specified corners.
+		 * @param aMinimum The corner with the lowest coordinates.
+		 * @param aMaximum The corner with the highest coordinates.
+		 */
+		constexpr AxisAlignedBox(const Vector3<T>& aMinimum, const Vector3<T>& aMaximum);
+
+		/**
+		 * @brief Create a box from its center and half the size along each axis.
+		 * @param aCenter The center of the box.
+		 * @param someExtents Half the size of the box along each axis.
+		 * @return The box.
+		 */
+		static constexpr AxisAlignedBox CreateFromCenter(const Vector3<T>& aCenter, const Vector3<T>& someExtents);
+
+		/**
+		 * @brief Create the smallest box which contains all the specified points.
+		 * @param somePoints The points to contain.
+		 * @return The bounding box, or an empty box if no points were given.
+		 */
+		static constexpr AxisAlignedBox CreateFromPoints(std::span<const Vector3<T>> somePoints);
+
+		#pragma endregion
+
+		//--------------------------------------------------
+		// * Properties
+		//--------------------------------------------------
+		#pragma region Properties
+
+		/**
+		 * @brief The corner with the lowest coordinates.
+		 */
+		Vector3<T> Min;
+
+		/**
+		 * @brief The corner with the highest coordinates.
+		 */
+		Vector3<T> Max;
+
+		/**
+		 * @brief Get the center of the box.
+		 */
+		constexpr Vector3<T> Center() const { return (Min + Max) / Vector3<T>(T(2)); }
+
+		/**
+		 * @brief Get half the size of the box along each axis.
+		 */
+		constexpr Vector3<T> Extents() const { return (Max - Min) / Vector3<T>(T(2)); }
+
+		/**
+		 * @brief Get the size of the box along each axis.
+		 */
+		constexpr Vector3<T> Size() const { return Max - Min; }
+
+		/**
+		 * @brief Check whether the box is inverted on any axis, and so contains nothing.
+		 */
+		constexpr bool IsEmpty() const { return Max.X < Min.X || Max.Y < Min.Y || Max.Z < Min.Z; }
+
+		/**
+		 * @brief Calculate the total area of the box's six sides.
+		 */
+		constexpr T SurfaceArea() const;
+
+		/**
+		 * @brief Calculate the volume of the box.
+		 */
+		constexpr T Volume() const { return Size().Content(); }
+
+		#pragma endregion
+
+		//--------------------------------------------------
+		// * Methods
+		//--------------------------------------------------
+		#pragma region Methods
+
+		/**
+		 * @brief Find the point on or within the box which is closest to the specified point.
+		 * @param aPoint A point to find the closest point to.
+		 * @return The closest point.
+		 */
+		constexpr Vector3<T> ClosestPoint(const Vector3<T>& aPoint) const { return Vector3<T>::Clamp(aPoint, Min, Max); }
+
+		/**
+		 * @brief Check whether the box contains a specific point. Points on the surface are considered contained.
+		 * @param aPoint A point to check.
+		 * @return Whether the given point is contained within.
+		 */
+		constexpr bool Contains(const Vector3<T>& aPoint) const;
+
+		/**
+		 * @brief Check whether the box entirely contains another box.
+		 * @param aBox A box to check.
+		 * @return Whether the given box is entirely contained within.
+		 */
+		constexpr bool Contains(const AxisAlignedBox& aBox) const;
+
+		/**
+		 * @brief Calculate the squared distance from the box to a point.
+		 * @param aPoint A point to measure the distance to.
+		 * @return The squared distance, or zero if the point is contained within.
+		 */
+		constexpr T DistanceSquared(const Vector3<T>& aPoint) const { return Vector3<T>::DistanceSquared(ClosestPoint(aPoint), aPoint); }
+
+		/**
+		 * @brief Expand or shrink the box by the specified amount, in each direction.
+		 * @param anAmount An amount by which to move each side of the box outwards.
+		 */
+		void Inflate(const Vector3<T>& anAmount);
+
+		/**
+		 * @brief Find the intersection of two boxes.
+		 * @param aBox A box to calculate the intersection with the current box.
+		 * @return The intersection volume, if any.
+		 */
+		constexpr std::optional<AxisAlignedBox> Intersection(const AxisAlignedBox& aBox) const;
+
+		/**
+		 * @brief Check if the specified box intersects with the current. Boxes which only touch are considered intersecting.
+		 * @param aBox A box to check.
+		 * @return Whether the boxes intersect with each other.
+		 */
+		constexpr bool Intersects(const AxisAlignedBox& aBox) const;
+
+		/**
+		 * @brief Get the smallest box which contains both of the specified boxes.
+		 * @param aBox1 Source box.
+		 * @param aBox2 Source box.
+		 * @return The merged box.
+		 */
+		static constexpr AxisAlignedBox Merge(const AxisAlignedBox& aBox1, const AxisAlignedBox& aBox2);
+
+		/**
+		 * @brief Get the smallest box which contains both the specified box and point.
+		 * @param aBox Source box.
+		 * @param aPoint Source point.
+		 * @return The merged box.
+		 */
+		static constexpr AxisAlignedBox Merge(const AxisAlignedBox& aBox, const Vector3<T>& aPoint);
+
+		/**
+		 * @brief Get the smallest axis-aligned box which contains the current box after being transformed.
+		 *        Uses the absolute values of the rotation part, so is exact for the transformed corners without evaluating all eight of them.
+		 * @param aMatrix An affine transformation matrix.
+		 * @return The transformed bounding box.
+		 */
+		constexpr AxisAlignedBox Transformed(const Matrix3D<T>& aMatrix) const;
+
+		#pragma endregion
+
+		//--------------------------------------------------
+		// * Operators
+		//--------------------------------------------------
+		#pragma region Operators
+
+		constexpr bool operator==(const AxisAlignedBox& aBox) const { return Min == aBox.Min && Max == aBox.Max; }
+		constexpr bool operator!=(const AxisAlignedBox& aBox) const { return !operator==(aBox); }
+
+		#pragma endregion
+	};
+
+	/**
+	 * @brief A structure-of-arrays collection of boxes, for testing one shape against many boxes at a time.
+	 *        Results are written as bitmasks, see Simd::GetMaskWordCount() for the required mask size.
+	 * @tparam T A type for each component. Single-precision floats use SSE/AVX when available.
+	 */
+	template <typename T>
+	class AxisAlignedBoxBatch
+	{
+	public:
+
+		//--------------------------------------------------
+		// * Construction
+		//--------------------------------------------------
+		#pragma region Construction
+
+		/**
+		 * @brief Initialize an empty batch.
+		 */
+		AxisAlignedBoxBatch() = default;
+
+		/**
+		 * @brief Initialize with a copy of the specified boxes.
+		 * @param someBoxes The boxes to add.
+		 */
+		explicit AxisAlignedBoxBatch(std::span<const AxisAlignedBox<T>> someBoxes);
+
+		#pragma endregion
+
+		//--------------------------------------------------
+		// * Properties
+		//--------------------------------------------------
+		#pragma region Properties
+
+		/**
+		 * @brief Get the number of boxes in the batch.
+		 */
+		std::size_t Size() const { return myMinX.size(); }
+
+		/**
+		 * @brief Get a box from the batch.
+		 * @param anIndex The index of the box.
+		 * @return A copy of the box.
+		 */
+		AxisAlignedBox<T> Get(std::size_t anIndex) const;
+
+		/**
+		 * @brief Replace a box in the batch.
+		 * @param anIndex The index of the box.
+		 * @param aBox The new box value.
+		 */
+		void Set(std::size_t anIndex, const AxisAlignedBox<T>& aBox);
+
+		#pragma endregion
+
+		//--------------------------------------------------
+		// * Methods
+		//--------------------------------------------------
+		#pragma region Methods
+
+		/**
+		 * @brief Add a box to the end of the batch.
+		 * @param aBox The box to add.
+		 */
+		void Add(const AxisAlignedBox<T>& aBox);
+
+		/**
+		 * @brief Remove all boxes from the batch.
+		 */
+		void Clear();
+
+		/**
+		 * @brief Reserve memory for a number of boxes.
+		 * @param aCount The number of boxes to reserve memory for.
+		 */
+		void Reserve(std::size_t aCount);
+
+		/**
+		 * @brief Test which boxes are entirely contained within the specified box.
+		 * @param aBox The containing box.
+		 * @param someResultMasks The bitmask to write the results to.
+		 */
+		void ContainedBy(const AxisAlignedBox<T>& aBox, std::span<std::uint64_t> someResultMasks) const;
+
+		/**
+		 * @brief Test which boxes contain the specified point.
+		 * @param aPoint The point to test.
+		 * @param someResultMasks The bitmask to write the results to.
+		 */
+		void Contains(const Vector3<T>& aPoint, std::span<std::uint64_t> someResultMasks) const;
+
+		/**
+		 * @brief Test which boxes intersect the specified box.
+		 * @param aBox The box to test.
+		 * @param someResultMasks The bitmask to write the results to.
+		 */
+		void Intersects(const AxisAlignedBox<T>& aBox, std::span<std::uint64_t> someResultMasks) const;
+
+		/**
+		 * @brief Test which boxes are at least partially on the positive side of all the specified planes,
+		 *        such as the six planes of a view frustum.
+		 * @param somePlanes Planes stored as (Normal.X, Normal.Y, Normal.Z, Distance), where a point P is inside if Dot(Normal, P) + Distance >= 0.
+		 * @param someResultMasks The bitmask to write the results to.
+		 * @param someHints Optional plane index per box, which remembers the plane that last rejected a box and tests it first on the next call.
+		 *                  Only the hint of the first box of each SIMD pack is used. Zero-initialize before first use.
+		 */
+		void IntersectsPlanes(std::span<const Vector4<T>> somePlanes, std::span<std::uint64_t> someResultMasks, std::span<std::uint8_t> someHints = {}) const;
+
+		/**
+		 * @brief Test which boxes are hit by a ray, using the slab method.
+		 * @param anOrigin The origin of the ray.
+		 * @param anInverseDirection The reciprocal of each component of the ray direction.
+		 * @param aMaxDistance The length of the ray, in multiples of the direction vector.
+		 * @param someResultMasks The bitmask to write the results to.
+		 */
+		void IntersectsRay(const Vector3<T>& anOrigin, const Vector3<T>& anInverseDirection, T aMaxDistance, std::span<std::uint64_t> someResultMasks) const;
+
+		#pragma endregion
+
+	private:
+		std::vector<T> myMinX, myMinY, myMinZ;
+		std::vector<T> myMaxX, myMaxY, myMaxZ;
+	};
+}
+
+namespace RoseCommon::Math
+{
+	namespace _impl
+	{
+		/**
+		 * @brief Test a pack of shapes against a set of planes, using and updating a hint of the plane which last rejected the first shape of the pack.
+		 *        Trying that plane first rejects the whole pack at once when neighbouring shapes leave the planes together, as they tend to.
+		 * @param somePlanes The planes to test against.
+		 * @param someHints A plane index per shape, or an empty span to test every plane in order.
+		 * @param anIndex The index of the first shape in the pack.
+		 * @param aPlaneTest A function taking a plane and returning the mask of shapes at least partially on its positive side.
+		 * @return The mask of shapes on the positive side of all the planes.
+		 */
+		template <typename Pack, typename T, typename PlaneTest>
+		auto IntersectsPlanes(std::span<const Vector4<T>> somePlanes, std::span<std::uint8_t> someHints, std::size_t anIndex, const PlaneTest& aPlaneTest)
+		{
+			auto result = Pack::Broadcast(T(0)) <= Pack::Broadcast(T(0));
+
+			if (someHints.empty())
+			{
+				for (const Vector4<T>& plane : somePlanes)
+					result = result & aPlaneTest(plane);
+
+				return result;
+			}
+
+			std::uint8_t& hint = someHints[anIndex];
+			if (hint < somePlanes.size())
+			{
+				const auto inside = aPlaneTest(somePlanes[hint]);
+				if (inside.MoveMask() == 0)
+					return inside;
+			}
+
+			// Find the first plane rejecting the first shape without branching, as the planes rejecting each pack are unpredictable.
+			std::size_t firstRejection = somePlanes.size();
+			for (std::size_t i = somePlanes.size(); i-- > 0;)
+			{
+				const auto inside = aPlaneTest(somePlanes[i]);
+				firstRejection = (inside.MoveMask() & 1) == 0 ? i : firstRejection;
+				result = result & inside;
+			}
+
+			if (firstRejection < somePlanes.size())
+				hint = static_cast<std::uint8_t>(firstRejection);
+
+			return result;
+		}
+	}
+
+	#pragma region AxisAlignedBox implementation
+
+	template <typename T>
+	constexpr AxisAlignedBox<T>::AxisAlignedBox()
+		: Min(0, 0, 0)
+		, Max(0, 0, 0)
+	{
+
+	}
+
+	template <typename T>
+	constexpr AxisAlignedBox<T>::AxisAlignedBox(const Vector3<T>& aMinimum, const Vector3<T>& aMaximum)
+		: Min(aMinimum)
+		, Max(aMaximum)
+	{
+
+	}
+
+	template <typename T>
+	constexpr AxisAlignedBox<T> AxisAlignedBox<T>::CreateFromCenter(const Vector3<T>& aCenter, const Vector3<T>& someExtents)
+	{
+		return AxisAlignedBox(aCenter - someExtents, aCenter + someExtents);
+	}
+
+	template <typename T>
+	constexpr AxisAlignedBox<T> AxisAlignedBox<T>::CreateFromPoints(std::span<const Vector3<T>> somePoints)
+	{
+		if (std::is_constant_evaluated())
+		{
+			AxisAlignedBox box = Empty();
+			for (const Vector3<T>& point : somePoints)
+				box = Merge(box, point);
+			return box;
+		}
+
+		const auto [min, max] = Bounds(somePoints);
+		return AxisAlignedBox(min, max);
+	}
+
+	template <typename T>
+	constexpr T AxisAlignedBox<T>::SurfaceArea() const
+	{
+		const Vector3<T> size = Size();
+		return T(2) * (size.X * size.Y + size.Y * size.Z + size.Z * size.X);
+	}
+
+	template <typename T>
+	constexpr bool AxisAlignedBox<T>::Contains(const Vector3<T>& aPoint) const
+	{
+		return
+			Min.X <= aPoint.X && aPoint.X <= Max.X &&
+			Min.Y <= aPoint.Y && aPoint.Y <= Max.Y &&
+			Min.Z <= aPoint.Z && aPoint.Z <= Max.Z
+			;
+	}
+
+	template <typename T>
+	constexpr bool AxisAlignedBox<T>::Contains(const AxisAlignedBox& aBox) const
+	{
+		return
+			Min.X <= aBox.Min.X && aBox.Max.X <= Max.X &&
+			Min.Y <= aBox.Min.Y && aBox.Max.Y <= Max.Y &&
+			Min.Z <= aBox.Min.Z && aBox.Max.Z <= Max.Z
+			;
+	}
+
+	template <typename T>
+	void AxisAlignedBox<T>::Inflate(const Vector3<T>& anAmount)
+	{
+		Min -= anAmount;
+		Max += anAmount;
+	}
+
+	template <typename T>
+	constexpr std::optional<AxisAlignedBox<T>> AxisAlignedBox<T>::Intersection(const AxisAlignedBox& aBox) const
+	{
+		const AxisAlignedBox intersection(Vector3<T>::Max(Min, aBox.Min), Vector3<T>::Min(Max, aBox.Max));
+
+		if (intersection.IsEmpty())
+			return { };
+
+		return intersection;
+	}
+
+	template <typename T>
+	constexpr bool AxisAlignedBox<T>::Intersects(const AxisAlignedBox& aBox) const
+	{
+		return
+			Min.X <= aBox.Max.X && aBox.Min.X <= Max.X &&
+			Min.Y <= aBox.Max.Y && aBox.Min.Y <= Max.Y &&
+			Min.Z <= aBox.Max.Z && aBox.Min.Z <= Max.Z
+			;
+	}
+
+	template <typename T>
+	constexpr AxisAlignedBox<T> AxisAlignedBox<T>::Merge(const AxisAlignedBox& aBox1, const AxisAlignedBox& aBox2)
+	{
+		return AxisAlignedBox(Vector3<T>::Min(aBox1.Min, aBox2.Min), Vector3<T>::Max(aBox1.Max, aBox2.Max));
+	}
+
+	template <typename T>
+	constexpr AxisAlignedBox<T> AxisAlignedBox<T>::Merge(const AxisAlignedBox& aBox, const Vector3<T>& aPoint)
+	{
+		return AxisAlignedBox(Vector3<T>::Min(aBox.Min, aPoint), Vector3<T>::Max(aBox.Max, aPoint));
+	}
+
+	template <typename T>
+	constexpr AxisAlignedBox<T> AxisAlignedBox<T>::Transformed(const Matrix3D<T>& aMatrix) const
+	{
+		// Arvo's method: each output axis is the translated center plus the absolute-weighted extents.
+		const Vector3<T> center = Center();
+		const Vector3<T> extents = Extents();
+
+		const T centerValues[3] = { center.X, center.Y, center.Z };
+		const T extentValues[3] = { extents.X, extents.Y, extents.Z };
+		T newCenter[3] = { };
+		T newExtents[3] = { };
+
+		for (std::size_t column = 0; column < 3; ++column)
+		{
+			newCenter[column] = aMatrix.GetCell(column, 3);
+
+			for (std::size_t row = 0; row < 3; ++row)
+			{
+				const T cell = aMatrix.GetCell(column, row);
+				newCenter[column] += centerValues[row] * cell;
+				newExtents[column] += extentValues[row] * Math::Abs(cell);
+			}
+		}
+
+		return CreateFromCenter(
+			Vector3<T>(newCenter[0], newCenter[1], newCenter[2]),
+			Vector3<T>(newExtents[0], newExtents[1], newExtents[2])
+		);
+	}
+
+	#pragma endregion
+
+	#pragma region AxisAlignedBoxBatch implementation
+
+	template <typename T>
+	AxisAlignedBoxBatch<T>::AxisAlignedBoxBatch(std::span<const AxisAlignedBox<T>> someBoxes)
+	{
+		Reserve(someBoxes.size());
+		for (const AxisAlignedBox<T>& box : someBoxes)
+			Add(box);
+	}
+
+	template <typename T>
+	AxisAlignedBox<T> AxisAlignedBoxBatch<T>::Get(std::size_t anIndex) const
+	{
+		return AxisAlignedBox<T>(
+			Vector3<T>(myMinX[anIndex], myMinY[anIndex], myMinZ[anIndex]),
+			Vector3<T>(myMaxX[anIndex], myMaxY[anIndex], myMaxZ[anIndex])
+		);
+	}
+
+	template <typename T>
+	void AxisAlignedBoxBatch<T>::Set(std::size_t anIndex, const AxisAlignedBox<T>& aBox)
+	{
+		myMinX[anIndex] = aBox.Min.X;
+		myMinY[anIndex] = aBox.Min.Y;
+		myMinZ[anIndex] = aBox.Min.Z;
+		myMaxX[anIndex] = aBox.Max.X;
+		myMaxY[anIndex] = aBox.Max.Y;
+		myMaxZ[anIndex] = aBox.Max.Z;
+	}
+
+	template <typename T>
+	void AxisAlignedBoxBatch<T>::Add(const AxisAlignedBox<T>& aBox)
+	{
+		myMinX.push_back(aBox.Min.X);
+		myMinY.push_back(aBox.Min.Y);
+		myMinZ.push_back(aBox.Min.Z);
+		myMaxX.push_back(aBox.Max.X);
+		myMaxY.push_back(aBox.Max.Y);
+		myMaxZ.push_back(aBox.Max.Z);
+	}
+
+	template <typename T>
+	void AxisAlignedBoxBatch<T>::Clear()
+	{
+		myMinX.clear();
+		myMinY.clear();
+		myMinZ.clear();
+		myMaxX.clear();
+		myMaxY.clear();
+		myMaxZ.clear();
+	}
+
+	template <typename T>
+	void AxisAlignedBoxBatch<T>::Reserve(std::size_t aCount)
+	{
+		myMinX.reserve(aCount);
+		myMinY.reserve(aCount);
+		myMinZ.reserve(aCount);
+		myMaxX.reserve(aCount);
+		myMaxY.reserve(aCount);
+		myMaxZ.reserve(aCount);
+	}
+
+	template <typename T>
+	void AxisAlignedBoxBatch<T>::ContainedBy(const AxisAlignedBox<T>& aBox, std::span<std::uint64_t> someResultMasks) const
+	{
+		Simd::ClearMask(someResultMasks, Size());
+
+		Simd::ForEachPack<T>(Size(), [&]<typename Pack>(std::size_t anIndex)
+		{
+			const auto result =
+				(Pack::Load(&myMinX[anIndex]) >= Pack::Broadcast(aBox.Min.X)) & (Pack::Load(&myMaxX[anIndex]) <= Pack::Broadcast(aBox.Max.X)) &
+				(Pack::Load(&myMinY[anIndex]) >= Pack::Broadcast(aBox.Min.Y)) & (Pack::Load(&myMaxY[anIndex]) <= Pack::Broadcast(aBox.Max.Y)) &
+				(Pack::Load(&myMinZ[anIndex]) >= Pack::Broadcast(aBox.Min.Z)) & (Pack::Load(&myMaxZ[anIndex]) <= Pack::Broadcast(aBox.Max.Z));
+
+			Simd::WriteMaskBits(someResultMasks, anIndex, result.MoveMask());
+		});
+	}
+
+	template <typename T>
+	void AxisAlignedBoxBatch<T>::Contains(const Vector3<T>& aPoint, std::span<std::uint64_t> someResultMasks) const
+	{
+		Simd::ClearMask(someResultMasks, Size());
+
+		Simd::ForEachPack<T>(Size(), [&]<typename Pack>(std::size_t anIndex)
+		{
+			const Pack x = Pack::Broadcast(aPoint.X);
+			const Pack y = Pack::Broadcast(aPoint.Y);
+			const Pack z = Pack::Broadcast(aPoint.Z);
+
+			const auto result =
+				(Pack::Load(&myMinX[anIndex]) <= x) & (x <= Pack::Load(&myMaxX[anIndex])) &
+				(Pack::Load(&myMinY[anIndex]) <= y) & (y <= Pack::Load(&myMaxY[anIndex])) &
+				(Pack::Load(&myMinZ[anIndex]) <= z) & (z <= Pack::Load(&myMaxZ[anIndex]));
+
+			Simd::WriteMaskBits(someResultMasks, anIndex, result.MoveMask());
+		});
+	}
+
+	template <typename T>
+	void AxisAlignedBoxBatch<T>::Intersects(const AxisAlignedBox<T>& aBox, std::span<std::uint64_t> someResultMasks) const
+	{
+		Simd::ClearMask(someResultMasks, Size());
+
+		Simd::ForEachPack<T>(Size(), [&]<typename Pack>(std::size_t anIndex)
+		{
+			const auto result =
+				(Pack::Load(&myMinX[anIndex]) <= Pack::Broadcast(aBox.Max.X)) & (Pack::Broadcast(aBox.Min.X) <= Pack::Load(&myMaxX[anIndex])) &
+				(Pack::Load(&myMinY[anIndex]) <= Pack::Broadcast(aBox.Max.Y)) & (Pack::Broadcast(aBox.Min.Y) <= Pack::Load(&myMaxY[anIndex])) &
+				(Pack::Load(&myMinZ[anIndex]) <= Pack::Broadcast(aBox.Max.Z)) & (Pack::Broadcast(aBox.Min.Z) <= Pack::Load(&myMaxZ[anIndex]));
+
+			Simd::WriteMaskBits(someResultMasks, anIndex, result.MoveMask());
+		});
+	}
+
+	template <typename T>
+	void AxisAlignedBoxBatch<T>::IntersectsPlanes(std::span<const Vector4<T>> somePlanes, std::span<std::uint64_t> someResultMasks, std::span<std::uint8_t> someHints) const
+	{
+		Simd::ClearMask(someResultMasks, Size());
+
+		Simd::ForEachPack<T>(Size(), [&]<typename Pack>(std::size_t anIndex)
+		{
+			const Pack two = Pack::Broadcast(T(2));
+			const Pack minX = Pack::Load(&myMinX[anIndex]), maxX = Pack::Load(&myMaxX[anIndex]);
+			const Pack minY = Pack::Load(&myMinY[anIndex]), maxY = Pack::Load(&myMaxY[anIndex]);
+			const Pack minZ = Pack::Load(&myMinZ[anIndex]), maxZ = Pack::Load(&myMaxZ[anIndex]);
+
+			// Work in center/extent form, doubled to avoid the divisions.
+			const Pack centerX = minX + maxX, extentX = maxX - minX;
+			const Pack centerY = minY + maxY, extentY = maxY - minY;
+			const Pack centerZ = minZ + maxZ, extentZ = maxZ - minZ;
+
+			const auto result = _impl::IntersectsPlanes<Pack>(somePlanes, someHints, anIndex, [&](const Vector4<T>& aPlane)
+			{
+				const Pack normalX = Pack::Broadcast(aPlane.X);
+				const Pack normalY = Pack::Broadcast(aPlane.Y);
+				const Pack normalZ = Pack::Broadcast(aPlane.Z);
+
+				const Pack distance = normalX * centerX + normalY * centerY + normalZ * centerZ + two * Pack::Broadcast(aPlane.W);
+				const Pack radius = Pack::Abs(normalX) * extentX + Pack::Abs(normalY) * extentY + Pack::Abs(normalZ) * extentZ;
+
+				return distance + radius >= Pack::Broadcast(T(0));
+			});
+
+			Simd::WriteMaskBits(someResultMasks, anIndex, result.MoveMask());
+		});
+	}
+
+	template <typename T>
+	void AxisAlignedBoxBatch<T>::IntersectsRay(const Vector3<T>& anOrigin, const Vector3<T>& anInverseDirection, T aMaxDistance, std::span<std::uint64_t> someResultMasks) const
+	{
+		Simd::ClearMask(someResultMasks, Size());
+
+		Simd::ForEachPack<T>(Size(), [&]<typename Pack>(std::size_t anIndex)
+		{
+			const Pack originX = Pack::Broadcast(anOrigin.X), inverseX = Pack::Broadcast(anInverseDirection.X);
+			const Pack originY = Pack::Broadcast(anOrigin.Y), inverseY = Pack::Broadcast(anInverseDirection.Y);
+			const Pack originZ = Pack::Broadcast(anOrigin.Z), inverseZ = Pack::Broadcast(anInverseDirection.Z);
+
+			const Pack nearX = (Pack::Load(&myMinX[anIndex]) - originX) * inverseX, farX = (Pack::Load(&myMaxX[anIndex]) - originX) * inverseX;
+			const Pack nearY = (Pack::Load(&myMinY[anIndex]) - originY) * inverseY, farY = (Pack::Load(&myMaxY[anIndex]) - originY) * inverseY;
+			const Pack nearZ = (Pack::Load(&myMinZ[anIndex]) - originZ) * inverseZ, farZ = (Pack::Load(&myMaxZ[anIndex]) - originZ) * inverseZ;
+
+			const Pack entry = Pack::Max(Pack::Max(Pack::Min(nearX, farX), Pack::Min(nearY, farY)), Pack::Max(Pack::Min(nearZ, farZ), Pack::Broadcast(T(0))));
+			const Pack exit = Pack::Min(Pack::Min(Pack::Max(nearX, farX), Pack::Max(nearY, farY)), Pack::Min(Pack::Max(nearZ, farZ), Pack::Broadcast(aMaxDistance)));
+
+			Simd::WriteMaskBits(someResultMasks, anIndex, (entry <= exit).MoveMask());
+		});
+	}
+
+	#pragma endregion
+}
@@ -0,0 +1,583 @@
+#pragma once
+
+#include "AxisAlignedBox.hpp"
+#include "Common.hpp"
+#include "Vector.hpp"
+
+#include "../JobSystem.hpp"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <span>
+#include <vector>
+
+namespace RoseCommon::Math
+{
+	/**
+	 * @brief A bounding volume hierarchy over a set of primitives, each described by its bounding box.
+	 *        Built top-down with a binned surface area heuristic, with large subtrees built in parallel.
+	 *
+	 *        The hierarchy only stores primitive indices, the queries call back into the caller to do the exact
+	 *        primitive tests. This lets the same tree be used for boxes, triangles, or any other shape.
+	 *
+	 * @tparam T A type for each component.
+	 */
+	template <typename T>
+	class BoundingVolumeHierarchy
+	{
+	public:
+
+		//--------------------------------------------------
+		// * Types
+		//--------------------------------------------------
+		#pragma region Types
+
+		/**
+		 * @brief A tree node, 32 bytes large for single-precision floats.
+		 *        Interior nodes store the index of their first child, with the second child directly after it.
+		 *        Leaf nodes store the index of their first primitive in the primitive index list.
+		 */
+		struct Node
+		{
+			Vector3<T> Min;
+			std::uint32_t FirstChildOrPrimitive = 0;
+			Vector3<T> Max;
+			std::uint32_t PrimitiveCount = 0;
+
+			constexpr bool IsLeaf() const { return PrimitiveCount != 0; }
+			constexpr AxisAlignedBox<T> Bounds() const { return AxisAlignedBox<T>(Min, Max); }
+		};
+
+		/**
+		 * @brief The result of a raycast or nearest-primitive query.
+		 */
+		struct Hit
+		{
+			std::uint32_t Primitive = 0;
+			T Distance = 0;
+		};
+
+		#pragma endregion
+
+		//--------------------------------------------------
+		// * Static constants
+		//--------------------------------------------------
+		#pragma region Static constants
+
+		/**
+		 * @brief The number of bins evaluated along each axis when choosing a split.
+		 */
+		static constexpr std::size_t BinCount = 16;
+
+		/**
+		 * @brief The maximum depth of the tree. Traversal uses a fixed-size stack of this depth.
+		 */
+		static constexpr std::size_t MaxDepth = 64;
+
+		/**
+		 * @brief Subtrees with at least this many primitives are built on a separate thread.
+		 */
+		static constexpr std::size_t ParallelBuildThreshold = 8192;
+
+		#pragma endregion
+
+		//--------------------------------------------------
+		// * Construction
+		//--------------------------------------------------
+		#pragma region Construction
+
+		/**
+		 * @brief Initialize an empty hierarchy.
+		 */
+		BoundingVolumeHierarchy() = default;
+
+		/**
+		 * @brief Initialize and build the hierarchy over the specified primitives.
+		 * @param somePrimitiveBounds The bounding box of each primitive.
+		 * @param aMaxLeafSize The largest number of primitives to store in a single leaf.
+		 */
+		explicit BoundingVolumeHierarchy(std::span<const AxisAlignedBox<T>> somePrimitiveBounds, std::uint32_t aMaxLeafSize = 4);
+
+		#pragma endregion
+
+		//--------------------------------------------------
+		// * Properties
+		//--------------------------------------------------
+		#pragma region Properties
+
+		/**
+		 * @brief Get the bounds of the whole hierarchy.
+		 */
+		AxisAlignedBox<T> Bounds() const { return myNodes.empty() ? AxisAlignedBox<T>::Empty() : myNodes.front().Bounds(); }
+
+		/**
+		 * @brief Get the tree nodes, with the root node first.
+		 */
+		std::span<const Node> GetNodes() const { return myNodes; }
+
+		/**
+		 * @brief Get the primitive indices, in the order they are referenced by the leaf nodes.
+		 */
+		std::span<const std::uint32_t> GetPrimitiveIndices() const { return myPrimitiveIndices; }
+
+		#pragma endregion
+
+		//--------------------------------------------------
+		// * Methods
+		//--------------------------------------------------
+		#pragma region Methods
+
+		/**
+		 * @brief Rebuild the hierarchy from scratch over the specified primitives.
+		 * @param somePrimitiveBounds The bounding box of each primitive.
+		 * @param aMaxLeafSize The largest number of primitives to store in a single leaf.
+		 */
+		void Build(std::span<const AxisAlignedBox<T>> somePrimitiveBounds, std::uint32_t aMaxLeafSize = 4);
+
+		/**
+		 * @brief Update the node bounds for primitives that have moved, keeping the tree structure.
+		 *        Cheaper than a rebuild, but the tree quality degrades as primitives move far from where they were built.
+		 * @param somePrimitiveBounds The new bounding box of each primitive, in the same order as when built.
+		 */
+		void Refit(std::span<const AxisAlignedBox<T>> somePrimitiveBounds);
+
+		/**
+		 * @brief Find the primitive closest to a point.
+		 * @param aPoint The point to search from.
+		 * @param aDistanceFunction Called as aDistanceFunction(primitiveIndex) for candidate primitives, returning the squared distance to it.
+		 * @param aMaxDistanceSquared Primitives further away than this are ignored.
+		 * @return The closest primitive and its squared distance, if any was within range.
+		 */
+		template <typename DistanceFunction>
+		std::optional<Hit> Nearest(const Vector3<T>& aPoint, DistanceFunction&& aDistanceFunction, T aMaxDistanceSquared = std::numeric_limits<T>::max()) const;
+
+		/**
+		 * @brief Find the candidate primitives for overlapping a box, being all primitives in leaves whose bounds overlap it.
+		 * @param aBox The box to test against.
+		 * @param aCallback Called as aCallback(primitiveIndex) for each candidate, which is responsible for the exact test.
+		 */
+		template <typename Callback>
+		void Overlap(const AxisAlignedBox<T>& aBox, Callback&& aCallback) const;
+
+		/**
+		 * @brief Find the closest primitive hit by a ray. Children are visited front to back, so distant subtrees are skipped once a hit is found.
+		 * @param anOrigin The origin of the ray.
+		 * @param aDirection The direction of the ray. Distances are in multiples of this vector.
+		 * @param aMaxDistance The length of the ray.
+		 * @param aHitFunction Called as aHitFunction(primitiveIndex, currentMaxDistance) for candidate primitives,
+		 *                     returning an std::optional<T> with the hit distance if the primitive is hit.
+		 * @return The closest hit, if any.
+		 */
+		template <typename HitFunction>
+		std::optional<Hit> Raycast(const Vector3<T>& anOrigin, const Vector3<T>& aDirection, T aMaxDistance, HitFunction&& aHitFunction) const;
+
+		#pragma endregion
+
+	private:
+		struct BuildContext
+		{
+			std::span<const AxisAlignedBox<T>> PrimitiveBounds;
+			std::vector<Vector3<T>> Centroids;
+			std::atomic<std::uint32_t> NodeCount = 0;
+			std::uint32_t MaxLeafSize = 4;
+		};
+
+		void BuildNode(BuildContext& aContext, std::uint32_t aNodeIndex, std::uint32_t aFirst, std::uint32_t aCount, std::size_t aDepth);
+
+		static std::optional<T> IntersectNode(const Node& aNode, const Vector3<T>& anOrigin, const Vector3<T>& anInverseDirection, T aMaxDistance);
+
+	private:
+		std::vector<Node> myNodes;
+		std::vector<std::uint32_t> myPrimitiveIndices;
+	};
+}
+
+namespace RoseCommon::Math
+{
+	template <typename T>
+	BoundingVolumeHierarchy<T>::BoundingVolumeHierarchy(std::span<const AxisAlignedBox<T>> somePrimitiveBounds, std::uint32_t aMaxLeafSize)
+	{
+		Build(somePrimitiveBounds, aMaxLeafSize);
+	}
+
+	template <typename T>
+	void BoundingVolumeHierarchy<T>::Build(std::span<const AxisAlignedBox<T>> somePrimitiveBounds, std::uint32_t aMaxLeafSize)
+	{
+		myNodes.clear();
+		myPrimitiveIndices.clear();
+
+		if (somePrimitiveBounds.empty())
+			return;
+
+		const std::uint32_t primitiveCount = static_cast<std::uint32_t>(somePrimitiveBounds.size());
+
+		BuildContext context;
+		context.PrimitiveBounds = somePrimitiveBounds;
+		context.MaxLeafSize = Math::Max<std::uint32_t>(aMaxLeafSize, 1);
+		context.Centroids.reserve(primitiveCount);
+		for (const AxisAlignedBox<T>& bounds : somePrimitiveBounds)
+			context.Centroids.push_back(bounds.Center());
+
+		myPrimitiveIndices.resize(primitiveCount);
+		for (std::uint32_t i = 0; i < primitiveCount; ++i)
+			myPrimitiveIndices[i] = i;
+
+		// A binary tree with one primitive per leaf has at most 2N - 1 nodes.
+		myNodes.resize(static_cast<std::size_t>(primitiveCount) * 2 - 1);
+		context.NodeCount = 1;
+
+		BuildNode(context, 0, 0, primitiveCount, 0);
+
+		myNodes.resize(context.NodeCount);
+	}
+
+	template <typename T>
+	void BoundingVolumeHierarchy<T>::BuildNode(BuildContext& aContext, std::uint32_t aNodeIndex, std::uint32_t aFirst, std::uint32_t aCount, std::size_t aDepth)
+	{
+		AxisAlignedBox<T> bounds = AxisAlignedBox<T>::Empty();
+		AxisAlignedBox<T> centroidBounds = AxisAlignedBox<T>::Empty();
+		for (std::uint32_t i = aFirst; i < aFirst + aCount; ++i)
+		{
+			bounds = AxisAlignedBox<T>::Merge(bounds, aContext.PrimitiveBounds[myPrimitiveIndices[i]]);
+			centroidBounds = AxisAlignedBox<T>::Merge(centroidBounds, aContext.Centroids[myPrimitiveIndices[i]]);
+		}
+
+		Node& node = myNodes[aNodeIndex];
+		node.Min = bounds.Min;
+		node.Max = bounds.Max;
+		node.FirstChildOrPrimitive = aFirst;
+		node.PrimitiveCount = aCount;
+
+		if (aCount <= 1 || aDepth + 1 >= MaxDepth)
+			return;
+
+		// Evaluate the binned surface area heuristic along each axis.
+		struct Bin
+		{
+			AxisAlignedBox<T> Bounds = AxisAlignedBox<T>::Empty();
+			std::uint32_t Count = 0;
+		};
+
+		const Vector3<T> centroidSize = centroidBounds.Size();
+		const T centroidMin[3] = { centroidBounds.Min.X, centroidBounds.Min.Y, centroidBounds.Min.Z };
+		const T centroidExtent[3] = { centroidSize.X, centroidSize.Y, centroidSize.Z };
+
+		T bestCost = std::numeric_limits<T>::max();
+		std::size_t bestAxis = 0;
+		std::size_t bestSplit = 0;
+
+		for (std::size_t axis = 0; axis < 3; ++axis)
+		{
+			if (centroidExtent[axis] <= T(0))
+				continue;
+
+			std::array<Bin, BinCount> bins;
+			const T scale = static_cast<T>(BinCount) / centroidExtent[axis];
+
+			for (std::uint32_t i = aFirst; i < aFirst + aCount; ++i)
+			{
+				const Vector3<T>& centroid = aContext.Centroids[myPrimitiveIndices[i]];
+				const T value = axis == 0 ? centroid.X : (axis == 1 ? centroid.Y : centroid.Z);
+				const std::size_t binIndex = Math::Min<std::size_t>(BinCount - 1, static_cast<std::size_t>((value - centroidMin[axis]) * scale));
+
+				bins[binIndex].Bounds = AxisAlignedBox<T>::Merge(bins[binIndex].Bounds, aContext.PrimitiveBounds[myPrimitiveIndices[i]]);
+				bins[binIndex].Count += 1;
+			}
+
+			// Sweep from the right to get the cost of everything right of each split, then from the left to combine.
+			std::array<T, BinCount - 1> rightCosts;
+			AxisAlignedBox<T> rightBounds = AxisAlignedBox<T>::Empty();
+			std::uint32_t rightCount = 0;
+			for (std::size_t split = BinCount - 1; split > 0; --split)
+			{
+				rightBounds = AxisAlignedBox<T>::Merge(rightBounds, bins[split].Bounds);
+				rightCount += bins[split].Count;
+				rightCosts[split - 1] = rightCount == 0 ? T(0) : rightBounds.SurfaceArea() * static_cast<T>(rightCount);
+			}
+
+			AxisAlignedBox<T> leftBounds = AxisAlignedBox<T>::Empty();
+			std::uint32_t leftCount = 0;
+			for (std::size_t split = 1; split < BinCount; ++split)
+			{
+				leftBounds = AxisAlignedBox<T>::Merge(leftBounds, bins[split - 1].Bounds);
+				leftCount += bins[split - 1].Count;
+
+				if (leftCount == 0 || leftCount == aCount)
+					continue;
+
+				const T cost = leftBounds.SurfaceArea() * static_cast<T>(leftCount) + rightCosts[split - 1];
+				if (cost < bestCost)
+				{
+					bestCost = cost;
+					bestAxis = axis;
+					bestSplit = split;
+				}
+			}
+		}
+
+		std::uint32_t leftCount = 0;
+
+		if (bestSplit != 0)
+		{
+			// Splitting adds one node traversal, weighed the same as one primitive test.
+			const T leafCost = bounds.SurfaceArea() * static_cast<T>(aCount);
+			const T splitCost = bestCost + bounds.SurfaceArea();
+			if (splitCost >= leafCost && aCount <= aContext.MaxLeafSize)
+				return;
+
+			const T scale = static_cast<T>(BinCount) / centroidExtent[bestAxis];
+			const auto middle = std::partition(
+				myPrimitiveIndices.begin() + aFirst,
+				myPrimitiveIndices.begin() + aFirst + aCount,
+				[&](std::uint32_t aPrimitive)
+				{
+					const Vector3<T>& centroid = aContext.Centroids[aPrimitive];
+					const T value = bestAxis == 0 ? centroid.X : (bestAxis == 1 ? centroid.Y : centroid.Z);
+					return Math::Min<std::size_t>(BinCount - 1, static_cast<std::size_t>((value - centroidMin[bestAxis]) * scale)) < bestSplit;
+				});
+
+			leftCount = static_cast<std::uint32_t>(middle - (myPrimitiveIndices.begin() + aFirst));
+		}
+		else
+		{
+			// All centroids coincide, so no split is better than another.
+			if (aCount <= aContext.MaxLeafSize)
+				return;
+
+			leftCount = aCount / 2;
+		}
+
+		const std::uint32_t leftChild = aContext.NodeCount.fetch_add(2);
+		node.FirstChildOrPrimitive = leftChild;
+		node.PrimitiveCount = 0;
+
+		if (aCount >= ParallelBuildThreshold)
+		{
+			Parallel::JobSystem& jobSystem = Parallel::JobSystem::GetDefault();
+			const Parallel::JobHandle leftBuild = jobSystem.Schedule([&]()
+			{
+				BuildNode(aContext, leftChild, aFirst, leftCount, aDepth + 1);
+			});
+
+			BuildNode(aContext, leftChild + 1, aFirst + leftCount, aCount - leftCount, aDepth + 1);
+			jobSystem.Wait(leftBuild);
+		}
+		else
+		{
+			BuildNode(aContext, leftChild, aFirst, leftCount, aDepth + 1);
+			BuildNode(aContext, leftChild + 1, aFirst + leftCount, aCount - leftCount, aDepth + 1);
+		}
+	}
+
+	template <typename T>
+	void BoundingVolumeHierarchy<T>::Refit(std::span<const AxisAlignedBox<T>> somePrimitiveBounds)
+	{
+		// Children are always allocated after their parent, so a reverse sweep visits them first.
+		for (std::size_t i = myNodes.size(); i > 0; --i)
+		{
+			Node& node = myNodes[i - 1];
+			AxisAlignedBox<T> bounds = AxisAlignedBox<T>::Empty();
+
+			if (node.IsLeaf())
+			{
+				for (std::uint32_t p = node.FirstChildOrPrimitive; p < node.FirstChildOrPrimitive + node.PrimitiveCount; ++p)
+					bounds = AxisAlignedBox<T>::Merge(bounds, somePrimitiveBounds[myPrimitiveIndices[p]]);
+			}
+			else
+			{
+				bounds = AxisAlignedBox<T>::Merge(
+					myNodes[node.FirstChildOrPrimitive].Bounds(),
+					myNodes[node.FirstChildOrPrimitive + 1].Bounds()
+				);
+			}
+
+			node.Min = bounds.Min;
+			node.Max = bounds.Max;
+		}
+	}
+
+	template <typename T>
+	template <typename DistanceFunction>
+	std::optional<typename BoundingVolumeHierarchy<T>::Hit> BoundingVolumeHierarchy<T>::Nearest(const Vector3<T>& aPoint, DistanceFunction&& aDistanceFunction, T aMaxDistanceSquared) const
+	{
+		if (myNodes.empty())
+			return { };
+
+		std::optional<Hit> closest;
+		T closestDistance = aMaxDistanceSquared;
+
+		std::array<std::uint32_t, MaxDepth> stack;
+		std::size_t stackSize = 0;
+		stack[stackSize++] = 0;
+
+		while (stackSize > 0)
+		{
+			const Node& node = myNodes[stack[--stackSize]];
+			if (node.Bounds().DistanceSquared(aPoint) > closestDistance)
+				continue;
+
+			if (node.IsLeaf())
+			{
+				for (std::uint32_t p = node.FirstChildOrPrimitive; p < node.FirstChildOrPrimitive + node.PrimitiveCount; ++p)
+				{
+					const std::uint32_t primitive = myPrimitiveIndices[p];
+					const T distance = aDistanceFunction(primitive);
+					if (distance <= closestDistance)
+					{
+						closestDistance = distance;
+						closest = Hit{ primitive, distance };
+					}
+				}
+				continue;
+			}
+
+			// Push the further child first, so the closer one is searched first and tightens the bound.
+			const std::uint32_t left = node.FirstChildOrPrimitive;
+			const T leftDistance = myNodes[left].Bounds().DistanceSquared(aPoint);
+			const T rightDistance = myNodes[left + 1].Bounds().DistanceSquared(aPoint);
+
+			if (leftDistance < rightDistance)
+			{
+				stack[stackSize++] = left + 1;
+				stack[stackSize++] = left;
+			}
+			else
+			{
+				stack[stackSize++] = left;
+				stack[stackSize++] = left + 1;
+			}
+		}
+
+		return closest;
+	}
+
+	template <typename T>
+	template <typename Callback>
+	void BoundingVolumeHierarchy<T>::Overlap(const AxisAlignedBox<T>& aBox, Callback&& aCallback) const
+	{
+		if (myNodes.empty())
+			return;
+
+		std::array<std::uint32_t, MaxDepth> stack;
+		std::size_t stackSize = 0;
+		stack[stackSize++] = 0;
+
+		while (stackSize > 0)
+		{
+			const Node& node = myNodes[stack[--stackSize]];
+			if (!aBox.Intersects(node.Bounds()))
+				continue;
+
+			if (node.IsLeaf())
+			{
+				for (std::uint32_t p = node.FirstChildOrPrimitive; p < node.FirstChildOrPrimitive + node.PrimitiveCount; ++p)
+					aCallback(myPrimitiveIndices[p]);
+			}
+			else
+			{
+				stack[stackSize++] = node.FirstChildOrPrimitive + 1;
+				stack[stackSize++] = node.FirstChildOrPrimitive;
+			}
+		}
+	}
+
+	template <typename T>
+	template <typename HitFunction>
+	std::optional<typename BoundingVolumeHierarchy<T>::Hit> BoundingVolumeHierarchy<T>::Raycast(const Vector3<T>& anOrigin, const Vector3<T>& aDirection, T aMaxDistance, HitFunction&& aHitFunction) const
+	{
+		if (myNodes.empty())
+			return { };
+
+		const Vector3<T> inverseDirection(
+			Math::Reciprocal(aDirection.X),
+			Math::Reciprocal(aDirection.Y),
+			Math::Reciprocal(aDirection.Z)
+		);
+
+		std::optional<Hit> closest;
+		T closestDistance = aMaxDistance;
+
+		const std::optional<T> rootEntry = IntersectNode(myNodes.front(), anOrigin, inverseDirection, closestDistance);
+		if (!rootEntry.has_value())
+			return { };
+
+		// Nodes keep the distance the ray enters them at, so ones pushed before a closer hit was found can be skipped once they're popped.
+		struct StackEntry
+		{
+			std::uint32_t NodeIndex;
+			T Entry;
+		};
+
+		std::array<StackEntry, MaxDepth> stack;
+		std::size_t stackSize = 0;
+		stack[stackSize++] = StackEntry{ 0, rootEntry.value() };
+
+		while (stackSize > 0)
+		{
+			const StackEntry entry = stack[--stackSize];
+			if (entry.Entry > closestDistance)
+				continue;
+
+			const Node& node = myNodes[entry.NodeIndex];
+
+			if (node.IsLeaf())
+			{
+				for (std::uint32_t p = node.FirstChildOrPrimitive; p < node.FirstChildOrPrimitive + node.PrimitiveCount; ++p)
+				{
+					const std::uint32_t primitive = myPrimitiveIndices[p];
+					const std::optional<T> distance = aHitFunction(primitive, closestDistance);
+					if (distance.has_value() && distance.value() <= closestDistance)
+					{
+						closestDistance = distance.value();
+						closest = Hit{ primitive, closestDistance };
+					}
+				}
+				continue;
+			}
+
+			const std::uint32_t left = node.FirstChildOrPrimitive;
+			const std::optional<T> leftEntry = IntersectNode(myNodes[left], anOrigin, inverseDirection, closestDistance);
+			const std::optional<T> rightEntry = IntersectNode(myNodes[left + 1], anOrigin, inverseDirection, closestDistance);
+
+			if (leftEntry.has_value() && rightEntry.has_value())
+			{
+				// Visit the nearer child first.
+				const bool leftIsNearer = leftEntry.value() <= rightEntry.value();
+				stack[stackSize++] = leftIsNearer ? StackEntry{ left + 1, rightEntry.value() } : StackEntry{ left, leftEntry.value() };
+				stack[stackSize++] = leftIsNearer ? StackEntry{ left, leftEntry.value() } : StackEntry{ left + 1, rightEntry.value() };
+			}
+			else if (leftEntry.has_value())
+			{
+				stack[stackSize++] = StackEntry{ left, leftEntry.value() };
+			}
+			else if (rightEntry.has_value())
+			{
+				stack[stackSize++] = StackEntry{ left + 1, rightEntry.value() };
+			}
+		}
+
+		return closest;
+	}
+
+	template <typename T>
+	std::optional<T> BoundingVolumeHierarchy<T>::IntersectNode(const Node& aNode, const Vector3<T>& anOrigin, const Vector3<T>& anInverseDirection, T aMaxDistance)
+	{
+		const Vector3<T> nearPlanes = (aNode.Min - anOrigin) * anInverseDirection;
+		const Vector3<T> farPlanes = (aNode.Max - anOrigin) * anInverseDirection;
+
+		const Vector3<T> entries = Vector3<T>::Min(nearPlanes, farPlanes);
+		const Vector3<T> exits = Vector3<T>::Max(nearPlanes, farPlanes);
+
+		const T entry = Math::Max<T>(Math::Max<T>(entries.X, entries.Y), Math::Max<T>(entries.Z, T(0)));
+		const T exit = Math::Min<T>(Math::Min<T>(exits.X, exits.Y), Math::Min<T>(exits.Z, aMaxDistance));
+
+		if (entry > exit)
+			return { };
+
+		return entry;
+	}
+}
@@ -1,11 +1,24 @@
 #pragma once
 
+#include "Determinism.hpp"
+
+#include <bit>
+#include <cmath>
+#include <cstdint>
 #include <exception>
 #include <limits>
 #include <type_traits>
+#include <utility>
 
 namespace RoseCommon::Math
 {
+	/**
+	 * @brief Whether a number type holds fractions, which things like matrix inversion and rotations need.
+	 *        Custom number types, such as fixed-point numbers, specialize this.
+	 */
+	template <typename T>
+	inline constexpr bool IsFractional = std::is_floating_point_v<T>;
+
 	/**
 	 * @brief Get the absolute value of a specified value.
 	 * @tparam T The type of the parameter and returned value.
@@ -183,6 +196,7 @@ namespace RoseCommon::Math
 
 	/**
 	 * @brief Calculate the square root of a specified value.
+	 *        Single and double precision results are correctly rounded, and identical between compile-time and run-time evaluation.
 	 * @tparam T The type of the parameter and returned value.
 	 * @param aValue The number whose square root is to be found.
 	 * @return The square root of the input value.
@@ -241,13 +255,29 @@ namespace RoseCommon::Math
 
 namespace RoseCommon::Math
 {
+	namespace _impl
+	{
+		/**
+		 * @brief Lets a number type which is neither an integer nor a floating-point type, such as a fixed-point type, provide its own
+		 *        implementation of functions whose generic versions assume one of those.
+		 *        Specializations can define any of the static functions Ceiling(), Floor(), Modulo(), Round(), Truncate(), Squareroot(),
+		 *        Sine() and Cosine(), which are then used instead.
+		 */
+		template <typename T>
+		struct NumberTraits { };
+	}
+
 	template <typename T>
 	constexpr T Abs(T aValue) { return aValue < static_cast<T>(0) ? -aValue : aValue; }
 
 	template <typename T>
 	constexpr T Ceiling(T aValue)
 	{
-		if constexpr (!std::is_floating_point_v<T>)
+		if constexpr (requires { _impl::NumberTraits<T>::Ceiling(aValue); })
+		{
+			return _impl::NumberTraits<T>::Ceiling(aValue);
+		}
+		else if constexpr (!std::is_floating_point_v<T>)
 		{
 			return aValue;
 		}
@@ -294,7 +324,11 @@ namespace RoseCommon::Math
 	template <typename T>
 	constexpr T Floor(T aValue)
 	{
-		if constexpr (!std::is_floating_point_v<T>)
+		if constexpr (requires { _impl::NumberTraits<T>::Floor(aValue); })
+		{
+			return _impl::NumberTraits<T>::Floor(aValue);
+		}
+		else if constexpr (!std::is_floating_point_v<T>)
 		{
 			return aValue;
 		}
@@ -354,7 +388,11 @@ namespace RoseCommon::Math
 	template <typename T>
 	constexpr T Modulo(T aDividend, T aDivisor)
 	{
-		if constexpr (std::is_integral_v<T>)
+		if constexpr (requires { _impl::NumberTraits<T>::Modulo(aDividend, aDivisor); })
+		{
+			return _impl::NumberTraits<T>::Modulo(aDividend, aDivisor);
+		}
+		else if constexpr (std::is_integral_v<T>)
 		{
 			return (aDividend % aDivisor + aDivisor) % aDivisor;
 		}
@@ -372,7 +410,11 @@ namespace RoseCommon::Math
 		// If other rounding types are useful, each should split into their own function,
 		// and Round() should inline-call RoundUpFromHalf().
 
-		if constexpr (!std::is_floating_point_v<T>)
+		if constexpr (requires { _impl::NumberTraits<T>::Round(aValue); })
+		{
+			return _impl::NumberTraits<T>::Round(aValue);
+		}
+		else if constexpr (!std::is_floating_point_v<T>)
 		{
 			return aValue;
 		}
@@ -410,15 +452,91 @@ namespace RoseCommon::Math
 		{
 			return sqrt_impl1(aValue, aValue > 1 ? aValue : T(1));
 		}
+
+		template <typename T>
+		constexpr bool IsBinary32Or64 = std::numeric_limits<T>::is_iec559 && (sizeof(T) == sizeof(std::uint32_t) || sizeof(T) == sizeof(std::uint64_t));
+
+		// The difference between a value and the square of an estimate of its root, using Dekker's exact product for the square.
+		template <typename T>
+		constexpr T SquarerootError(T aValue, T anEstimate)
+		{
+			constexpr T splitter = static_cast<T>((std::uint64_t(1) << ((std::numeric_limits<T>::digits + 1) / 2)) + 1);
+			const T scaled = splitter * anEstimate;
+			const T high = scaled - (scaled - anEstimate);
+			const T low = anEstimate - high;
+
+			const T square = anEstimate * anEstimate;
+			const T squareError = ((high * high - square) + T(2) * high * low) + low * low;
+			return Abs((aValue - square) - squareError);
+		}
+
+		// Round a close square root estimate correctly, by picking whichever of it and its neighbours squares closest to the value.
+		// Square roots never fall close enough to the midpoint between two neighbours for the nearest square to pick the wrong one.
+		template <typename T>
+		constexpr T RoundSquareroot(T aValue, T anEstimate)
+		{
+			using Bits = std::conditional_t<sizeof(T) == sizeof(std::uint32_t), std::uint32_t, std::uint64_t>;
+			const Bits bits = std::bit_cast<Bits>(anEstimate);
+
+			T root = anEstimate;
+			T error = SquarerootError(aValue, anEstimate);
+			for (const T neighbour : { std::bit_cast<T>(bits - 1), std::bit_cast<T>(bits + 1) })
+			{
+				const T neighbourError = SquarerootError(aValue, neighbour);
+				if (neighbourError < error)
+				{
+					root = neighbour;
+					error = neighbourError;
+				}
+			}
+
+			return root;
+		}
 	}
 
 	template <typename T>
 	constexpr T Squareroot(T aValue)
 	{
-		if (aValue != T(0))
-			return _impl::sqrt_impl(aValue);
+		if constexpr (requires { _impl::NumberTraits<T>::Squareroot(aValue); })
+		{
+			return _impl::NumberTraits<T>::Squareroot(aValue);
+		}
+		else if constexpr (_impl::IsBinary32Or64<T>)
+		{
+			// IEEE 754 requires correctly rounded square roots, so the standard library gives the same result on every platform.
+			if (!std::is_constant_evaluated())
+				return std::sqrt(aValue);
+
+			if (aValue < T(0) || aValue != aValue)
+				return std::numeric_limits<T>::quiet_NaN();
+			if (aValue == T(0) || aValue == std::numeric_limits<T>::infinity())
+				return aValue;
+
+			// Scale into a moderate range by even powers of two first, so the exact square doesn't lose bits to underflow,
+			// and the iteration doesn't need many steps to converge.
+			constexpr T valueStep = static_cast<T>(std::uint64_t(1) << 32);
+			constexpr T rootStep = static_cast<T>(std::uint64_t(1) << 16);
+			T rootScale = T(1);
+			while (aValue < T(1))
+			{
+				aValue *= valueStep;
+				rootScale /= rootStep;
+			}
+			while (aValue > valueStep)
+			{
+				aValue /= valueStep;
+				rootScale *= rootStep;
+			}
+
+			return _impl::RoundSquareroot(aValue, _impl::sqrt_impl(aValue)) * rootScale;
+		}
 		else
-			return T(0);
+		{
+			if (aValue != T(0))
+				return _impl::sqrt_impl(aValue);
+			else
+				return T(0);
+		}
 	}
 
 	template <typename T>
@@ -436,7 +554,11 @@ namespace RoseCommon::Math
 	template <typename T>
 	constexpr T Truncate(T aValue)
 	{
-		if constexpr (!std::is_floating_point_v<T>)
+		if constexpr (requires { _impl::NumberTraits<T>::Truncate(aValue); })
+		{
+			return _impl::NumberTraits<T>::Truncate(aValue);
+		}
+		else if constexpr (!std::is_floating_point_v<T>)
 		{
 			return aValue;
 		}
@@ -3,6 +3,8 @@
 #include "Common.hpp"
 #include "Constants.hpp"
 
+#include <type_traits>
+
 namespace RoseCommon::Math
 {
 	// Functions ported from https://github.com/FNA-XNA/FNA/blob/master/src/MathHelper.cs
@@ -44,6 +46,13 @@ namespace RoseCommon::Math
 
 namespace RoseCommon::Math
 {
+	namespace _impl
+	{
+		// The type the curve functions calculate in, being at least double precision.
+		template <typename T>
+		using CurvePrecision = std::common_type_t<T, double>;
+	}
+
 	template <typename T>
 	constexpr T Barycentric(T aValue1, T aValue2, T aValue3, T anAmount1, T anAmount2)
 	{
@@ -54,16 +63,19 @@ namespace RoseCommon::Math
 	constexpr T CatmullRom(T aValue1, T aValue2, T aValue3, T aValue4, T anAmount)
 	{
 		/* Using formula from http://www.mvps.org/directx/articles/catmull/
-		 * Internally using doubles not to lose precision.
+		 * Internally using at least doubles not to lose precision, converting every input before any arithmetic
+		 * so that no part of the formula is evaluated at a different precision than the rest.
 		 */
-		const double anAmountSquared = anAmount * anAmount;
-		const double anAmountCubed = anAmountSquared * anAmount;
+		using U = _impl::CurvePrecision<T>;
+		const U v1 = aValue1, v2 = aValue2, v3 = aValue3, v4 = aValue4, s = anAmount;
+		const U sSquared = s * s;
+		const U sCubed = sSquared * s;
 		return static_cast<T>(
-			0.5 *
+			U(0.5) *
 			(
-				((2.0 * aValue2 + (aValue3 - aValue1) * anAmount) +
-					((2.0 * aValue1 - 5.0 * aValue2 + 4.0 * aValue3 - aValue4) * anAmountSquared) +
-					(3.0 * aValue2 - aValue1 - 3.0 * aValue3 + aValue4) * anAmountCubed)
+				((U(2) * v2 + (v3 - v1) * s) +
+					((U(2) * v1 - U(5) * v2 + U(4) * v3 - v4) * sSquared) +
+					(U(3) * v2 - v1 - U(3) * v3 + v4) * sCubed)
 				)
 			);
 	}
@@ -71,15 +83,16 @@ namespace RoseCommon::Math
 	template <typename T>
 	constexpr T Hermite(T aValue1, T aTangent1, T aValue2, T aTangent2, T anAmount)
 	{
-		/* All transformed to double not to lose precision
+		/* All transformed to at least double not to lose precision
 		 * Otherwise, for high numbers of param:anAmount the result is NaN instead
 		 * of Infinity.
 		 */
-		const double v1 = aValue1, v2 = aValue2, t1 = aTangent1, t2 = aTangent2, s = anAmount;
-		const double sCubed = s * s * s;
-		const double sSquared = s * s;
+		using U = _impl::CurvePrecision<T>;
+		const U v1 = aValue1, v2 = aValue2, t1 = aTangent1, t2 = aTangent2, s = anAmount;
+		const U sCubed = s * s * s;
+		const U sSquared = s * s;
 
-		double result;
+		U result;
 		if (Math::IsZero(anAmount))
 		{
 			result = aValue1;
@@ -91,8 +104,8 @@ namespace RoseCommon::Math
 		else
 		{
 			result = (
-				((2 * v1 - 2 * v2 + t2 + t1) * sCubed) +
-				((3 * v2 - 3 * v1 - 2 * t1 - t2) * sSquared) +
+				((U(2) * v1 - U(2) * v2 + t2 + t1) * sCubed) +
+				((U(3) * v2 - U(3) * v1 - U(2) * t1 - t2) * sSquared) +
 				(t1 * s) +
 				v1
 				);
@@ -0,0 +1,44 @@
+#pragma once
+
+#include <cfloat>
+
+/*
+ * Deterministic floating-point mode.
+ *
+ * Define ROSECOMMON_MATH_DETERMINISTIC in every translation unit, for builds that need bit-identical results across machines,
+ * such as lockstep simulations. The math library is written for this to hold:
+ * - Functions like Sine(), ArcTangent() and Squareroot() are fixed sequences of basic operations, or correctly rounded, rather than calls into
+ *   platform math libraries which differ between vendors.
+ * - Intermediate values are kept in the component type, or in an explicitly chosen wider type, with no literals silently changing precision.
+ * - The SIMD paths only use exactly rounded instructions (no reciprocal or square root estimates, no fused multiply-add) and give the
+ *   same results as the scalar paths. Reductions use a fixed order regardless of the pack width or thread count.
+ *
+ * What the library can't control on its own is how the compiler evaluates expressions. In this mode it:
+ * - Rejects targets which evaluate floats with excess precision, such as 32-bit x87 code.
+ * - Rejects fast-math builds, which allow reordering operations.
+ * - Disables contraction of multiplies and adds into fused multiply-adds, with a pragma on each compiler.
+ *   It applies to the rest of the translation unit too, which calling code in this mode wants as well.
+ *   GCC contracts C++ by default in every language mode, whenever the target has FMA instructions. Its pragma only covers functions
+ *   defined after it, so code before the first include of the library, and anything inlined into it, can still be contracted.
+ *   Build with -ffp-contract=off on GCC to cover everything.
+ */
+
+#if defined(ROSECOMMON_MATH_DETERMINISTIC)
+
+	#if defined(FLT_EVAL_METHOD) && FLT_EVAL_METHOD != 0
+		#error "ROSECOMMON_MATH_DETERMINISTIC requires floating-point evaluation without excess precision, such as with SSE2."
+	#endif
+
+	#if defined(__FAST_MATH__) || defined(_M_FP_FAST)
+		#error "ROSECOMMON_MATH_DETERMINISTIC can't be combined with fast-math."
+	#endif
+
+	#if defined(__clang__)
+		#pragma STDC FP_CONTRACT OFF
+	#elif defined(__GNUC__)
+		#pragma GCC optimize("fp-contract=off")
+	#elif defined(_MSC_VER)
+		#pragma fp_contract(off)
+	#endif
+
+#endif
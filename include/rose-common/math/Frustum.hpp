@@ -0,0 +1,259 @@
+#pragma once
+
+#include "AxisAlignedBox.hpp"
+#include "Matrix3D.hpp"
+#include "Vector.hpp"
+
+#include "../Simd.hpp"
+
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <span>
+#include <stdexcept>
+
+namespace RoseCommon::Math
+{
+	/**
+	 * @brief A view volume bounded by six planes, for culling shapes which cannot be seen.
+	 *        Batch tests write their results as bitmasks, see Simd::GetMaskWordCount() for the required mask size.
+	 * @tparam T A type for each component. Single-precision floats use SSE/AVX when available.
+	 */
+	template <typename T>
+	class Frustum
+	{
+	public:
+
+		//--------------------------------------------------
+		// * Types
+		//--------------------------------------------------
+		#pragma region Types
+
+		using ComponentType = T;
+
+		/**
+		 * @brief The index of each plane of the frustum.
+		 */
+		enum class Side : std::uint8_t
+		{
+			Left,
+			Right,
+			Bottom,
+			Top,
+			Near,
+			Far
+		};
+
+		#pragma endregion
+
+		//--------------------------------------------------
+		// * Static constants
+		//--------------------------------------------------
+		#pragma region Static constants
+
+		static constexpr std::size_t PlaneCount = 6;
+
+		#pragma endregion
+
+		//--------------------------------------------------
+		// * Construction
+		//--------------------------------------------------
+		#pragma region Construction
+
+		/**
+		 * @brief Initialize to a frustum which contains everything.
+		 */
+		constexpr Frustum() = default;
+
+		/**
+		 * @brief Initialize by extracting the planes of a view-projection matrix.
+		 *        Expects the conventions of Matrix3D::CreatePerspectiveFieldOfView(), with row vectors and depth in range 0 - 1.
+		 * @param aViewProjection The view matrix multiplied by the projection matrix. With only a projection matrix, the frustum is in view space.
+		 */
+		constexpr explicit Frustum(const Matrix3D<T>& aViewProjection);
+
+		#pragma endregion
+
+		//--------------------------------------------------
+		// * Properties
+		//--------------------------------------------------
+		#pragma region Properties
+
+		/**
+		 * @brief Get one of the planes, stored as (Normal.X, Normal.Y, Normal.Z, Distance) with a unit-length normal pointing inwards.
+		 * @param aSide The side of the frustum to get the plane of.
+		 */
+		constexpr const Vector4<T>& GetPlane(Side aSide) const { return myPlanes[static_cast<std::size_t>(aSide)]; }
+
+		/**
+		 * @brief Get all the planes, in the order of Side.
+		 */
+		constexpr std::span<const Vector4<T>, PlaneCount> GetPlanes() const { return myPlanes; }
+
+		#pragma endregion
+
+		//--------------------------------------------------
+		// * Methods
+		//--------------------------------------------------
+		#pragma region Methods
+
+		/**
+		 * @brief Check whether the frustum contains a specific point. Points on a plane are considered contained.
+		 * @param aPoint A point to check.
+		 * @return Whether the given point is contained within.
+		 */
+		constexpr bool Contains(const Vector3<T>& aPoint) const;
+
+		/**
+		 * @brief Check whether a box is at least partially inside the frustum.
+		 *        Like all plane-based culling, boxes near the frustum corners can be reported as intersecting without actually doing so.
+		 * @param aBox A box to check.
+		 * @return Whether the box may be visible.
+		 */
+		constexpr bool Intersects(const AxisAlignedBox<T>& aBox) const;
+
+		/**
+		 * @brief Check whether a sphere is at least partially inside the frustum.
+		 *        Like all plane-based culling, spheres near the frustum corners can be reported as intersecting without actually doing so.
+		 * @param aCenter The center of the sphere.
+		 * @param aRadius The radius of the sphere.
+		 * @return Whether the sphere may be visible.
+		 */
+		constexpr bool Intersects(const Vector3<T>& aCenter, T aRadius) const;
+
+		/**
+		 * @brief Test which boxes are at least partially inside the frustum.
+		 * @param someBoxes The boxes to test.
+		 * @param someResultMasks The bitmask to write the results to.
+		 * @param someHints Optional plane index per box, which remembers the plane that last rejected a box and tests it first on the next call.
+		 *                  Keeping these between frames makes boxes which stay outside the view cheaper to reject, when neighbouring boxes are close in space.
+		 *                  Only the hint of the first box of each SIMD pack is used. Zero-initialize before first use.
+		 */
+		void Intersects(const AxisAlignedBoxBatch<T>& someBoxes, std::span<std::uint64_t> someResultMasks, std::span<std::uint8_t> someHints = {}) const;
+
+		/**
+		 * @brief Test which spheres, stored as a structure of arrays, are at least partially inside the frustum.
+		 * @param someCenterXs The X coordinate of each sphere center.
+		 * @param someCenterYs The Y coordinate of each sphere center.
+		 * @param someCenterZs The Z coordinate of each sphere center.
+		 * @param someRadii The radius of each sphere.
+		 * @param someResultMasks The bitmask to write the results to.
+		 * @param someHints Optional plane index per sphere, which remembers the plane that last rejected a sphere and tests it first on the next call.
+		 *                  Keeping these between frames makes spheres which stay outside the view cheaper to reject, when neighbouring spheres are close in space.
+		 *                  Only the hint of the first sphere of each SIMD pack is used. Zero-initialize before first use.
+		 */
+		void IntersectsSpheres(std::span<const T> someCenterXs, std::span<const T> someCenterYs, std::span<const T> someCenterZs, std::span<const T> someRadii, std::span<std::uint64_t> someResultMasks, std::span<std::uint8_t> someHints = {}) const;
+
+		#pragma endregion
+
+	private:
+		std::array<Vector4<T>, PlaneCount> myPlanes;
+	};
+}
+
+namespace RoseCommon::Math
+{
+	template <typename T>
+	constexpr Frustum<T>::Frustum(const Matrix3D<T>& aViewProjection)
+	{
+		// Each clip-space bound, such as -w <= x, is a plane in the space the matrix transforms from (Gribb & Hartmann).
+		const auto column = [&aViewProjection](std::size_t aColumn)
+		{
+			return Vector4<T>(
+				aViewProjection.GetCell(aColumn, 0),
+				aViewProjection.GetCell(aColumn, 1),
+				aViewProjection.GetCell(aColumn, 2),
+				aViewProjection.GetCell(aColumn, 3)
+			);
+		};
+
+		const Vector4<T> x = column(0), y = column(1), z = column(2), w = column(3);
+
+		myPlanes[static_cast<std::size_t>(Side::Left)] = w + x;
+		myPlanes[static_cast<std::size_t>(Side::Right)] = w - x;
+		myPlanes[static_cast<std::size_t>(Side::Bottom)] = w + y;
+		myPlanes[static_cast<std::size_t>(Side::Top)] = w - y;
+		myPlanes[static_cast<std::size_t>(Side::Near)] = z;
+		myPlanes[static_cast<std::size_t>(Side::Far)] = w - z;
+
+		for (Vector4<T>& plane : myPlanes)
+		{
+			const T length = static_cast<T>(std::sqrt(plane.X * plane.X + plane.Y * plane.Y + plane.Z * plane.Z));
+			if (length > T(0))
+				plane = plane / Vector4<T>(length);
+		}
+	}
+
+	template <typename T>
+	constexpr bool Frustum<T>::Contains(const Vector3<T>& aPoint) const
+	{
+		for (const Vector4<T>& plane : myPlanes)
+		{
+			if (plane.X * aPoint.X + plane.Y * aPoint.Y + plane.Z * aPoint.Z + plane.W < T(0))
+				return false;
+		}
+
+		return true;
+	}
+
+	template <typename T>
+	constexpr bool Frustum<T>::Intersects(const AxisAlignedBox<T>& aBox) const
+	{
+		const Vector3<T> center = aBox.Center();
+		const Vector3<T> extents = aBox.Extents();
+
+		for (const Vector4<T>& plane : myPlanes)
+		{
+			const T distance = plane.X * center.X + plane.Y * center.Y + plane.Z * center.Z + plane.W;
+			const T radius = Math::Abs(plane.X) * extents.X + Math::Abs(plane.Y) * extents.Y + Math::Abs(plane.Z) * extents.Z;
+			if (distance + radius < T(0))
+				return false;
+		}
+
+		return true;
+	}
+
+	template <typename T>
+	constexpr bool Frustum<T>::Intersects(const Vector3<T>& aCenter, T aRadius) const
+	{
+		for (const Vector4<T>& plane : myPlanes)
+		{
+			if (plane.X * aCenter.X + plane.Y * aCenter.Y + plane.Z * aCenter.Z + plane.W < -aRadius)
+				return false;
+		}
+
+		return true;
+	}
+
+	template <typename T>
+	void Frustum<T>::Intersects(const AxisAlignedBoxBatch<T>& someBoxes, std::span<std::uint64_t> someResultMasks, std::span<std::uint8_t> someHints) const
+	{
+		someBoxes.IntersectsPlanes(myPlanes, someResultMasks, someHints);
+	}
+
+	template <typename T>
+	void Frustum<T>::IntersectsSpheres(std::span<const T> someCenterXs, std::span<const T> someCenterYs, std::span<const T> someCenterZs, std::span<const T> someRadii, std::span<std::uint64_t> someResultMasks, std::span<std::uint8_t> someHints) const
+	{
+		const std::size_t count = someCenterXs.size();
+		if (someCenterYs.size() != count || someCenterZs.size() != count || someRadii.size() != count)
+			throw std::invalid_argument("Sphere coordinate and radius spans need to be the same size.");
+
+		Simd::ClearMask(someResultMasks, count);
+
+		Simd::ForEachPack<T>(count, [&]<typename Pack>(std::size_t anIndex)
+		{
+			const Pack centerX = Pack::Load(&someCenterXs[anIndex]);
+			const Pack centerY = Pack::Load(&someCenterYs[anIndex]);
+			const Pack centerZ = Pack::Load(&someCenterZs[anIndex]);
+			const Pack negativeRadius = -Pack::Load(&someRadii[anIndex]);
+
+			const auto result = _impl::IntersectsPlanes<Pack>(std::span<const Vector4<T>>(myPlanes), someHints, anIndex, [&](const Vector4<T>& aPlane)
+			{
+				const Pack distance = Pack::Broadcast(aPlane.X) * centerX + Pack::Broadcast(aPlane.Y) * centerY + Pack::Broadcast(aPlane.Z) * centerZ + Pack::Broadcast(aPlane.W);
+				return distance >= negativeRadius;
+			});
+
+			Simd::WriteMaskBits(someResultMasks, anIndex, result.MoveMask());
+		});
+	}
+}
@@ -3,7 +3,12 @@
 #include "Matrix.hpp"
 #include "Vector.hpp"
 
+#include "../Simd.hpp"
+
+#include <cstdint>
 #include <optional>
+#include <span>
+#include <vector>
 
 namespace RoseCommon::Math
 {
@@ -277,6 +282,13 @@ namespace RoseCommon::Math
 		//--------------------------------------------------
 		#pragma region Methods
 
+		/**
+		 * @brief Find the point on or within the rectangle which is closest to the specified point.
+		 * @param aPoint A point to find the closest point to.
+		 * @return The closest point.
+		 */
+		constexpr Point<T> ClosestPoint(const Point<T>& aPoint) const;
+
 		/**
 		 * @brief Check whether the rectangle contains a specific point.
 		 * @param aPoint A point to check.
@@ -291,6 +303,13 @@ namespace RoseCommon::Math
 		 */
 		constexpr bool Contains(const Rectangle<T>& aRectangle) const;
 
+		/**
+		 * @brief Calculate the squared distance from the rectangle to a point.
+		 * @param aPoint A point to measure the distance to.
+		 * @return The squared distance, or zero if the point is contained within.
+		 */
+		constexpr T DistanceSquared(const Point<T>& aPoint) const;
+
 		/**
 		 * @brief Expand or shrink the rectangle by the specified width and height, in each direction.
 		 * @param aWidth An amount by which to expand the left and right sides of the rectangle.
@@ -354,6 +373,125 @@ namespace RoseCommon::Math
 
 		#pragma endregion
 	};
+
+	/**
+	 * @brief A structure-of-arrays collection of rectangles, for testing one shape against many rectangles at a time.
+	 *        Results are written as bitmasks, see Simd::GetMaskWordCount() for the required mask size.
+	 * @tparam T A type for each component. Single-precision floats use SSE/AVX when available.
+	 */
+	template <typename T>
+	class RectangleBatch
+	{
+	public:
+
+		//--------------------------------------------------
+		// * Construction
+		//--------------------------------------------------
+		#pragma region Construction
+
+		/**
+		 * @brief Initialize an empty batch.
+		 */
+		RectangleBatch() = default;
+
+		/**
+		 * @brief Initialize with a copy of the specified rectangles.
+		 * @param someRectangles The rectangles to add.
+		 */
+		explicit RectangleBatch(std::span<const Rectangle<T>> someRectangles);
+
+		#pragma endregion
+
+		//--------------------------------------------------
+		// * Properties
+		//--------------------------------------------------
+		#pragma region Properties
+
+		/**
+		 * @brief Get the number of rectangles in the batch.
+		 */
+		std::size_t Size() const { return myLeft.size(); }
+
+		/**
+		 * @brief Get a rectangle from the batch.
+		 * @param anIndex The index of the rectangle.
+		 * @return A copy of the rectangle.
+		 */
+		Rectangle<T> Get(std::size_t anIndex) const;
+
+		/**
+		 * @brief Replace a rectangle in the batch.
+		 * @param anIndex The index of the rectangle.
+		 * @param aRectangle The new rectangle value.
+		 */
+		void Set(std::size_t anIndex, const Rectangle<T>& aRectangle);
+
+		#pragma endregion
+
+		//--------------------------------------------------
+		// * Methods
+		//--------------------------------------------------
+		#pragma region Methods
+
+		/**
+		 * @brief Add a rectangle to the end of the batch.
+		 * @param aRectangle The rectangle to add.
+		 */
+		void Add(const Rectangle<T>& aRectangle);
+
+		/**
+		 * @brief Remove all rectangles from the batch.
+		 */
+		void Clear();
+
+		/**
+		 * @brief Reserve memory for a number of rectangles.
+		 * @param aCount The number of rectangles to reserve memory for.
+		 */
+		void Reserve(std::size_t aCount);
+
+		/**
+		 * @brief Test which rectangles are entirely contained within the specified rectangle.
+		 * @param aRectangle The containing rectangle.
+		 * @param someResultMasks The bitmask to write the results to.
+		 */
+		void ContainedBy(const Rectangle<T>& aRectangle, std::span<std::uint64_t> someResultMasks) const;
+
+		/**
+		 * @brief Test which rectangles contain the specified point.
+		 * @param aPoint The point to test.
+		 * @param someResultMasks The bitmask to write the results to.
+		 */
+		void Contains(const Point<T>& aPoint, std::span<std::uint64_t> someResultMasks) const;
+
+		/**
+		 * @brief Test which rectangles entirely contain the specified rectangle.
+		 * @param aRectangle The rectangle to test.
+		 * @param someResultMasks The bitmask to write the results to.
+		 */
+		void Contains(const Rectangle<T>& aRectangle, std::span<std::uint64_t> someResultMasks) const;
+
+		/**
+		 * @brief Find the intersection of each rectangle with the specified rectangle.
+		 * @param aRectangle The rectangle to intersect with.
+		 * @param outIntersections A batch which is resized to match, receiving the intersection of each rectangle. Rectangles without any are left inverted or empty.
+		 * @param someResultMasks The bitmask to write which rectangles have an intersection area to.
+		 */
+		void Intersection(const Rectangle<T>& aRectangle, RectangleBatch& outIntersections, std::span<std::uint64_t> someResultMasks) const;
+
+		/**
+		 * @brief Test which rectangles intersect the specified rectangle. Rectangles which only touch are not considered intersecting.
+		 * @param aRectangle The rectangle to test.
+		 * @param someResultMasks The bitmask to write the results to.
+		 */
+		void IntersectsWith(const Rectangle<T>& aRectangle, std::span<std::uint64_t> someResultMasks) const;
+
+		#pragma endregion
+
+	private:
+		std::vector<T> myLeft, myTop;
+		std::vector<T> myRight, myBottom;
+	};
 }
 
 namespace RoseCommon::Math
@@ -574,6 +712,15 @@ namespace RoseCommon::Math
 		return Point<T>(Right(), Top());
 	}
 
+	template<typename T>
+	constexpr Point<T> Rectangle<T>::ClosestPoint(const Point<T>& aPoint) const
+	{
+		return Point<T>(
+			Math::Clamp<T>(aPoint.X, Left(), Right()),
+			Math::Clamp<T>(aPoint.Y, Top(), Bottom())
+		);
+	}
+
 	template<typename T>
 	constexpr bool Rectangle<T>::Contains(const Point<T>& aPoint) const
 	{
@@ -592,6 +739,12 @@ namespace RoseCommon::Math
 			;
 	}
 
+	template<typename T>
+	constexpr T Rectangle<T>::DistanceSquared(const Point<T>& aPoint) const
+	{
+		return (ClosestPoint(aPoint) - aPoint).LengthSquared();
+	}
+
 	template <typename T>
 	void Rectangle<T>::Inflate(T aWidth, T aHeight)
 	{
@@ -661,4 +814,146 @@ namespace RoseCommon::Math
 		Width = Math::Max<T>(X + Width, aRectangle.X + aRectangle.Width) - X;
 		Height = Math::Max<T>(Y + Height, aRectangle.Y + aRectangle.Height) - Y;
 	}
+
+	template <typename T>
+	RectangleBatch<T>::RectangleBatch(std::span<const Rectangle<T>> someRectangles)
+	{
+		Reserve(someRectangles.size());
+		for (const Rectangle<T>& rectangle : someRectangles)
+			Add(rectangle);
+	}
+
+	template <typename T>
+	Rectangle<T> RectangleBatch<T>::Get(std::size_t anIndex) const
+	{
+		return Rectangle<T>(
+			Point<T>(myLeft[anIndex], myTop[anIndex]),
+			Math::Size<T>(myRight[anIndex] - myLeft[anIndex], myBottom[anIndex] - myTop[anIndex])
+		);
+	}
+
+	template <typename T>
+	void RectangleBatch<T>::Set(std::size_t anIndex, const Rectangle<T>& aRectangle)
+	{
+		myLeft[anIndex] = aRectangle.Left();
+		myTop[anIndex] = aRectangle.Top();
+		myRight[anIndex] = aRectangle.Right();
+		myBottom[anIndex] = aRectangle.Bottom();
+	}
+
+	template <typename T>
+	void RectangleBatch<T>::Add(const Rectangle<T>& aRectangle)
+	{
+		myLeft.push_back(aRectangle.Left());
+		myTop.push_back(aRectangle.Top());
+		myRight.push_back(aRectangle.Right());
+		myBottom.push_back(aRectangle.Bottom());
+	}
+
+	template <typename T>
+	void RectangleBatch<T>::Clear()
+	{
+		myLeft.clear();
+		myTop.clear();
+		myRight.clear();
+		myBottom.clear();
+	}
+
+	template <typename T>
+	void RectangleBatch<T>::Reserve(std::size_t aCount)
+	{
+		myLeft.reserve(aCount);
+		myTop.reserve(aCount);
+		myRight.reserve(aCount);
+		myBottom.reserve(aCount);
+	}
+
+	template <typename T>
+	void RectangleBatch<T>::ContainedBy(const Rectangle<T>& aRectangle, std::span<std::uint64_t> someResultMasks) const
+	{
+		Simd::ClearMask(someResultMasks, Size());
+
+		Simd::ForEachPack<T>(Size(), [&]<typename Pack>(std::size_t anIndex)
+		{
+			const auto result =
+				(Pack::Broadcast(aRectangle.Left()) <= Pack::Load(&myLeft[anIndex])) & (Pack::Load(&myRight[anIndex]) <= Pack::Broadcast(aRectangle.Right())) &
+				(Pack::Broadcast(aRectangle.Top()) <= Pack::Load(&myTop[anIndex])) & (Pack::Load(&myBottom[anIndex]) <= Pack::Broadcast(aRectangle.Bottom()));
+
+			Simd::WriteMaskBits(someResultMasks, anIndex, result.MoveMask());
+		});
+	}
+
+	template <typename T>
+	void RectangleBatch<T>::Contains(const Point<T>& aPoint, std::span<std::uint64_t> someResultMasks) const
+	{
+		Simd::ClearMask(someResultMasks, Size());
+
+		Simd::ForEachPack<T>(Size(), [&]<typename Pack>(std::size_t anIndex)
+		{
+			const Pack x = Pack::Broadcast(aPoint.X);
+			const Pack y = Pack::Broadcast(aPoint.Y);
+
+			const auto result =
+				(Pack::Load(&myLeft[anIndex]) <= x) & (x <= Pack::Load(&myRight[anIndex])) &
+				(Pack::Load(&myTop[anIndex]) <= y) & (y <= Pack::Load(&myBottom[anIndex]));
+
+			Simd::WriteMaskBits(someResultMasks, anIndex, result.MoveMask());
+		});
+	}
+
+	template <typename T>
+	void RectangleBatch<T>::Contains(const Rectangle<T>& aRectangle, std::span<std::uint64_t> someResultMasks) const
+	{
+		Simd::ClearMask(someResultMasks, Size());
+
+		Simd::ForEachPack<T>(Size(), [&]<typename Pack>(std::size_t anIndex)
+		{
+			const auto result =
+				(Pack::Load(&myLeft[anIndex]) <= Pack::Broadcast(aRectangle.Left())) & (Pack::Broadcast(aRectangle.Right()) <= Pack::Load(&myRight[anIndex])) &
+				(Pack::Load(&myTop[anIndex]) <= Pack::Broadcast(aRectangle.Top())) & (Pack::Broadcast(aRectangle.Bottom()) <= Pack::Load(&myBottom[anIndex]));
+
+			Simd::WriteMaskBits(someResultMasks, anIndex, result.MoveMask());
+		});
+	}
+
+	template <typename T>
+	void RectangleBatch<T>::Intersection(const Rectangle<T>& aRectangle, RectangleBatch& outIntersections, std::span<std::uint64_t> someResultMasks) const
+	{
+		outIntersections.myLeft.resize(Size());
+		outIntersections.myTop.resize(Size());
+		outIntersections.myRight.resize(Size());
+		outIntersections.myBottom.resize(Size());
+
+		Simd::ClearMask(someResultMasks, Size());
+
+		Simd::ForEachPack<T>(Size(), [&]<typename Pack>(std::size_t anIndex)
+		{
+			const Pack left = Pack::Max(Pack::Load(&myLeft[anIndex]), Pack::Broadcast(aRectangle.Left()));
+			const Pack top = Pack::Max(Pack::Load(&myTop[anIndex]), Pack::Broadcast(aRectangle.Top()));
+			const Pack right = Pack::Min(Pack::Load(&myRight[anIndex]), Pack::Broadcast(aRectangle.Right()));
+			const Pack bottom = Pack::Min(Pack::Load(&myBottom[anIndex]), Pack::Broadcast(aRectangle.Bottom()));
+
+			left.Store(&outIntersections.myLeft[anIndex]);
+			top.Store(&outIntersections.myTop[anIndex]);
+			right.Store(&outIntersections.myRight[anIndex]);
+			bottom.Store(&outIntersections.myBottom[anIndex]);
+
+			Simd::WriteMaskBits(someResultMasks, anIndex, ((left < right) & (top < bottom)).MoveMask());
+		});
+	}
+
+	template <typename T>
+	void RectangleBatch<T>::IntersectsWith(const Rectangle<T>& aRectangle, std::span<std::uint64_t> someResultMasks) const
+	{
+		Simd::ClearMask(someResultMasks, Size());
+
+		Simd::ForEachPack<T>(Size(), [&]<typename Pack>(std::size_t anIndex)
+		{
+			const auto result =
+				(Pack::Load(&myLeft[anIndex]) < Pack::Broadcast(aRectangle.Right())) & (Pack::Broadcast(aRectangle.Left()) < Pack::Load(&myRight[anIndex])) &
+				(Pack::Load(&myTop[anIndex]) < Pack::Broadcast(aRectangle.Bottom())) & (Pack::Broadcast(aRectangle.Top()) < Pack::Load(&myBottom[anIndex]));
+
+			Simd::WriteMaskBits(someResultMasks, anIndex, result.MoveMask());
+		});
+	}
 }
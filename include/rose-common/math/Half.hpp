@@ -0,0 +1,223 @@
+#pragma once
+
+#include "../Color.hpp"
+#include "../Parallel.hpp"
+#include "../Simd.hpp"
+
+#include <bit>
+#include <compare>
+#include <cstdint>
+#include <span>
+#include <type_traits>
+
+namespace RoseCommon::Math
+{
+	/**
+	 * @brief A 16-bit IEEE 754 half-precision floating-point number, for halving the size of large buffers of vectors and colors.
+	 *        Arithmetic is done in single precision and rounded back to nearest even.
+	 */
+	class Half
+	{
+	public:
+
+		//--------------------------------------------------
+		// * Construction
+		//--------------------------------------------------
+		#pragma region Construction
+
+		/**
+		 * @brief Initialize to positive zero.
+		 */
+		constexpr Half() = default;
+
+		/**
+		 * @brief Initialize to the nearest half-precision value, rounding to nearest even.
+		 * @param aValue The value to convert.
+		 */
+		template <typename T> requires(std::is_arithmetic_v<T>)
+		constexpr Half(T aValue) : myBits(FromFloat(static_cast<float>(aValue))) { }
+
+		/**
+		 * @brief Create a value from its binary representation.
+		 * @param someBits The sign, exponent and mantissa bits.
+		 */
+		static constexpr Half FromBits(std::uint16_t someBits);
+
+		#pragma endregion
+
+		//--------------------------------------------------
+		// * Properties
+		//--------------------------------------------------
+		#pragma region Properties
+
+		/**
+		 * @brief Get the binary representation of the value.
+		 */
+		constexpr std::uint16_t GetBits() const { return myBits; }
+
+		#pragma endregion
+
+		//--------------------------------------------------
+		// * Methods
+		//--------------------------------------------------
+		#pragma region Methods
+
+		/**
+		 * @brief Convert the value to single precision, which is exact.
+		 */
+		constexpr float ToFloat() const;
+
+		#pragma endregion
+
+		//--------------------------------------------------
+		// * Operators
+		//--------------------------------------------------
+		#pragma region Operators
+
+		template <typename T> requires(std::is_arithmetic_v<T>)
+		explicit constexpr operator T() const { return static_cast<T>(ToFloat()); }
+
+		constexpr Half operator-() const { return FromBits(myBits ^ 0x8000); }
+
+		friend constexpr Half operator+(Half aValue, Half anOther) { return aValue.ToFloat() + anOther.ToFloat(); }
+		friend constexpr Half operator-(Half aValue, Half anOther) { return aValue.ToFloat() - anOther.ToFloat(); }
+		friend constexpr Half operator*(Half aValue, Half anOther) { return aValue.ToFloat() * anOther.ToFloat(); }
+		friend constexpr Half operator/(Half aValue, Half anOther) { return aValue.ToFloat() / anOther.ToFloat(); }
+
+		constexpr Half& operator+=(Half aValue) { return *this = *this + aValue; }
+		constexpr Half& operator-=(Half aValue) { return *this = *this - aValue; }
+		constexpr Half& operator*=(Half aValue) { return *this = *this * aValue; }
+		constexpr Half& operator/=(Half aValue) { return *this = *this / aValue; }
+
+		friend constexpr bool operator==(Half aValue, Half anOther) { return aValue.ToFloat() == anOther.ToFloat(); }
+		friend constexpr std::partial_ordering operator<=>(Half aValue, Half anOther) { return aValue.ToFloat() <=> anOther.ToFloat(); }
+
+		#pragma endregion
+
+	private:
+		static constexpr std::uint16_t FromFloat(float aValue);
+
+		std::uint16_t myBits = 0;
+	};
+
+	static_assert(sizeof(Half) == 2, "Half needs to be exactly 16 bits to be converted in bulk.");
+
+	/**
+	 * @brief Convert half-precision values to single precision, eight at a time with F16C.
+	 * @param someValues The values to convert.
+	 * @param someResults A buffer for the converted values, at least as large as the input.
+	 */
+	void ConvertToFloat(std::span<const Half> someValues, std::span<float> someResults);
+
+	/**
+	 * @brief Convert single-precision values to half precision, rounding to nearest even, eight at a time with F16C.
+	 * @param someValues The values to convert.
+	 * @param someResults A buffer for the converted values, at least as large as the input.
+	 */
+	void ConvertFromFloat(std::span<const float> someValues, std::span<Half> someResults);
+}
+
+namespace RoseCommon
+{
+	template <>
+	inline constexpr bool IsNormalizedColorComponent<Math::Half> = true;
+}
+
+namespace RoseCommon::Math
+{
+	constexpr Half Half::FromBits(std::uint16_t someBits)
+	{
+		Half value;
+		value.myBits = someBits;
+		return value;
+	}
+
+	constexpr float Half::ToFloat() const
+	{
+#if defined(ROSECOMMON_SIMD_F16C)
+		if (!std::is_constant_evaluated())
+			return _cvtsh_ss(myBits);
+#endif
+
+		const std::uint32_t sign = static_cast<std::uint32_t>(myBits & 0x8000) << 16;
+		const std::uint32_t exponent = myBits & 0x7C00;
+		const std::uint32_t mantissa = myBits & 0x03FF;
+
+		// Infinity and NaN keep their mantissa, and subnormals are exact in single precision as a scaled integer.
+		if (exponent == 0x7C00)
+			return std::bit_cast<float>(sign | 0x7F800000 | (mantissa << 13));
+
+		if (exponent == 0)
+		{
+			const float magnitude = static_cast<float>(mantissa) * (1.f / (1 << 24));
+			return sign != 0 ? -magnitude : magnitude;
+		}
+
+		return std::bit_cast<float>(sign | ((static_cast<std::uint32_t>(myBits & 0x7FFF) << 13) + ((127 - 15) << 23)));
+	}
+
+	constexpr std::uint16_t Half::FromFloat(float aValue)
+	{
+#if defined(ROSECOMMON_SIMD_F16C)
+		if (!std::is_constant_evaluated())
+			return static_cast<std::uint16_t>(_cvtss_sh(aValue, _MM_FROUND_TO_NEAREST_INT));
+#endif
+
+		std::uint32_t bits = std::bit_cast<std::uint32_t>(aValue);
+		const std::uint16_t sign = static_cast<std::uint16_t>((bits >> 16) & 0x8000);
+		bits &= 0x7FFFFFFF;
+
+		// Infinity and NaN, keeping NaNs quiet.
+		if (bits >= 0x7F800000)
+			return static_cast<std::uint16_t>(sign | (bits > 0x7F800000 ? 0x7E00 : 0x7C00));
+
+		// Anything from 65520 and up rounds to infinity.
+		if (bits >= 0x477FF000)
+			return static_cast<std::uint16_t>(sign | 0x7C00);
+
+		// Below the smallest normal, let a float addition align and round the mantissa into subnormal position.
+		if (bits < 0x38800000)
+		{
+			constexpr std::uint32_t alignBits = ((127 - 15) + (23 - 10) + 1) << 23;
+			const float aligned = std::bit_cast<float>(bits) + std::bit_cast<float>(alignBits);
+			return static_cast<std::uint16_t>(sign | (std::bit_cast<std::uint32_t>(aligned) - alignBits));
+		}
+
+		// Rebias the exponent and round the dropped mantissa bits to nearest even.
+		const std::uint32_t isMantissaOdd = (bits >> 13) & 1;
+		bits += (static_cast<std::uint32_t>(15 - 127) << 23) + 0xFFF + isMantissaOdd;
+		return static_cast<std::uint16_t>(sign | (bits >> 13));
+	}
+
+	inline void ConvertToFloat(std::span<const Half> someValues, std::span<float> someResults)
+	{
+		Parallel::ForEachChunk(someValues.size(), Parallel::GetChunkCount(someValues.size(), 1 << 16), [&](std::size_t, std::size_t aBegin, std::size_t anEnd)
+		{
+			std::size_t i = aBegin;
+
+#if defined(ROSECOMMON_SIMD_F16C)
+			for (; i + 8 <= anEnd; i += 8)
+				_mm256_storeu_ps(someResults.data() + i, _mm256_cvtph_ps(_mm_loadu_si128(reinterpret_cast<const __m128i*>(someValues.data() + i))));
+#endif
+
+			for (; i < anEnd; ++i)
+				someResults[i] = someValues[i].ToFloat();
+		});
+	}
+
+	inline void ConvertFromFloat(std::span<const float> someValues, std::span<Half> someResults)
+	{
+		Parallel::ForEachChunk(someValues.size(), Parallel::GetChunkCount(someValues.size(), 1 << 16), [&](std::size_t, std::size_t aBegin, std::size_t anEnd)
+		{
+			std::size_t i = aBegin;
+
+#if defined(ROSECOMMON_SIMD_F16C)
+			for (; i + 8 <= anEnd; i += 8)
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(someResults.data() + i), _mm256_cvtps_ph(_mm256_loadu_ps(someValues.data() + i), _MM_FROUND_TO_NEAREST_INT));
+#endif
+
+			for (; i < anEnd; ++i)
+				someResults[i] = someValues[i];
+		});
+	}
+}
@@ -0,0 +1,356 @@
+#pragma once
+
+#include "Common.hpp"
+#include "Vector.hpp"
+
+#include "../JobSystem.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <vector>
+
+namespace RoseCommon::Math
+{
+	/**
+	 * @brief A static k-d tree over a set of points, for nearest-neighbor and fixed-radius queries.
+	 *
+	 *        The tree is stored implicitly: points are reordered so that every subrange has its splitting point
+	 *        in the middle, with the left subtree before it and the right subtree after it. No child links are stored,
+	 *        only the reordered points, their original indices and each node's split axis.
+	 *
+	 * @tparam Vector The point type, one of Vector2, Vector3 or Vector4.
+	 */
+	template <typename Vector>
+	class KdTree
+	{
+		using Traits = _impl::VectorTraits<Vector>;
+
+	public:
+
+		//--------------------------------------------------
+		// * Types
+		//--------------------------------------------------
+		#pragma region Types
+
+		using Component = typename Traits::Component;
+
+		/**
+		 * @brief A point found by a nearest-neighbor query.
+		 */
+		struct Neighbor
+		{
+			std::uint32_t Index = 0;
+			Component DistanceSquared = 0;
+		};
+
+		#pragma endregion
+
+		//--------------------------------------------------
+		// * Static constants
+		//--------------------------------------------------
+		#pragma region Static constants
+
+		/**
+		 * @brief Subtrees with at least this many points are built on a separate thread.
+		 */
+		static constexpr std::size_t ParallelBuildThreshold = 16384;
+
+		#pragma endregion
+
+		//--------------------------------------------------
+		// * Construction
+		//--------------------------------------------------
+		#pragma region Construction
+
+		/**
+		 * @brief Initialize an empty tree.
+		 */
+		KdTree() = default;
+
+		/**
+		 * @brief Initialize and build the tree over the specified points.
+		 * @param somePoints The points to build from. They are copied into the tree.
+		 */
+		explicit KdTree(std::span<const Vector> somePoints);
+
+		#pragma endregion
+
+		//--------------------------------------------------
+		// * Properties
+		//--------------------------------------------------
+		#pragma region Properties
+
+		/**
+		 * @brief Get the points in tree order.
+		 */
+		std::span<const Vector> GetPoints() const { return myPoints; }
+
+		/**
+		 * @brief Get the original index of each point, in tree order.
+		 */
+		std::span<const std::uint32_t> GetIndices() const { return myIndices; }
+
+		/**
+		 * @brief Get the number of points in the tree.
+		 */
+		std::size_t Size() const { return myPoints.size(); }
+
+		#pragma endregion
+
+		//--------------------------------------------------
+		// * Methods
+		//--------------------------------------------------
+		#pragma region Methods
+
+		/**
+		 * @brief Rebuild the tree from scratch over the specified points.
+		 * @param somePoints The points to build from. They are copied into the tree.
+		 */
+		void Build(std::span<const Vector> somePoints);
+
+		/**
+		 * @brief Find the points closest to a point.
+		 * @param aPoint The point to search from.
+		 * @param someResults A buffer to write the results into, ordered by increasing distance. Its size is the number of neighbors searched for.
+		 * @param aMaxDistanceSquared Points further away than this are ignored.
+		 * @return The number of neighbors written.
+		 */
+		std::size_t Nearest(const Vector& aPoint, std::span<Neighbor> someResults, Component aMaxDistanceSquared = std::numeric_limits<Component>::max()) const;
+
+		/**
+		 * @brief Find all points within a distance of a point, in no particular order.
+		 * @param aPoint The point to search from.
+		 * @param aRadius The largest distance to include points at.
+		 * @param someResults A buffer to write the original indices of the found points into.
+		 * @return The number of points found. If larger than the buffer, only the first ones found were written.
+		 */
+		std::size_t WithinRadius(const Vector& aPoint, Component aRadius, std::span<std::uint32_t> someResults) const;
+
+		#pragma endregion
+
+	private:
+		struct Item
+		{
+			Vector Point;
+			std::uint32_t Index;
+		};
+
+		struct StackEntry
+		{
+			std::uint32_t Begin;
+			std::uint32_t End;
+			Component DistanceSquared;
+		};
+
+		// Every traversal step halves the range, so the stack never holds more than one entry per level.
+		using Stack = std::array<StackEntry, 64>;
+
+		void BuildRange(std::vector<Item>& someItems, std::uint32_t aBegin, std::uint32_t anEnd);
+
+	private:
+		std::vector<Vector> myPoints;
+		std::vector<std::uint32_t> myIndices;
+		std::vector<std::uint8_t> myAxes;
+	};
+}
+
+namespace RoseCommon::Math
+{
+	template <typename Vector>
+	KdTree<Vector>::KdTree(std::span<const Vector> somePoints)
+	{
+		Build(somePoints);
+	}
+
+	template <typename Vector>
+	void KdTree<Vector>::Build(std::span<const Vector> somePoints)
+	{
+		const std::uint32_t count = static_cast<std::uint32_t>(somePoints.size());
+
+		std::vector<Item> items;
+		items.reserve(count);
+		for (std::uint32_t i = 0; i < count; ++i)
+			items.push_back(Item{ somePoints[i], i });
+
+		myAxes.assign(count, 0);
+		BuildRange(items, 0, count);
+
+		myPoints.resize(count);
+		myIndices.resize(count);
+		for (std::uint32_t i = 0; i < count; ++i)
+		{
+			myPoints[i] = items[i].Point;
+			myIndices[i] = items[i].Index;
+		}
+	}
+
+	template <typename Vector>
+	std::size_t KdTree<Vector>::Nearest(const Vector& aPoint, std::span<Neighbor> someResults, Component aMaxDistanceSquared) const
+	{
+		if (someResults.empty() || myPoints.empty())
+			return 0;
+
+		std::size_t count = 0;
+		auto worstDistance = [&]() { return count == someResults.size() ? someResults[count - 1].DistanceSquared : aMaxDistanceSquared; };
+
+		Stack stack;
+		std::size_t stackSize = 0;
+		stack[stackSize++] = StackEntry{ 0, static_cast<std::uint32_t>(myPoints.size()), 0 };
+
+		while (stackSize > 0)
+		{
+			StackEntry entry = stack[--stackSize];
+			if (entry.DistanceSquared > worstDistance())
+				continue;
+
+			while (entry.Begin < entry.End)
+			{
+				const std::uint32_t middle = entry.Begin + (entry.End - entry.Begin) / 2;
+
+				const Component distance = Vector::DistanceSquared(aPoint, myPoints[middle]);
+				if (count < someResults.size() ? distance <= aMaxDistanceSquared : distance < someResults[count - 1].DistanceSquared)
+				{
+					// Insertion sort into the result buffer, dropping the furthest point when full.
+					std::size_t position = count < someResults.size() ? count++ : count - 1;
+					for (; position > 0 && someResults[position - 1].DistanceSquared > distance; --position)
+						someResults[position] = someResults[position - 1];
+					someResults[position] = Neighbor{ myIndices[middle], distance };
+				}
+
+				// Continue down the side of the split containing the point, and come back for the other side if it's still in range.
+				const std::size_t axis = myAxes[middle];
+				const Component difference = Traits::Get(aPoint, axis) - Traits::Get(myPoints[middle], axis);
+
+				StackEntry farSide{ middle + 1, entry.End, difference * difference };
+				if (difference < 0)
+				{
+					entry.End = middle;
+				}
+				else
+				{
+					farSide.Begin = entry.Begin;
+					farSide.End = middle;
+					entry.Begin = middle + 1;
+				}
+
+				if (farSide.Begin < farSide.End && farSide.DistanceSquared <= worstDistance())
+					stack[stackSize++] = farSide;
+			}
+		}
+
+		return count;
+	}
+
+	template <typename Vector>
+	std::size_t KdTree<Vector>::WithinRadius(const Vector& aPoint, Component aRadius, std::span<std::uint32_t> someResults) const
+	{
+		if (myPoints.empty())
+			return 0;
+
+		const Component radiusSquared = aRadius * aRadius;
+		std::size_t count = 0;
+
+		Stack stack;
+		std::size_t stackSize = 0;
+		stack[stackSize++] = StackEntry{ 0, static_cast<std::uint32_t>(myPoints.size()), 0 };
+
+		while (stackSize > 0)
+		{
+			StackEntry entry = stack[--stackSize];
+
+			while (entry.Begin < entry.End)
+			{
+				const std::uint32_t middle = entry.Begin + (entry.End - entry.Begin) / 2;
+
+				if (Vector::DistanceSquared(aPoint, myPoints[middle]) <= radiusSquared)
+				{
+					if (count < someResults.size())
+						someResults[count] = myIndices[middle];
+					++count;
+				}
+
+				const std::size_t axis = myAxes[middle];
+				const Component difference = Traits::Get(aPoint, axis) - Traits::Get(myPoints[middle], axis);
+
+				StackEntry farSide{ middle + 1, entry.End, difference * difference };
+				if (difference < 0)
+				{
+					entry.End = middle;
+				}
+				else
+				{
+					farSide.Begin = entry.Begin;
+					farSide.End = middle;
+					entry.Begin = middle + 1;
+				}
+
+				if (farSide.Begin < farSide.End && farSide.DistanceSquared <= radiusSquared)
+					stack[stackSize++] = farSide;
+			}
+		}
+
+		return count;
+	}
+
+	template <typename Vector>
+	void KdTree<Vector>::BuildRange(std::vector<Item>& someItems, std::uint32_t aBegin, std::uint32_t anEnd)
+	{
+		if (anEnd - aBegin <= 1)
+			return;
+
+		// Split along the axis with the largest spread.
+		std::array<Component, Traits::Count> minimum;
+		std::array<Component, Traits::Count> maximum;
+		for (std::size_t axis = 0; axis < Traits::Count; ++axis)
+			minimum[axis] = maximum[axis] = Traits::Get(someItems[aBegin].Point, axis);
+
+		for (std::uint32_t i = aBegin + 1; i < anEnd; ++i)
+		{
+			for (std::size_t axis = 0; axis < Traits::Count; ++axis)
+			{
+				const Component value = Traits::Get(someItems[i].Point, axis);
+				minimum[axis] = Math::Min<Component>(minimum[axis], value);
+				maximum[axis] = Math::Max<Component>(maximum[axis], value);
+			}
+		}
+
+		std::size_t splitAxis = 0;
+		for (std::size_t axis = 1; axis < Traits::Count; ++axis)
+		{
+			if (maximum[axis] - minimum[axis] > maximum[splitAxis] - minimum[splitAxis])
+				splitAxis = axis;
+		}
+
+		const std::uint32_t middle = aBegin + (anEnd - aBegin) / 2;
+		std::nth_element(
+			someItems.begin() + aBegin,
+			someItems.begin() + middle,
+			someItems.begin() + anEnd,
+			[splitAxis](const Item& anItemA, const Item& anItemB)
+			{
+				return Traits::Get(anItemA.Point, splitAxis) < Traits::Get(anItemB.Point, splitAxis);
+			});
+
+		myAxes[middle] = static_cast<std::uint8_t>(splitAxis);
+
+		if (anEnd - aBegin >= ParallelBuildThreshold)
+		{
+			Parallel::JobSystem& jobSystem = Parallel::JobSystem::GetDefault();
+			const Parallel::JobHandle leftBuild = jobSystem.Schedule([&]()
+			{
+				BuildRange(someItems, aBegin, middle);
+			});
+
+			BuildRange(someItems, middle + 1, anEnd);
+			jobSystem.Wait(leftBuild);
+		}
+		else
+		{
+			BuildRange(someItems, aBegin, middle);
+			BuildRange(someItems, middle + 1, anEnd);
+		}
+	}
+}
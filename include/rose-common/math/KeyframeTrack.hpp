@@ -0,0 +1,473 @@
+#pragma once
+
+#include "../Simd.hpp"
+#include "Common.hpp"
+#include "Quaternion.hpp"
+#include "Vector.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+namespace RoseCommon::Math
+{
+	/**
+	 * @brief How a keyframe track moves from one key to the next.
+	 */
+	enum class Interpolation : std::uint8_t
+	{
+		/**
+		 * @brief Hold the value of the first key until the next key is reached.
+		 */
+		Step,
+
+		/**
+		 * @brief Interpolate linearly, like Math::Lerp.
+		 */
+		Linear,
+
+		/**
+		 * @brief Ease in and out with a cubic, like Math::SmoothStep.
+		 */
+		SmoothStep,
+
+		/**
+		 * @brief Follow the tangents stored with each key, like Math::Hermite.
+		 */
+		Hermite,
+
+		/**
+		 * @brief Pass through the keys with tangents from their neighbors, like Math::CatmullRom.
+		 */
+		CatmullRom
+	};
+
+	/**
+	 * @brief A sequence of keyframes for a single animated value, stored component by component.
+	 *
+	 *        Every interpolation mode is reduced to a cubic Hermite segment when sampling, so tracks with different modes
+	 *        can be evaluated together with SIMD when sampling many tracks at once.
+	 *        Rotation tracks hold quaternions. Their keys are sign-aligned as they are added
+	 *        so interpolation takes the shortest path, and sampled values are normalized.
+	 *
+	 * @tparam Value The type of value being animated, such as Vector3, Vector4, Color or Quaternion.
+	 * @tparam IsRotation Whether the values are Quaternion rotations.
+	 */
+	template <typename Value, bool IsRotation = false>
+	class KeyframeTrack
+	{
+		using Traits = _impl::VectorTraits<Value>;
+
+	public:
+
+		//--------------------------------------------------
+		// * Types
+		//--------------------------------------------------
+		#pragma region Types
+
+		using Component = typename Traits::Component;
+
+		/**
+		 * @brief The playback state of one user of a track, remembering the last segment sampled
+		 *        so that sequential playback finds the next segment without searching.
+		 */
+		struct Sampler
+		{
+			std::uint32_t Segment = 0;
+		};
+
+		#pragma endregion
+
+		//--------------------------------------------------
+		// * Static constants
+		//--------------------------------------------------
+		#pragma region Static constants
+
+		/**
+		 * @brief The number of tracks gathered and evaluated together when sampling many tracks.
+		 */
+		static constexpr std::size_t BatchSize = 64;
+
+		#pragma endregion
+
+		//--------------------------------------------------
+		// * Properties
+		//--------------------------------------------------
+		#pragma region Properties
+
+		/**
+		 * @brief Get the time of the last key.
+		 */
+		Component Duration() const { return myTimes.empty() ? Component(0) : myTimes.back(); }
+
+		/**
+		 * @brief Get the number of keys.
+		 */
+		std::size_t KeyCount() const { return myTimes.size(); }
+
+		/**
+		 * @brief Get the time of each key.
+		 */
+		std::span<const Component> GetTimes() const { return myTimes; }
+
+		/**
+		 * @brief Get one component of every key value.
+		 * @param aComponent The index of the component.
+		 */
+		std::span<const Component> GetValues(std::size_t aComponent) const { return myValues[aComponent]; }
+
+		#pragma endregion
+
+		//--------------------------------------------------
+		// * Methods
+		//--------------------------------------------------
+		#pragma region Methods
+
+		/**
+		 * @brief Add a key after all existing keys.
+		 * @param aTime The time of the key, which must be later than the previous key.
+		 * @param aValue The value at the key.
+		 * @param anInterpolation How to interpolate from this key to the next.
+		 * @param aTangent The rate of change per time unit at the key, used by Hermite segments.
+		 */
+		void AddKey(Component aTime, const Value& aValue, Interpolation anInterpolation = Interpolation::Linear, const Value& aTangent = Value());
+
+		/**
+		 * @brief Remove all keys.
+		 */
+		void Clear();
+
+		/**
+		 * @brief Reserve memory for a number of keys.
+		 */
+		void Reserve(std::size_t aKeyCount);
+
+		/**
+		 * @brief Sample the track at a time, searching for the segment.
+		 * @param aTime The time to sample at. Times outside the track hold the first or last key.
+		 */
+		Value Sample(Component aTime) const;
+
+		/**
+		 * @brief Sample the track at a time, starting the segment search from where the sampler was last.
+		 * @param aTime The time to sample at. Times outside the track hold the first or last key.
+		 * @param aSampler The playback state to use and update.
+		 */
+		Value Sample(Component aTime, Sampler& aSampler) const;
+
+		/**
+		 * @brief Sample many tracks at the same time. Segments are found per track through their samplers,
+		 *        and the interpolation is evaluated across tracks with SIMD.
+		 * @param someTracks The tracks to sample.
+		 * @param aTime The time to sample at.
+		 * @param someSamplers The playback state of each track, the same count as the tracks.
+		 * @param someResults A buffer to write the value of each track into, the same count as the tracks.
+		 */
+		static void Sample(std::span<const KeyframeTrack> someTracks, Component aTime, std::span<Sampler> someSamplers, std::span<Value> someResults);
+
+		#pragma endregion
+
+	private:
+		// A segment reduced to a cubic Hermite curve, evaluated at Amount.
+		struct HermiteSegment
+		{
+			Component Amount;
+			std::array<Component, Traits::Count> Start;
+			std::array<Component, Traits::Count> End;
+			std::array<Component, Traits::Count> StartTangent;
+			std::array<Component, Traits::Count> EndTangent;
+		};
+
+		std::uint32_t FindSegment(Component aTime, std::uint32_t aHint) const;
+		void GetHermiteSegment(Component aTime, std::uint32_t aSegment, HermiteSegment& aSegmentOut) const;
+
+		static Value ToValue(const std::array<Component, Traits::Count>& someComponents);
+
+	private:
+		std::vector<Component> myTimes;
+		std::vector<Interpolation> myInterpolations;
+		std::array<std::vector<Component>, Traits::Count> myValues;
+		std::array<std::vector<Component>, Traits::Count> myTangents;
+	};
+
+	/**
+	 * @brief A keyframe track of quaternion rotations.
+	 */
+	template <typename T>
+	using RotationTrack = KeyframeTrack<Quaternion<T>, true>;
+}
+
+namespace RoseCommon::Math
+{
+	template <typename Value, bool IsRotation>
+	void KeyframeTrack<Value, IsRotation>::AddKey(Component aTime, const Value& aValue, Interpolation anInterpolation, const Value& aTangent)
+	{
+		if (!myTimes.empty() && !(myTimes.back() < aTime))
+			throw std::invalid_argument("Keys must be added in increasing time order.");
+
+		Value value = aValue;
+		if constexpr (IsRotation)
+		{
+			// q and -q are the same rotation, pick the one closest to the previous key so interpolation takes the short way around.
+			if (!myTimes.empty())
+			{
+				Value previous;
+				for (std::size_t c = 0; c < Traits::Count; ++c)
+					Traits::Set(previous, c, myValues[c].back());
+
+				if (Value::Dot(value, previous) < 0)
+					value = -value;
+			}
+		}
+
+		myTimes.push_back(aTime);
+		myInterpolations.push_back(anInterpolation);
+		for (std::size_t c = 0; c < Traits::Count; ++c)
+		{
+			myValues[c].push_back(Traits::Get(value, c));
+			myTangents[c].push_back(Traits::Get(aTangent, c));
+		}
+	}
+
+	template <typename Value, bool IsRotation>
+	void KeyframeTrack<Value, IsRotation>::Clear()
+	{
+		myTimes.clear();
+		myInterpolations.clear();
+		for (std::size_t c = 0; c < Traits::Count; ++c)
+		{
+			myValues[c].clear();
+			myTangents[c].clear();
+		}
+	}
+
+	template <typename Value, bool IsRotation>
+	void KeyframeTrack<Value, IsRotation>::Reserve(std::size_t aKeyCount)
+	{
+		myTimes.reserve(aKeyCount);
+		myInterpolations.reserve(aKeyCount);
+		for (std::size_t c = 0; c < Traits::Count; ++c)
+		{
+			myValues[c].reserve(aKeyCount);
+			myTangents[c].reserve(aKeyCount);
+		}
+	}
+
+	template <typename Value, bool IsRotation>
+	Value KeyframeTrack<Value, IsRotation>::Sample(Component aTime) const
+	{
+		if (myTimes.empty())
+			return Value();
+
+		Sampler sampler;
+		sampler.Segment = FindSegment(aTime, std::numeric_limits<std::uint32_t>::max());
+		return Sample(aTime, sampler);
+	}
+
+	template <typename Value, bool IsRotation>
+	Value KeyframeTrack<Value, IsRotation>::Sample(Component aTime, Sampler& aSampler) const
+	{
+		if (myTimes.empty())
+			return Value();
+
+		aSampler.Segment = FindSegment(aTime, aSampler.Segment);
+
+		HermiteSegment segment;
+		GetHermiteSegment(aTime, aSampler.Segment, segment);
+
+		const Component u = segment.Amount;
+		const Component u2 = u * u;
+		const Component u3 = u2 * u;
+		const Component startWeight = 2 * u3 - 3 * u2 + 1;
+		const Component startTangentWeight = u3 - 2 * u2 + u;
+		const Component endWeight = 3 * u2 - 2 * u3;
+		const Component endTangentWeight = u3 - u2;
+
+		std::array<Component, Traits::Count> components;
+		for (std::size_t c = 0; c < Traits::Count; ++c)
+			components[c] = startWeight * segment.Start[c] + startTangentWeight * segment.StartTangent[c] + endWeight * segment.End[c] + endTangentWeight * segment.EndTangent[c];
+
+		return ToValue(components);
+	}
+
+	template <typename Value, bool IsRotation>
+	void KeyframeTrack<Value, IsRotation>::Sample(std::span<const KeyframeTrack> someTracks, Component aTime, std::span<Sampler> someSamplers, std::span<Value> someResults)
+	{
+		using Lanes = std::array<Component, BatchSize>;
+
+		Lanes amounts;
+		std::array<Lanes, Traits::Count> starts, ends, startTangents, endTangents, results;
+
+		for (std::size_t first = 0; first < someTracks.size(); first += BatchSize)
+		{
+			const std::size_t count = Math::Min<std::size_t>(BatchSize, someTracks.size() - first);
+
+			// Find each track's segment and gather it into lanes.
+			for (std::size_t lane = 0; lane < count; ++lane)
+			{
+				const KeyframeTrack& track = someTracks[first + lane];
+				Sampler& sampler = someSamplers[first + lane];
+
+				HermiteSegment segment{ };
+				if (!track.myTimes.empty())
+				{
+					sampler.Segment = track.FindSegment(aTime, sampler.Segment);
+					track.GetHermiteSegment(aTime, sampler.Segment, segment);
+				}
+
+				amounts[lane] = segment.Amount;
+				for (std::size_t c = 0; c < Traits::Count; ++c)
+				{
+					starts[c][lane] = segment.Start[c];
+					ends[c][lane] = segment.End[c];
+					startTangents[c][lane] = segment.StartTangent[c];
+					endTangents[c][lane] = segment.EndTangent[c];
+				}
+			}
+
+			Simd::ForEachPack<Component>(count, [&]<typename Pack>(std::size_t anIndex)
+			{
+				const Pack u = Pack::Load(&amounts[anIndex]);
+				const Pack u2 = u * u;
+				const Pack u3 = u2 * u;
+				const Pack one = Pack::Broadcast(Component(1));
+				const Pack two = Pack::Broadcast(Component(2));
+				const Pack three = Pack::Broadcast(Component(3));
+
+				const Pack startWeight = two * u3 - three * u2 + one;
+				const Pack startTangentWeight = u3 - two * u2 + u;
+				const Pack endWeight = three * u2 - two * u3;
+				const Pack endTangentWeight = u3 - u2;
+
+				for (std::size_t c = 0; c < Traits::Count; ++c)
+				{
+					const Pack result =
+						startWeight * Pack::Load(&starts[c][anIndex]) +
+						startTangentWeight * Pack::Load(&startTangents[c][anIndex]) +
+						endWeight * Pack::Load(&ends[c][anIndex]) +
+						endTangentWeight * Pack::Load(&endTangents[c][anIndex]);
+					result.Store(&results[c][anIndex]);
+				}
+			});
+
+			for (std::size_t lane = 0; lane < count; ++lane)
+			{
+				std::array<Component, Traits::Count> components;
+				for (std::size_t c = 0; c < Traits::Count; ++c)
+					components[c] = results[c][lane];
+
+				someResults[first + lane] = someTracks[first + lane].myTimes.empty() ? Value() : ToValue(components);
+			}
+		}
+	}
+
+	template <typename Value, bool IsRotation>
+	std::uint32_t KeyframeTrack<Value, IsRotation>::FindSegment(Component aTime, std::uint32_t aHint) const
+	{
+		if (myTimes.empty())
+			return 0;
+
+		// Segment i runs from key i to key i + 1. The last key is its own segment, holding its value.
+		const std::uint32_t lastKey = static_cast<std::uint32_t>(myTimes.size() - 1);
+
+		auto isInSegment = [&](std::uint32_t aSegment)
+		{
+			return
+				(aSegment == 0 || myTimes[aSegment] <= aTime) &&
+				(aSegment == lastKey || aTime < myTimes[aSegment + 1]);
+		};
+
+		if (aHint <= lastKey)
+		{
+			if (isInSegment(aHint))
+				return aHint;
+
+			if (aHint < lastKey && isInSegment(aHint + 1))
+				return aHint + 1;
+		}
+
+		const auto key = std::upper_bound(myTimes.begin(), myTimes.end(), aTime);
+		return key == myTimes.begin() ? 0 : static_cast<std::uint32_t>(key - myTimes.begin() - 1);
+	}
+
+	template <typename Value, bool IsRotation>
+	void KeyframeTrack<Value, IsRotation>::GetHermiteSegment(Component aTime, std::uint32_t aSegment, HermiteSegment& aSegmentOut) const
+	{
+		const std::size_t lastKey = myTimes.size() - 1;
+		const std::size_t start = aSegment;
+		const std::size_t end = Math::Min<std::size_t>(start + 1, lastKey);
+
+		for (std::size_t c = 0; c < Traits::Count; ++c)
+		{
+			aSegmentOut.Start[c] = myValues[c][start];
+			aSegmentOut.End[c] = myValues[c][end];
+			aSegmentOut.StartTangent[c] = 0;
+			aSegmentOut.EndTangent[c] = 0;
+		}
+
+		if (start == end || aTime <= myTimes[start])
+		{
+			aSegmentOut.Amount = 0;
+			return;
+		}
+
+		const Component duration = myTimes[end] - myTimes[start];
+		aSegmentOut.Amount = Math::Min<Component>((aTime - myTimes[start]) / duration, Component(1));
+
+		// Every mode is expressed as tangents for the Hermite basis, scaled to the segment's duration.
+		switch (myInterpolations[start])
+		{
+		case Interpolation::Step:
+			aSegmentOut.Amount = 0;
+			break;
+
+		case Interpolation::Linear:
+			for (std::size_t c = 0; c < Traits::Count; ++c)
+				aSegmentOut.StartTangent[c] = aSegmentOut.EndTangent[c] = aSegmentOut.End[c] - aSegmentOut.Start[c];
+			break;
+
+		case Interpolation::SmoothStep:
+			break;
+
+		case Interpolation::Hermite:
+			for (std::size_t c = 0; c < Traits::Count; ++c)
+			{
+				aSegmentOut.StartTangent[c] = myTangents[c][start] * duration;
+				aSegmentOut.EndTangent[c] = myTangents[c][end] * duration;
+			}
+			break;
+
+		case Interpolation::CatmullRom:
+		{
+			const std::size_t before = start > 0 ? start - 1 : start;
+			const std::size_t after = Math::Min<std::size_t>(end + 1, lastKey);
+			for (std::size_t c = 0; c < Traits::Count; ++c)
+			{
+				aSegmentOut.StartTangent[c] = (myValues[c][end] - myValues[c][before]) / 2;
+				aSegmentOut.EndTangent[c] = (myValues[c][after] - myValues[c][start]) / 2;
+			}
+			break;
+		}
+		}
+	}
+
+	template <typename Value, bool IsRotation>
+	Value KeyframeTrack<Value, IsRotation>::ToValue(const std::array<Component, Traits::Count>& someComponents)
+	{
+		Value value;
+		for (std::size_t c = 0; c < Traits::Count; ++c)
+			Traits::Set(value, c, someComponents[c]);
+
+		if constexpr (IsRotation)
+		{
+			if (Value::Dot(value, value) > 0)
+				value = value.Normalized();
+		}
+
+		return value;
+	}
+}
@@ -0,0 +1,510 @@
+#pragma once
+
+#include "Common.hpp"
+#include "Geometry.hpp"
+
+#include <array>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <vector>
+
+namespace RoseCommon::Math
+{
+	/**
+	 * @brief A two-dimensional spatial index for rectangles of varying size.
+	 *        Each node's bounds are loosened to twice its cell size, so every entry is stored in exactly one node,
+	 *        picked by its size and center, and moving an entry rarely needs more than a bounds update.
+	 *        Nodes are created on demand as entries are inserted, and freed again once their subtree holds no entries.
+	 * @tparam T A type for each component.
+	 */
+	template <typename T>
+	class LooseQuadTree
+	{
+	public:
+
+		//--------------------------------------------------
+		// * Types
+		//--------------------------------------------------
+		#pragma region Types
+
+		/**
+		 * @brief An entry found by a nearest-neighbor query.
+		 */
+		struct Neighbor
+		{
+			std::uint32_t Id = 0;
+			T DistanceSquared = 0;
+		};
+
+		#pragma endregion
+
+		//--------------------------------------------------
+		// * Static constants
+		//--------------------------------------------------
+		#pragma region Static constants
+
+		/**
+		 * @brief The deepest level the tree can be subdivided to.
+		 */
+		static constexpr std::uint32_t MaxDepthLimit = 16;
+
+		#pragma endregion
+
+		//--------------------------------------------------
+		// * Construction
+		//--------------------------------------------------
+		#pragma region Construction
+
+		/**
+		 * @brief Initialize an empty tree.
+		 * @param aWorldBounds The area covered by the tree. Entries outside it are still valid, but are kept in the root node.
+		 * @param aMaxDepth The deepest level the tree can be subdivided to, at most MaxDepthLimit.
+		 */
+		LooseQuadTree(const Rectangle<T>& aWorldBounds, std::uint32_t aMaxDepth = 8);
+
+		#pragma endregion
+
+		//--------------------------------------------------
+		// * Properties
+		//--------------------------------------------------
+		#pragma region Properties
+
+		/**
+		 * @brief Get the bounds an entry was last inserted or moved with.
+		 * @param anId The id of the entry.
+		 */
+		const Rectangle<T>& GetBounds(std::uint32_t anId) const { return myEntries[anId].Bounds; }
+
+		/**
+		 * @brief Get the number of entries in the tree.
+		 */
+		std::size_t Size() const { return myEntries.size() - myFreeIds.size(); }
+
+		#pragma endregion
+
+		//--------------------------------------------------
+		// * Methods
+		//--------------------------------------------------
+		#pragma region Methods
+
+		/**
+		 * @brief Replace the tree contents with the specified rectangles. Entry ids will match the rectangle indices.
+		 *        This is the same as inserting them one at a time into an empty tree, which is already linear as the depth is bounded.
+		 * @param someBounds The rectangles to insert.
+		 */
+		void Build(std::span<const Rectangle<T>> someBounds);
+
+		/**
+		 * @brief Remove all entries and nodes from the tree.
+		 */
+		void Clear();
+
+		/**
+		 * @brief Insert a rectangle into the tree.
+		 * @param aBounds The rectangle to insert.
+		 * @return An id for the new entry. Ids of removed entries are reused.
+		 */
+		std::uint32_t Insert(const Rectangle<T>& aBounds);
+
+		/**
+		 * @brief Move an entry to new bounds. Only relinks the entry if it no longer belongs in the same node.
+		 * @param anId The id of the entry.
+		 * @param aBounds The new bounds of the entry.
+		 */
+		void Move(std::uint32_t anId, const Rectangle<T>& aBounds);
+
+		/**
+		 * @brief Find the entries closest to a point, measured to the closest point of their bounds.
+		 * @param aPoint The point to search from.
+		 * @param someResults A buffer to write the results into, ordered by increasing distance. Its size is the number of neighbors searched for.
+		 * @return The number of neighbors written, which is less than requested if the tree holds fewer entries.
+		 */
+		std::size_t Nearest(const Point<T>& aPoint, std::span<Neighbor> someResults) const;
+
+		/**
+		 * @brief Find all entries whose bounds contain a point.
+		 * @param aPoint The point to test.
+		 * @param aCallback Called as aCallback(id) for each entry containing the point.
+		 */
+		template <typename Callback>
+		void QueryPoint(const Point<T>& aPoint, Callback&& aCallback) const;
+
+		/**
+		 * @brief Find all entries whose bounds intersect a rectangle.
+		 * @param aRectangle The rectangle to test.
+		 * @param aCallback Called as aCallback(id) for each entry intersecting the rectangle.
+		 */
+		template <typename Callback>
+		void QueryRange(const Rectangle<T>& aRectangle, Callback&& aCallback) const;
+
+		/**
+		 * @brief Remove an entry from the tree.
+		 * @param anId The id of the entry.
+		 */
+		void Remove(std::uint32_t anId);
+
+		#pragma endregion
+
+	private:
+		static constexpr std::uint32_t NoIndex = std::numeric_limits<std::uint32_t>::max();
+
+		struct Node
+		{
+			Rectangle<T> LooseBounds;
+			std::array<std::uint32_t, 4> Children;
+			std::uint32_t Parent;
+			std::uint32_t FirstEntry;
+			std::uint32_t SubtreeCount;
+			std::uint32_t Depth;
+		};
+
+		struct Entry
+		{
+			Rectangle<T> Bounds;
+			std::uint32_t Node;
+			std::uint32_t Previous;
+			std::uint32_t Next;
+		};
+
+		// Traversal pushes at most four nodes per level on top of the one being popped.
+		using Stack = std::array<std::uint32_t, MaxDepthLimit * 3 + 4>;
+
+		static Rectangle<T> GetChildBounds(const Rectangle<T>& someParentBounds, std::uint32_t aQuadrant);
+
+		std::uint32_t FindNode(const Rectangle<T>& aBounds);
+		std::uint32_t GetOrCreateChild(std::uint32_t aNode, std::uint32_t aQuadrant);
+		void Reclaim(std::uint32_t aNode);
+
+		void Link(std::uint32_t anId, std::uint32_t aNode);
+		void Unlink(std::uint32_t anId);
+
+	private:
+		Rectangle<T> myWorldBounds;
+		std::uint32_t myMaxDepth;
+
+		std::vector<Node> myNodes;
+		std::vector<std::uint32_t> myFreeNodes;
+		std::vector<Entry> myEntries;
+		std::vector<std::uint32_t> myFreeIds;
+	};
+}
+
+namespace RoseCommon::Math
+{
+	template <typename T>
+	LooseQuadTree<T>::LooseQuadTree(const Rectangle<T>& aWorldBounds, std::uint32_t aMaxDepth)
+		: myWorldBounds(aWorldBounds)
+		, myMaxDepth(Math::Min<std::uint32_t>(aMaxDepth, MaxDepthLimit))
+	{
+		Clear();
+	}
+
+	template <typename T>
+	void LooseQuadTree<T>::Build(std::span<const Rectangle<T>> someBounds)
+	{
+		Clear();
+
+		myEntries.reserve(someBounds.size());
+		for (const Rectangle<T>& bounds : someBounds)
+			Insert(bounds);
+	}
+
+	template <typename T>
+	void LooseQuadTree<T>::Clear()
+	{
+		myEntries.clear();
+		myFreeIds.clear();
+		myNodes.clear();
+		myFreeNodes.clear();
+
+		// The root's loose bounds are never tested, it holds everything that doesn't fit further down.
+		Rectangle<T> rootBounds = myWorldBounds;
+		rootBounds.Inflate(myWorldBounds.Width / 2, myWorldBounds.Height / 2);
+		myNodes.push_back(Node{ rootBounds, { NoIndex, NoIndex, NoIndex, NoIndex }, NoIndex, NoIndex, 0, 0 });
+	}
+
+	template <typename T>
+	std::uint32_t LooseQuadTree<T>::Insert(const Rectangle<T>& aBounds)
+	{
+		std::uint32_t id;
+		if (myFreeIds.empty())
+		{
+			id = static_cast<std::uint32_t>(myEntries.size());
+			myEntries.push_back(Entry{ aBounds, NoIndex, NoIndex, NoIndex });
+		}
+		else
+		{
+			id = myFreeIds.back();
+			myFreeIds.pop_back();
+			myEntries[id] = Entry{ aBounds, NoIndex, NoIndex, NoIndex };
+		}
+
+		Link(id, FindNode(aBounds));
+		return id;
+	}
+
+	template <typename T>
+	void LooseQuadTree<T>::Move(std::uint32_t anId, const Rectangle<T>& aBounds)
+	{
+		Entry& entry = myEntries[anId];
+		entry.Bounds = aBounds;
+
+		// Small moves keep the entry within its node's loose bounds, and it's only relinked if a different level fits better.
+		const std::uint32_t node = FindNode(aBounds);
+		if (node == entry.Node)
+			return;
+
+		// Link into the new node before reclaiming the old one, whose ancestors may be on the new path.
+		const std::uint32_t previousNode = entry.Node;
+		Unlink(anId);
+		Link(anId, node);
+		Reclaim(previousNode);
+	}
+
+	template <typename T>
+	std::size_t LooseQuadTree<T>::Nearest(const Point<T>& aPoint, std::span<Neighbor> someResults) const
+	{
+		if (someResults.empty() || Size() == 0)
+			return 0;
+
+		std::size_t count = 0;
+
+		Stack stack;
+		std::size_t stackSize = 0;
+		stack[stackSize++] = 0;
+
+		while (stackSize > 0)
+		{
+			const Node& node = myNodes[stack[--stackSize]];
+
+			if (&node != &myNodes[0] && count == someResults.size() && node.LooseBounds.DistanceSquared(aPoint) >= someResults[count - 1].DistanceSquared)
+				continue;
+
+			for (std::uint32_t id = node.FirstEntry; id != NoIndex; id = myEntries[id].Next)
+			{
+				const T distance = myEntries[id].Bounds.DistanceSquared(aPoint);
+				if (count == someResults.size() && distance >= someResults[count - 1].DistanceSquared)
+					continue;
+
+				// Insertion sort into the result buffer, dropping the furthest entry when full.
+				std::size_t position = count < someResults.size() ? count++ : count - 1;
+				for (; position > 0 && someResults[position - 1].DistanceSquared > distance; --position)
+					someResults[position] = someResults[position - 1];
+				someResults[position] = Neighbor{ id, distance };
+			}
+
+			// Push the children furthest first, so the closest one is visited next and tightens the bound early.
+			std::array<std::uint32_t, 4> children;
+			std::array<T, 4> distances;
+			std::size_t childCount = 0;
+			for (const std::uint32_t child : node.Children)
+			{
+				if (child == NoIndex || myNodes[child].SubtreeCount == 0)
+					continue;
+
+				const T distance = myNodes[child].LooseBounds.DistanceSquared(aPoint);
+				std::size_t position = childCount++;
+				for (; position > 0 && distances[position - 1] < distance; --position)
+				{
+					children[position] = children[position - 1];
+					distances[position] = distances[position - 1];
+				}
+				children[position] = child;
+				distances[position] = distance;
+			}
+
+			for (std::size_t i = 0; i < childCount; ++i)
+				stack[stackSize++] = children[i];
+		}
+
+		return count;
+	}
+
+	template <typename T>
+	template <typename Callback>
+	void LooseQuadTree<T>::QueryPoint(const Point<T>& aPoint, Callback&& aCallback) const
+	{
+		Stack stack;
+		std::size_t stackSize = 0;
+		stack[stackSize++] = 0;
+
+		while (stackSize > 0)
+		{
+			const std::uint32_t nodeIndex = stack[--stackSize];
+			const Node& node = myNodes[nodeIndex];
+
+			if (node.SubtreeCount == 0 || (nodeIndex != 0 && !node.LooseBounds.Contains(aPoint)))
+				continue;
+
+			for (std::uint32_t id = node.FirstEntry; id != NoIndex; id = myEntries[id].Next)
+			{
+				if (myEntries[id].Bounds.Contains(aPoint))
+					aCallback(id);
+			}
+
+			for (const std::uint32_t child : node.Children)
+			{
+				if (child != NoIndex)
+					stack[stackSize++] = child;
+			}
+		}
+	}
+
+	template <typename T>
+	template <typename Callback>
+	void LooseQuadTree<T>::QueryRange(const Rectangle<T>& aRectangle, Callback&& aCallback) const
+	{
+		Stack stack;
+		std::size_t stackSize = 0;
+		stack[stackSize++] = 0;
+
+		while (stackSize > 0)
+		{
+			const std::uint32_t nodeIndex = stack[--stackSize];
+			const Node& node = myNodes[nodeIndex];
+
+			if (node.SubtreeCount == 0 || (nodeIndex != 0 && !node.LooseBounds.IntersectsWith(aRectangle)))
+				continue;
+
+			for (std::uint32_t id = node.FirstEntry; id != NoIndex; id = myEntries[id].Next)
+			{
+				if (myEntries[id].Bounds.IntersectsWith(aRectangle))
+					aCallback(id);
+			}
+
+			for (const std::uint32_t child : node.Children)
+			{
+				if (child != NoIndex)
+					stack[stackSize++] = child;
+			}
+		}
+	}
+
+	template <typename T>
+	void LooseQuadTree<T>::Remove(std::uint32_t anId)
+	{
+		const std::uint32_t node = myEntries[anId].Node;
+		Unlink(anId);
+		Reclaim(node);
+		myFreeIds.push_back(anId);
+	}
+
+	template <typename T>
+	Rectangle<T> LooseQuadTree<T>::GetChildBounds(const Rectangle<T>& someParentBounds, std::uint32_t aQuadrant)
+	{
+		// Loose bounds are twice the cell, so a child's cell size equals half of its loose bounds.
+		const Point<T> parentCenter = someParentBounds.Center();
+		const T cellWidth = someParentBounds.Width / 4;
+		const T cellHeight = someParentBounds.Height / 4;
+
+		const T centerX = parentCenter.X + ((aQuadrant & 1) ? cellWidth / 2 : -(cellWidth / 2));
+		const T centerY = parentCenter.Y + ((aQuadrant & 2) ? cellHeight / 2 : -(cellHeight / 2));
+
+		return Rectangle<T>(Point<T>(centerX - cellWidth, centerY - cellHeight), Math::Size<T>(cellWidth * 2, cellHeight * 2));
+	}
+
+	template <typename T>
+	std::uint32_t LooseQuadTree<T>::FindNode(const Rectangle<T>& aBounds)
+	{
+		// Descend towards the entry's center for as long as the child's loose bounds still contain all of it.
+		// Missing children are only created once the entry is known to go down into them.
+		const Point<T> center = aBounds.Center();
+
+		std::uint32_t nodeIndex = 0;
+		while (myNodes[nodeIndex].Depth < myMaxDepth)
+		{
+			const Node& node = myNodes[nodeIndex];
+			const Point<T> nodeCenter = node.LooseBounds.Center();
+			const std::uint32_t quadrant = (center.X < nodeCenter.X ? 0 : 1) | (center.Y < nodeCenter.Y ? 0 : 2);
+			const std::uint32_t child = node.Children[quadrant];
+
+			if (!(child != NoIndex ? myNodes[child].LooseBounds : GetChildBounds(node.LooseBounds, quadrant)).Contains(aBounds))
+				break;
+
+			nodeIndex = GetOrCreateChild(nodeIndex, quadrant);
+		}
+
+		return nodeIndex;
+	}
+
+	template <typename T>
+	std::uint32_t LooseQuadTree<T>::GetOrCreateChild(std::uint32_t aNode, std::uint32_t aQuadrant)
+	{
+		if (myNodes[aNode].Children[aQuadrant] != NoIndex)
+			return myNodes[aNode].Children[aQuadrant];
+
+		const Node node{ GetChildBounds(myNodes[aNode].LooseBounds, aQuadrant), { NoIndex, NoIndex, NoIndex, NoIndex }, aNode, NoIndex, 0, myNodes[aNode].Depth + 1 };
+
+		std::uint32_t child;
+		if (myFreeNodes.empty())
+		{
+			child = static_cast<std::uint32_t>(myNodes.size());
+			myNodes.push_back(node);
+		}
+		else
+		{
+			child = myFreeNodes.back();
+			myFreeNodes.pop_back();
+			myNodes[child] = node;
+		}
+
+		myNodes[aNode].Children[aQuadrant] = child;
+		return child;
+	}
+
+	template <typename T>
+	void LooseQuadTree<T>::Reclaim(std::uint32_t aNode)
+	{
+		// Empty nodes are freed as soon as they empty, so an empty node has no children left and its parent can be checked next.
+		std::uint32_t nodeIndex = aNode;
+		while (nodeIndex != 0 && myNodes[nodeIndex].SubtreeCount == 0)
+		{
+			const std::uint32_t parent = myNodes[nodeIndex].Parent;
+			for (std::uint32_t& child : myNodes[parent].Children)
+			{
+				if (child == nodeIndex)
+					child = NoIndex;
+			}
+
+			myFreeNodes.push_back(nodeIndex);
+			nodeIndex = parent;
+		}
+	}
+
+	template <typename T>
+	void LooseQuadTree<T>::Link(std::uint32_t anId, std::uint32_t aNode)
+	{
+		Entry& entry = myEntries[anId];
+		Node& node = myNodes[aNode];
+
+		entry.Node = aNode;
+		entry.Previous = NoIndex;
+		entry.Next = node.FirstEntry;
+		if (node.FirstEntry != NoIndex)
+			myEntries[node.FirstEntry].Previous = anId;
+		node.FirstEntry = anId;
+
+		for (std::uint32_t i = aNode; i != NoIndex; i = myNodes[i].Parent)
+			myNodes[i].SubtreeCount += 1;
+	}
+
+	template <typename T>
+	void LooseQuadTree<T>::Unlink(std::uint32_t anId)
+	{
+		Entry& entry = myEntries[anId];
+
+		if (entry.Previous != NoIndex)
+			myEntries[entry.Previous].Next = entry.Next;
+		else
+			myNodes[entry.Node].FirstEntry = entry.Next;
+
+		if (entry.Next != NoIndex)
+			myEntries[entry.Next].Previous = entry.Previous;
+
+		for (std::uint32_t i = entry.Node; i != NoIndex; i = myNodes[i].Parent)
+			myNodes[i].SubtreeCount -= 1;
+
+		entry.Node = NoIndex;
+	}
+}
@@ -1,12 +1,33 @@
 #pragma once
 
+#include "Common.hpp"
+
 #include <array>
 #include <optional>
 #include <stdexcept>
 #include <type_traits>
+#include <utility>
 
 namespace RoseCommon::Math
 {
+	namespace _impl
+	{
+		/**
+		 * @brief Tag for constructing a matrix without initializing its cells, for results which are about to be written in full.
+		 */
+		struct UninitializedMatrix { };
+
+		// Call a function once per index in [0, Count), with each index as a compile-time constant.
+		template <std::size_t Count, typename Function>
+		constexpr void Unroll(Function&& aFunction)
+		{
+			[&]<std::size_t... Indices>(std::index_sequence<Indices...>)
+			{
+				(aFunction(std::integral_constant<std::size_t, Indices>()), ...);
+			}(std::make_index_sequence<Count>());
+		}
+	}
+
 	template <std::size_t Width, std::size_t Height, typename T>
 	class Matrix
 	{
@@ -99,7 +120,7 @@ namespace RoseCommon::Math
 		 * @brief Calculate the matrix inverse.
 		 * @return The inverse of the matrix.
 		 */
-		constexpr std::optional<Matrix> Inverse() const requires(std::is_floating_point_v<T>&& Width == Height && Width > 0);
+		constexpr std::optional<Matrix> Inverse() const requires(IsFractional<T>&& Width == Height && Width > 0);
 
 		/**
 		 * @brief Calculate the matrix's minor. The square matrix consisting of the determinants of its submatrices.
@@ -107,7 +128,7 @@ namespace RoseCommon::Math
 		 *        Requires the matrix to be square.
 		 * @return The minor matrix.
 		 */
-		constexpr Matrix Minor() const requires(std::is_floating_point_v<T>&& Width == Height && Width > 0);
+		constexpr Matrix Minor() const requires(IsFractional<T>&& Width == Height && Width > 0);
 
 		/**
 		 * @brief Transpose the rows and columns of the matrix.
@@ -138,7 +159,13 @@ namespace RoseCommon::Math
 		#pragma endregion
 
 	private:
-		constexpr Matrix<Width - 1, Height - 1, T> SubMatrix(std::size_t aColumn, std::size_t aRow) const;
+		template <std::size_t, std::size_t, typename>
+		friend class Matrix;
+
+		constexpr explicit Matrix(_impl::UninitializedMatrix) { }
+
+		template <std::size_t Column, std::size_t Row>
+		constexpr Matrix<Width - 1, Height - 1, T> SubMatrix() const;
 
 	private:
 		T myCells[Width * Height];
@@ -147,10 +174,12 @@ namespace RoseCommon::Math
 	template <std::size_t Width, std::size_t Height, typename T>
 	constexpr Matrix<Width, Height, T> Matrix<Width, Height, T>::Identity() requires(Width == Height)
 	{
-		Matrix identityMatrix;
+		Matrix identityMatrix{ _impl::UninitializedMatrix() };
 
-		for (std::size_t i = 0; i < Width; ++i)
-			identityMatrix.GetCell(i, i) = static_cast<T>(1.f);
+		_impl::Unroll<Width * Height>([&](auto anIndex)
+		{
+			identityMatrix.myCells[anIndex] = static_cast<T>(anIndex % (Width + 1) == 0 ? 1 : 0);
+		});
 
 		return identityMatrix;
 	}
@@ -158,15 +187,13 @@ namespace RoseCommon::Math
 	template <std::size_t Width, std::size_t Height, typename T>
 	constexpr Matrix<Width, Height, T>::Matrix()
 	{
-		for (std::size_t i = 0; i < (Width * Height); ++i)
-			myCells[i] = static_cast<T>(0);
+		_impl::Unroll<Width * Height>([&](auto anIndex) { myCells[anIndex] = static_cast<T>(0); });
 	}
 
 	template <std::size_t Width, std::size_t Height, typename T>
 	constexpr Matrix<Width, Height, T>::Matrix(const std::array<T, Width * Height>& someCells)
 	{
-		for (std::size_t i = 0; i < (Width * Height); ++i)
-			myCells[i] = someCells[i];
+		_impl::Unroll<Width * Height>([&](auto anIndex) { myCells[anIndex] = someCells[anIndex]; });
 	}
 
 	template <std::size_t Width, std::size_t Height, typename T>
@@ -190,21 +217,19 @@ namespace RoseCommon::Math
 	template <std::size_t Width, std::size_t Height, typename T>
 	constexpr Matrix<Width, Height, T> Matrix<Width, Height, T>::Cofactor() const requires(Width == Height && Width > 0)
 	{
-		Matrix solution;
+		Matrix solution{ _impl::UninitializedMatrix() };
 
-		for (std::size_t rowIndex = 0; rowIndex < Height; ++rowIndex)
+		_impl::Unroll<Width * Height>([&](auto anIndex)
 		{
-			for (std::size_t columnIndex = 0; columnIndex < Width; ++columnIndex)
-			{
-				const auto subMatrix = SubMatrix(columnIndex, rowIndex);
+			constexpr std::size_t rowIndex = anIndex / Width;
+			constexpr std::size_t columnIndex = anIndex % Width;
+			constexpr bool isPositive = ((columnIndex ^ rowIndex) % 2) == 0;
 
-				const bool isPositive = ((columnIndex ^ rowIndex) % 2) == 0;
-				solution.GetCell(columnIndex, rowIndex) =
-					static_cast<T>(isPositive ? 1 : -1) *
-					subMatrix.Determinant()
-					;
-			}
-		}
+			solution.myCells[anIndex] =
+				static_cast<T>(isPositive ? 1 : -1) *
+				SubMatrix<columnIndex, rowIndex>().Determinant()
+				;
+		});
 
 		return solution;
 	}
@@ -214,32 +239,30 @@ namespace RoseCommon::Math
 	{
 		if constexpr (Width == 1)
 		{
-			return GetCell(0, 0);
+			return myCells[0];
 		}
 		else if constexpr (Width == 2)
 		{
-			return GetCell(0, 0) * GetCell(1, 1) - GetCell(0, 1) * GetCell(1, 0);
+			return myCells[0] * myCells[3] - myCells[2] * myCells[1];
 		}
-		else if constexpr (Width != 0)
+		else
 		{
+			// Laplace expansion along the first row.
 			T determinant = 0;
-			for (std::size_t i = 0; i < Width; ++i)
+			_impl::Unroll<Width>([&](auto anIndex)
 			{
-				const T factor = GetCell(i, 0);
-				const Matrix<Width - 1, Height - 1, T> subMatrix = SubMatrix(i, 0);
-
 				determinant +=
-					static_cast<T>((i % 2 == 0) ? 1 : -1) *
-					(factor * subMatrix.Determinant())
+					static_cast<T>((anIndex % 2 == 0) ? 1 : -1) *
+					(myCells[anIndex] * SubMatrix<anIndex, 0>().Determinant())
 					;
-			}
+			});
 
 			return determinant;
 		}
 	}
 
 	template <std::size_t Width, std::size_t Height, typename T>
-	constexpr std::optional<Matrix<Width, Height, T>> Matrix<Width, Height, T>::Inverse() const requires(std::is_floating_point_v<T>&& Width == Height && Width > 0)
+	constexpr std::optional<Matrix<Width, Height, T>> Matrix<Width, Height, T>::Inverse() const requires(IsFractional<T>&& Width == Height && Width > 0)
 	{
 		const T determinant = Determinant();
 		if (determinant == static_cast<T>(0))
@@ -259,25 +282,20 @@ namespace RoseCommon::Math
 		else
 		{
 			Matrix inverse = Cofactor().Transposed();
-			for (std::size_t i = 0; i < Width * Height; ++i)
-				inverse.myCells[i] *= reciprocalDeterminant;
+			_impl::Unroll<Width * Height>([&](auto anIndex) { inverse.myCells[anIndex] *= reciprocalDeterminant; });
 			return inverse;
 		}
 	}
 
 	template <std::size_t Width, std::size_t Height, typename T>
-	constexpr Matrix<Width, Height, T> Matrix<Width, Height, T>::Minor() const requires(std::is_floating_point_v<T>&& Width == Height && Width > 0)
+	constexpr Matrix<Width, Height, T> Matrix<Width, Height, T>::Minor() const requires(IsFractional<T>&& Width == Height && Width > 0)
 	{
-		Matrix solution;
+		Matrix solution{ _impl::UninitializedMatrix() };
 
-		for (std::size_t rowIndex = 0; rowIndex < Height; ++rowIndex)
+		_impl::Unroll<Width * Height>([&](auto anIndex)
 		{
-			for (std::size_t columnIndex = 0; columnIndex < Width; ++columnIndex)
-			{
-				const auto subMatrix = SubMatrix(columnIndex, rowIndex);
-				solution.GetCell(columnIndex, rowIndex) = subMatrix.Determinant();
-			}
-		}
+			solution.myCells[anIndex] = SubMatrix<anIndex % Width, anIndex / Width>().Determinant();
+		});
 
 		return solution;
 	}
@@ -285,57 +303,54 @@ namespace RoseCommon::Math
 	template <std::size_t Width, std::size_t Height, typename T>
 	constexpr Matrix<Height, Width, T> Matrix<Width, Height, T>::Transposed() const
 	{
-		Matrix<Height, Width, T> transposedMatrix;
+		Matrix<Height, Width, T> transposedMatrix{ _impl::UninitializedMatrix() };
 
-		for (std::size_t rowIndex = 0; rowIndex < Height; ++rowIndex)
+		_impl::Unroll<Width * Height>([&](auto anIndex)
 		{
-			for (std::size_t columnIndex = 0; columnIndex < Width; ++columnIndex)
-			{
-				transposedMatrix.GetCell(rowIndex, columnIndex) = GetCell(columnIndex, rowIndex);
-			}
-		}
+			constexpr std::size_t rowIndex = anIndex / Width;
+			constexpr std::size_t columnIndex = anIndex % Width;
+			transposedMatrix.myCells[(columnIndex * Height) + rowIndex] = myCells[anIndex];
+		});
 
 		return transposedMatrix;
 	}
 
 	template <std::size_t Width, std::size_t Height, typename T>
-	constexpr Matrix<Width - 1, Height - 1, T> Matrix<Width, Height, T>::SubMatrix(std::size_t aColumn, std::size_t aRow) const
+	template <std::size_t Column, std::size_t Row>
+	constexpr Matrix<Width - 1, Height - 1, T> Matrix<Width, Height, T>::SubMatrix() const
 	{
-		Matrix<Width - 1, Height - 1, T> subMatrix;
-		for (std::size_t rowIndex = 0; rowIndex < Height - 1; ++rowIndex)
+		Matrix<Width - 1, Height - 1, T> subMatrix{ _impl::UninitializedMatrix() };
+
+		_impl::Unroll<(Width - 1) * (Height - 1)>([&](auto anIndex)
 		{
-			for (std::size_t columnIndex = 0; columnIndex < Width - 1; ++columnIndex)
-			{
-				subMatrix.GetCell(columnIndex, rowIndex) =
-					GetCell(
-						columnIndex >= aColumn ? columnIndex + 1 : columnIndex,
-						rowIndex >= aRow ? rowIndex + 1 : rowIndex
-					);
-			}
-		}
+			constexpr std::size_t rowIndex = anIndex / (Width - 1);
+			constexpr std::size_t columnIndex = anIndex % (Width - 1);
+			constexpr std::size_t sourceRow = rowIndex >= Row ? rowIndex + 1 : rowIndex;
+			constexpr std::size_t sourceColumn = columnIndex >= Column ? columnIndex + 1 : columnIndex;
+
+			subMatrix.myCells[anIndex] = myCells[(sourceRow * Width) + sourceColumn];
+		});
+
 		return subMatrix;
-	};
+	}
 
 	template <std::size_t Width, std::size_t Height, typename T>
 	template <std::size_t _Width>
 	constexpr Matrix<_Width, Height, T> Matrix<Width, Height, T>::operator*(const Matrix<_Width, Width, T>& aMatrix) const
 	{
-		Matrix<_Width, Height, T> result;
+		Matrix<_Width, Height, T> result{ _impl::UninitializedMatrix() };
 
-		for (std::size_t rowIndex = 0; rowIndex < Height; ++rowIndex)
+		_impl::Unroll<_Width * Height>([&](auto anIndex)
 		{
-			for (std::size_t columnIndex = 0; columnIndex < _Width; ++columnIndex)
+			constexpr std::size_t rowIndex = anIndex / _Width;
+			constexpr std::size_t columnIndex = anIndex % _Width;
+
+			// Summed in the same order as a loop over the members would, so results don't change with the unrolling.
+			result.myCells[anIndex] = [&]<std::size_t... MemberIndices>(std::index_sequence<MemberIndices...>)
 			{
-				for (std::size_t memberIndex = 0; memberIndex < Width; ++memberIndex)
-				{
-					T& resultCell = result.GetCell(columnIndex, rowIndex);
-					const T& lhvCell = GetCell(memberIndex, rowIndex);
-					const T& rhvCell = aMatrix.GetCell(columnIndex, memberIndex);
-
-					resultCell += lhvCell * rhvCell;
-				}
-			}
-		}
+				return (static_cast<T>(0) + ... + (myCells[(rowIndex * Width) + MemberIndices] * aMatrix.myCells[(MemberIndices * _Width) + columnIndex]));
+			}(std::make_index_sequence<Width>());
+		});
 
 		return result;
 	}
@@ -343,13 +358,10 @@ namespace RoseCommon::Math
 	template <std::size_t Width, std::size_t Height, typename T>
 	constexpr bool Matrix<Width, Height, T>::operator==(const Matrix& aMatrix) const
 	{
-		for (std::size_t i = 0; i < (Width * Height); ++i)
+		return [&]<std::size_t... Indices>(std::index_sequence<Indices...>)
 		{
-			if (myCells[i] != aMatrix.myCells[i])
-				return false;
-		}
-
-		return true;
+			return ((myCells[Indices] == aMatrix.myCells[Indices]) && ...);
+		}(std::make_index_sequence<Width * Height>());
 	}
 
 	template <std::size_t Width, std::size_t Height, typename T>
@@ -357,4 +369,4 @@ namespace RoseCommon::Math
 	{
 		return !operator==(aMatrix);
 	}
-}
\ No newline at end of file
+}
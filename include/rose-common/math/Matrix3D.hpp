@@ -81,7 +81,7 @@ namespace RoseCommon::Math
 		 * @param aDefaultDirection The optional default direction, used when the object is too close to the target position.
 		 * @return The billboard matrix.
 		 */
-		static constexpr Matrix3D CreateBillboard(const Vector3<T>& anObjectPosition, const Vector3<T>& aTargetPosition, const Vector3<T>& anUpVector, const std::optional<Vector3<T>>& aDefaultDirection) requires(std::is_floating_point_v<T>);
+		static constexpr Matrix3D CreateBillboard(const Vector3<T>& anObjectPosition, const Vector3<T>& aTargetPosition, const Vector3<T>& anUpVector, const std::optional<Vector3<T>>& aDefaultDirection) requires(IsFractional<T>);
 
 		/**
 		 * @brief Create a matrix that rotates around an arbitrary axis.
@@ -89,7 +89,7 @@ namespace RoseCommon::Math
 		 * @param anAngle The amount, in radians, in which to rotate.
 		 * @return The rotation matrix.
 		 */
-		static constexpr Matrix3D CreateFromAxisAngle(const Vector3<T>& anAxis, const T& anAngle) requires(std::is_floating_point_v<T>);
+		static constexpr Matrix3D CreateFromAxisAngle(const Vector3<T>& anAxis, const T& anAngle) requires(IsFractional<T>);
 
 		/**
 		 * @brief Create a view matrix, turned towards a specific position.
@@ -98,7 +98,7 @@ namespace RoseCommon::Math
 		 * @param anUpVector The direction that is "up" from the camera's point of view.
 		 * @return The view matrix.
 		 */
-		static constexpr Matrix3D CreateLookAt(const Vector3<T>& aPosition, const Vector3<T>& aTarget, const Vector3<T>& anUpVector) requires(std::is_floating_point_v<T>);
+		static constexpr Matrix3D CreateLookAt(const Vector3<T>& aPosition, const Vector3<T>& aTarget, const Vector3<T>& anUpVector) requires(IsFractional<T>);
 
 		/**
 		 * @brief Create a projection matrix for orthographic view.
@@ -108,7 +108,7 @@ namespace RoseCommon::Math
 		 * @param aFarZPlaneDistance Distance to the far view plane.
 		 * @return The projection matrix.
 		 */
-		static constexpr Matrix3D CreateOrthographic(T aWidth, T aHeight, T aNearZPlaneDistance, T aFarZPlaneDistance) requires(std::is_floating_point_v<T>);
+		static constexpr Matrix3D CreateOrthographic(T aWidth, T aHeight, T aNearZPlaneDistance, T aFarZPlaneDistance) requires(IsFractional<T>);
 
 		/**
 		 * @brief Create a customized projection matrix for orthographic view.
@@ -120,7 +120,7 @@ namespace RoseCommon::Math
 		 * @param aFarZPlaneDistance Distance to the far view plane.
 		 * @return The projection matrix.
 		 */
-		static constexpr Matrix3D CreateOrthographicOffCenter(T aLeft, T aRight, T aBottom, T aTop, T aNearZPlaneDistance, T aFarZPlaneDistance) requires(std::is_floating_point_v<T>);
+		static constexpr Matrix3D CreateOrthographicOffCenter(T aLeft, T aRight, T aBottom, T aTop, T aNearZPlaneDistance, T aFarZPlaneDistance) requires(IsFractional<T>);
 
 		/**
 		 * @brief Create a perspective projection matrix from a given field-of-view and aspect-ratio.
@@ -130,7 +130,7 @@ namespace RoseCommon::Math
 		 * @param aFarZPlaneDistance Distance to the far view plane.
 		 * @return The projection matrix.
 		 */
-		static constexpr Matrix3D CreatePerspectiveFieldOfView(const T& aFieldOfView, const T& anAspectRatio, const T& aNearPlaneDistance, const T& aFarPlaneDistance) requires(std::is_floating_point_v<T>);
+		static constexpr Matrix3D CreatePerspectiveFieldOfView(const T& aFieldOfView, const T& anAspectRatio, const T& aNearPlaneDistance, const T& aFarPlaneDistance) requires(IsFractional<T>);
 
 		// Todo: Potentially implement CreatePerspectiveOffCenter().
 
@@ -140,28 +140,28 @@ namespace RoseCommon::Math
 		 * @param aDistance The distance of the Plane along its normal from its origin.
 		 * @return The reflection matrix.
 		 */
-		static constexpr Matrix3D CreateReflection(const Vector3<T> aPlaneNormal, const T aDistance = T(0)) requires(std::is_floating_point_v<T>);
+		static constexpr Matrix3D CreateReflection(const Vector3<T> aPlaneNormal, const T aDistance = T(0)) requires(IsFractional<T>);
 
 		/**
 		 * @brief Create a matrix that can be used to rotate a set of points around the x-axis.
 		 * @param anAngle The amount, in radians, in which to rotate.
 		 * @return The rotation matrix.
 		 */
-		static constexpr Matrix3D CreateRotationX(const T& anAngle) requires(std::is_floating_point_v<T>);
+		static constexpr Matrix3D CreateRotationX(const T& anAngle) requires(IsFractional<T>);
 
 		/**
 		 * @brief Create a matrix that can be used to rotate a set of points around the y-axis.
 		 * @param anAngle The amount, in radians, in which to rotate.
 		 * @return The rotation matrix.
 		 */
-		static constexpr Matrix3D CreateRotationY(const T& anAngle) requires(std::is_floating_point_v<T>);
+		static constexpr Matrix3D CreateRotationY(const T& anAngle) requires(IsFractional<T>);
 
 		/**
 		 * @brief Create a matrix that can be used to rotate a set of points around the z-axis.
 		 * @param anAngle The amount, in radians, in which to rotate.
 		 * @return The rotation matrix.
 		 */
-		static constexpr Matrix3D CreateRotationZ(const T& anAngle) requires(std::is_floating_point_v<T>);
+		static constexpr Matrix3D CreateRotationZ(const T& anAngle) requires(IsFractional<T>);
 
 		/**
 		 * @brief Create a scaling matrix.
@@ -170,7 +170,7 @@ namespace RoseCommon::Math
 		 * @param aZScale The Z scaling value.
 		 * @return The scaling matrix.
 		 */
-		static constexpr Matrix3D CreateScale(const T& anXScale, const T& aYScale, const T& aZScale) requires(std::is_floating_point_v<T>);
+		static constexpr Matrix3D CreateScale(const T& anXScale, const T& aYScale, const T& aZScale) requires(IsFractional<T>);
 
 		/**
 		 * @brief Create a scaling matrix with a center point.
@@ -180,14 +180,14 @@ namespace RoseCommon::Math
 		 * @param aCenterPoint The center point.
 		 * @return The scaling matrix.
 		 */
-		static constexpr Matrix3D CreateScale(const T& anXScale, const T& aYScale, const T& aZScale, const Vector3<T>& aCenterPoint) requires(std::is_floating_point_v<T>);
+		static constexpr Matrix3D CreateScale(const T& anXScale, const T& aYScale, const T& aZScale, const Vector3<T>& aCenterPoint) requires(IsFractional<T>);
 
 		/**
 		 * @brief Create a scaling matrix.
 		 * @param aScale The Vector3 containing the amount to scale by on each axis.
 		 * @return The scaling matrix.
 		 */
-		static constexpr Matrix3D CreateScale(const Vector3<T>& aScale) requires(std::is_floating_point_v<T>);
+		static constexpr Matrix3D CreateScale(const Vector3<T>& aScale) requires(IsFractional<T>);
 
 		/**
 		 * @brief Create a scaling matrix with a center point.
@@ -195,14 +195,14 @@ namespace RoseCommon::Math
 		 * @param aCenterPoint The center point.
 		 * @return The scaling matrix.
 		 */
-		static constexpr Matrix3D CreateScale(const Vector3<T>& aScale, const Vector3<T>& aCenterPoint) requires(std::is_floating_point_v<T>);
+		static constexpr Matrix3D CreateScale(const Vector3<T>& aScale, const Vector3<T>& aCenterPoint) requires(IsFractional<T>);
 
 		/**
 		 * @brief Create a scaling matrix.
 		 * @param aScale The scaling value to use for each axis.
 		 * @return The scaling matrix.
 		 */
-		static constexpr Matrix3D CreateScale(const T& aScale) requires(std::is_floating_point_v<T>);
+		static constexpr Matrix3D CreateScale(const T& aScale) requires(IsFractional<T>);
 
 		/**
 		 * @brief Create a scaling matrix with a center point.
@@ -210,7 +210,7 @@ namespace RoseCommon::Math
 		 * @param aCenterPoint The center point.
 		 * @return The scaling matrix.
 		 */
-		static constexpr Matrix3D CreateScale(const T& aScale, const Vector3<T>& aCenterPoint) requires(std::is_floating_point_v<T>);
+		static constexpr Matrix3D CreateScale(const T& aScale, const Vector3<T>& aCenterPoint) requires(IsFractional<T>);
 
 		/**
 		 * @brief Create a matrix that flattens geometry into a specified plane as if casting a shadow from a specified light source.
@@ -219,7 +219,7 @@ namespace RoseCommon::Math
 		 * @param aPlaneDistance The distance of the plane onto which the new matrix should flatten geometry.
 		 * @return The shadow matrix.
 		 */
-		static constexpr Matrix3D CreateShadow(const Vector3<T>& aLightDirection, const Vector3<T>& aPlaneNormal, T aPlaneDistance) requires(std::is_floating_point_v<T>);
+		static constexpr Matrix3D CreateShadow(const Vector3<T>& aLightDirection, const Vector3<T>& aPlaneNormal, T aPlaneDistance) requires(IsFractional<T>);
 
 		/**
 		 * @brief Create a translation matrix.
@@ -228,14 +228,14 @@ namespace RoseCommon::Math
 		 * @param aZ Value to translate on the z-axis.
 		 * @return The translation matrix.
 		 */
-		static constexpr Matrix3D CreateTranslation(const T& anX, const T& aY, const T& aZ) requires(std::is_floating_point_v<T>);
+		static constexpr Matrix3D CreateTranslation(const T& anX, const T& aY, const T& aZ) requires(IsFractional<T>);
 
 		/**
 		 * @brief Create a translation matrix.
 		 * @param aPosition The Vector3 containing the amount to translate by on each axis.
 		 * @return The translation matrix.
 		 */
-		static constexpr Matrix3D CreateTranslation(const Vector3<T>& aPosition) requires(std::is_floating_point_v<T>);
+		static constexpr Matrix3D CreateTranslation(const Vector3<T>& aPosition) requires(IsFractional<T>);
 
 		/**
 		 * @brief Create a world matrix with the specified parameters.
@@ -421,7 +421,7 @@ namespace RoseCommon::Math
 	}
 
 	template <typename T>
-	constexpr Matrix3D<T> Matrix3D<T>::CreateBillboard(const Vector3<T>& anObjectPosition, const Vector3<T>& aTargetPosition, const Vector3<T>& anUpVector, const std::optional<Vector3<T>>& aDefaultDirection) requires(std::is_floating_point_v<T>)
+	constexpr Matrix3D<T> Matrix3D<T>::CreateBillboard(const Vector3<T>& anObjectPosition, const Vector3<T>& aTargetPosition, const Vector3<T>& anUpVector, const std::optional<Vector3<T>>& aDefaultDirection) requires(IsFractional<T>)
 	{
 		constexpr T epsilon = static_cast<T>(1e-4);
 
@@ -461,7 +461,7 @@ namespace RoseCommon::Math
 	}
 
 	template <typename T>
-	constexpr Matrix3D<T> Matrix3D<T>::CreateFromAxisAngle(const Vector3<T>& anAxis, const T& anAngle) requires(std::is_floating_point_v<T>)
+	constexpr Matrix3D<T> Matrix3D<T>::CreateFromAxisAngle(const Vector3<T>& anAxis, const T& anAngle) requires(IsFractional<T>)
 	{
 		T c = Math::Cosine<T>(-anAngle);
 		T s = Math::Sine<T>(-anAngle);
@@ -493,7 +493,7 @@ namespace RoseCommon::Math
 	}
 
 	template <typename T>
-	constexpr Matrix3D<T> Matrix3D<T>::CreateLookAt(const Vector3<T>& aPosition, const Vector3<T>& aTarget, const Vector3<T>& anUpVector) requires(std::is_floating_point_v<T>)
+	constexpr Matrix3D<T> Matrix3D<T>::CreateLookAt(const Vector3<T>& aPosition, const Vector3<T>& aTarget, const Vector3<T>& anUpVector) requires(IsFractional<T>)
 	{
 		const Vector3<T> zAxis = (aTarget - aPosition).Normalized();
 		const Vector3<T> xAxis = Vector3<T>::Cross(anUpVector, zAxis).Normalized();
@@ -522,7 +522,7 @@ namespace RoseCommon::Math
 	}
 
 	template <typename T>
-	constexpr Matrix3D<T> Matrix3D<T>::CreateOrthographic(T aWidth, T aHeight, T aNearZPlaneDistance, T aFarZPlaneDistance) requires(std::is_floating_point_v<T>)
+	constexpr Matrix3D<T> Matrix3D<T>::CreateOrthographic(T aWidth, T aHeight, T aNearZPlaneDistance, T aFarZPlaneDistance) requires(IsFractional<T>)
 	{
 		Matrix3D result;
 
@@ -535,7 +535,7 @@ namespace RoseCommon::Math
 	}
 
 	template <typename T>
-	constexpr Matrix3D<T> Matrix3D<T>::CreateOrthographicOffCenter(T aLeft, T aRight, T aBottom, T aTop, T aNearZPlaneDistance, T aFarZPlaneDistance) requires(std::is_floating_point_v<T>)
+	constexpr Matrix3D<T> Matrix3D<T>::CreateOrthographicOffCenter(T aLeft, T aRight, T aBottom, T aTop, T aNearZPlaneDistance, T aFarZPlaneDistance) requires(IsFractional<T>)
 	{
 		throw std::exception("Needs chirality confirmation."); // See top of file for details.
 
@@ -554,7 +554,7 @@ namespace RoseCommon::Math
 	}
 
 	template <typename T>
-	constexpr Matrix3D<T> Matrix3D<T>::CreatePerspectiveFieldOfView(const T& aFieldOfView, const T& anAspectRatio, const T& aNearPlaneDistance, const T& aFarPlaneDistance) requires(std::is_floating_point_v<T>)
+	constexpr Matrix3D<T> Matrix3D<T>::CreatePerspectiveFieldOfView(const T& aFieldOfView, const T& anAspectRatio, const T& aNearPlaneDistance, const T& aFarPlaneDistance) requires(IsFractional<T>)
 	{
 		if (aFieldOfView <= T(0) || aFieldOfView >= Math::PiT<T>)
 			throw std::out_of_range("aFieldOfView");
@@ -585,7 +585,7 @@ namespace RoseCommon::Math
 	}
 
 	template <typename T>
-	constexpr Matrix3D<T> Matrix3D<T>::CreateReflection(const Vector3<T> aPlaneNormal, const T aDistance) requires(std::is_floating_point_v<T>)
+	constexpr Matrix3D<T> Matrix3D<T>::CreateReflection(const Vector3<T> aPlaneNormal, const T aDistance) requires(IsFractional<T>)
 	{
 		throw std::exception("Needs chirality confirmation."); // See top of file for details.
 
@@ -599,31 +599,31 @@ namespace RoseCommon::Math
 
 		Matrix3D result;
 
-		result.GetCell(0, 0) = fa * a + 1.0f;
+		result.GetCell(0, 0) = fa * a + T(1);
 		result.GetCell(1, 0) = fb * a;
 		result.GetCell(2, 0) = fc * a;
-		result.GetCell(3, 0) = 0.0f;
+		result.GetCell(3, 0) = T(0);
 
 		result.GetCell(0, 1) = fa * b;
-		result.GetCell(1, 1) = fb * b + 1.0f;
+		result.GetCell(1, 1) = fb * b + T(1);
 		result.GetCell(2, 1) = fc * b;
-		result.GetCell(3, 1) = 0.0f;
+		result.GetCell(3, 1) = T(0);
 
 		result.GetCell(0, 2) = fa * c;
 		result.GetCell(1, 2) = fb * c;
-		result.GetCell(2, 2) = fc * c + 1.0f;
-		result.GetCell(3, 2) = 0.0f;
+		result.GetCell(2, 2) = fc * c + T(1);
+		result.GetCell(3, 2) = T(0);
 
 		result.GetCell(0, 3) = fa * aDistance;
 		result.GetCell(1, 3) = fb * aDistance;
 		result.GetCell(2, 3) = fc * aDistance;
-		result.GetCell(3, 3) = 1.0f;
+		result.GetCell(3, 3) = T(1);
 
 		return result;
 	}
 
 	template <typename T>
-	constexpr Matrix3D<T> Matrix3D<T>::CreateRotationX(const T& anAngle) requires(std::is_floating_point_v<T>)
+	constexpr Matrix3D<T> Matrix3D<T>::CreateRotationX(const T& anAngle) requires(IsFractional<T>)
 	{
 		T c = Math::Cosine<T>(anAngle);
 		T s = Math::Sine<T>(anAngle);
@@ -639,7 +639,7 @@ namespace RoseCommon::Math
 	}
 
 	template <typename T>
-	constexpr Matrix3D<T> Matrix3D<T>::CreateRotationY(const T& anAngle) requires(std::is_floating_point_v<T>)
+	constexpr Matrix3D<T> Matrix3D<T>::CreateRotationY(const T& anAngle) requires(IsFractional<T>)
 	{
 		T c = Math::Cosine<T>(anAngle);
 		T s = Math::Sine<T>(anAngle);
@@ -655,7 +655,7 @@ namespace RoseCommon::Math
 	}
 
 	template <typename T>
-	constexpr Matrix3D<T> Matrix3D<T>::CreateRotationZ(const T& anAngle) requires(std::is_floating_point_v<T>)
+	constexpr Matrix3D<T> Matrix3D<T>::CreateRotationZ(const T& anAngle) requires(IsFractional<T>)
 	{
 		T c = Math::Cosine<T>(anAngle);
 		T s = Math::Sine<T>(anAngle);
@@ -671,7 +671,7 @@ namespace RoseCommon::Math
 	}
 
 	template <typename T>
-	constexpr Matrix3D<T> Matrix3D<T>::CreateScale(const T& anXScale, const T& aYScale, const T& aZScale) requires(std::is_floating_point_v<T>)
+	constexpr Matrix3D<T> Matrix3D<T>::CreateScale(const T& anXScale, const T& aYScale, const T& aZScale) requires(IsFractional<T>)
 	{
 		Matrix3D result = Matrix3D::Identity();
 
@@ -683,7 +683,7 @@ namespace RoseCommon::Math
 	}
 
 	template <typename T>
-	constexpr Matrix3D<T> Matrix3D<T>::CreateScale(const T& anXScale, const T& aYScale, const T& aZScale, const Vector3<T>& aCenterPoint) requires(std::is_floating_point_v<T>)
+	constexpr Matrix3D<T> Matrix3D<T>::CreateScale(const T& anXScale, const T& aYScale, const T& aZScale, const Vector3<T>& aCenterPoint) requires(IsFractional<T>)
 	{
 		Matrix3D result = Matrix3D::Identity();
 
@@ -699,31 +699,31 @@ namespace RoseCommon::Math
 	}
 
 	template <typename T>
-	constexpr Matrix3D<T> Matrix3D<T>::CreateScale(const Vector3<T>& aScale) requires(std::is_floating_point_v<T>)
+	constexpr Matrix3D<T> Matrix3D<T>::CreateScale(const Vector3<T>& aScale) requires(IsFractional<T>)
 	{
 		return CreateScale(aScale.X, aScale.Y, aScale.Z);
 	}
 
 	template <typename T>
-	constexpr Matrix3D<T> Matrix3D<T>::CreateScale(const Vector3<T>& aScale, const Vector3<T>& aCenterPoint) requires(std::is_floating_point_v<T>)
+	constexpr Matrix3D<T> Matrix3D<T>::CreateScale(const Vector3<T>& aScale, const Vector3<T>& aCenterPoint) requires(IsFractional<T>)
 	{
 		return CreateScale(aScale.X, aScale.Y, aScale.Z, aCenterPoint);
 	}
 
 	template <typename T>
-	constexpr Matrix3D<T> Matrix3D<T>::CreateScale(const T& aScale) requires(std::is_floating_point_v<T>)
+	constexpr Matrix3D<T> Matrix3D<T>::CreateScale(const T& aScale) requires(IsFractional<T>)
 	{
 		return CreateScale(aScale, aScale, aScale);
 	}
 
 	template <typename T>
-	constexpr Matrix3D<T> Matrix3D<T>::CreateScale(const T& aScale, const Vector3<T>& aCenterPoint) requires(std::is_floating_point_v<T>)
+	constexpr Matrix3D<T> Matrix3D<T>::CreateScale(const T& aScale, const Vector3<T>& aCenterPoint) requires(IsFractional<T>)
 	{
 		return CreateScale(aScale, aScale, aScale, aCenterPoint);
 	}
 
 	template <typename T>
-	constexpr Matrix3D<T> Matrix3D<T>::CreateShadow(const Vector3<T>& aLightDirection, const Vector3<T>& aPlaneNormal, T aPlaneDistance) requires(std::is_floating_point_v<T>)
+	constexpr Matrix3D<T> Matrix3D<T>::CreateShadow(const Vector3<T>& aLightDirection, const Vector3<T>& aPlaneNormal, T aPlaneDistance) requires(IsFractional<T>)
 	{
 		throw std::exception("Needs chirality confirmation."); // See top of file for details.
 
@@ -759,7 +759,7 @@ namespace RoseCommon::Math
 	}
 
 	template <typename T>
-	constexpr Matrix3D<T> Matrix3D<T>::CreateTranslation(const T& anX, const T& aY, const T& aZ) requires(std::is_floating_point_v<T>)
+	constexpr Matrix3D<T> Matrix3D<T>::CreateTranslation(const T& anX, const T& aY, const T& aZ) requires(IsFractional<T>)
 	{
 		Matrix3D matrix = Matrix3D::Identity();
 
@@ -771,7 +771,7 @@ namespace RoseCommon::Math
 	}
 
 	template <typename T>
-	constexpr Matrix3D<T> Matrix3D<T>::CreateTranslation(const Vector3<T>& aPosition) requires(std::is_floating_point_v<T>)
+	constexpr Matrix3D<T> Matrix3D<T>::CreateTranslation(const Vector3<T>& aPosition) requires(IsFractional<T>)
 	{
 		return CreateTranslation(aPosition.X, aPosition.Y, aPosition.Z);
 	}
@@ -788,19 +788,19 @@ namespace RoseCommon::Math
 		result.GetCell(0, 0) = xAxis.X;
 		result.GetCell(1, 0) = xAxis.Y;
 		result.GetCell(2, 0) = xAxis.Z;
-		result.GetCell(3, 0) = 0.0f;
+		result.GetCell(3, 0) = T(0);
 		result.GetCell(0, 1) = yAxis.X;
 		result.GetCell(1, 1) = yAxis.Y;
 		result.GetCell(2, 1) = yAxis.Z;
-		result.GetCell(3, 1) = 0.0f;
+		result.GetCell(3, 1) = T(0);
 		result.GetCell(0, 2) = zAxis.X;
 		result.GetCell(1, 2) = zAxis.Y;
 		result.GetCell(2, 2) = zAxis.Z;
-		result.GetCell(3, 2) = 0.0f;
+		result.GetCell(3, 2) = T(0);
 		result.GetCell(0, 3) = aPosition.X;
 		result.GetCell(1, 3) = aPosition.Y;
 		result.GetCell(2, 3) = aPosition.Z;
-		result.GetCell(3, 3) = 1.0f;
+		result.GetCell(3, 3) = T(1);
 
 		return result;
 	}
@@ -940,8 +940,8 @@ namespace RoseCommon::Math
 		Vector4 translation = invertedMatrix.GetTranslation4();
 		invertedMatrix.SetTranslation4(Vector4(0, 0, 0, 1));
 
-		translation *= -1.f;
-		translation.W = 1.f;
+		translation *= T(-1);
+		translation.W = T(1);
 		invertedMatrix = invertedMatrix.Transposed();
 		translation *= invertedMatrix;
 		invertedMatrix.SetTranslation4(translation);
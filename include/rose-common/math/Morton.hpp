@@ -0,0 +1,253 @@
+#pragma once
+
+#include "../Parallel.hpp"
+#include "../Simd.hpp"
+#include "Common.hpp"
+#include "Vector.hpp"
+
+#include <cstdint>
+#include <span>
+#include <type_traits>
+
+namespace RoseCommon::Math
+{
+	/**
+	 * @brief Interleave the bits of two coordinates into a Z-order curve index.
+	 * @param anX The x-coordinate, stored in the even bits.
+	 * @param aY The y-coordinate, stored in the odd bits.
+	 * @return The 64-bit Morton code.
+	 */
+	constexpr std::uint64_t MortonEncode(std::uint32_t anX, std::uint32_t aY);
+
+	/**
+	 * @brief Interleave the bits of three coordinates into a Z-order curve index.
+	 *        Only the lowest 21 bits of each coordinate are used.
+	 * @param anX The x-coordinate, stored in every third bit starting at bit 0.
+	 * @param aY The y-coordinate, stored in every third bit starting at bit 1.
+	 * @param aZ The z-coordinate, stored in every third bit starting at bit 2.
+	 * @return The 63-bit Morton code.
+	 */
+	constexpr std::uint64_t MortonEncode(std::uint32_t anX, std::uint32_t aY, std::uint32_t aZ);
+
+	/**
+	 * @brief Interleave the bits of a two-dimensional coordinate into a Z-order curve index.
+	 */
+	constexpr std::uint64_t MortonEncode(const Vector2<std::uint32_t>& aCoordinate) { return MortonEncode(aCoordinate.X, aCoordinate.Y); }
+
+	/**
+	 * @brief Interleave the bits of a three-dimensional coordinate into a Z-order curve index. Only the lowest 21 bits of each component are used.
+	 */
+	constexpr std::uint64_t MortonEncode(const Vector3<std::uint32_t>& aCoordinate) { return MortonEncode(aCoordinate.X, aCoordinate.Y, aCoordinate.Z); }
+
+	/**
+	 * @brief Quantize a point within a rectangle to 32 bits per axis and interleave the result into a Z-order curve index.
+	 * @param aPoint The point to encode. It is clamped to the bounds.
+	 * @param aMin The lowest corner of the bounds.
+	 * @param aMax The highest corner of the bounds.
+	 * @return The 64-bit Morton code.
+	 */
+	template <typename T>
+	constexpr std::uint64_t MortonEncode(const Vector2<T>& aPoint, const Vector2<T>& aMin, const Vector2<T>& aMax);
+
+	/**
+	 * @brief Quantize a point within a box to 21 bits per axis and interleave the result into a Z-order curve index.
+	 * @param aPoint The point to encode. It is clamped to the bounds.
+	 * @param aMin The lowest corner of the bounds.
+	 * @param aMax The highest corner of the bounds.
+	 * @return The 63-bit Morton code.
+	 */
+	template <typename T>
+	constexpr std::uint64_t MortonEncode(const Vector3<T>& aPoint, const Vector3<T>& aMin, const Vector3<T>& aMax);
+
+	/**
+	 * @brief Quantize and encode many points within a rectangle, splitting the work across threads for large batches.
+	 * @param somePoints The points to encode.
+	 * @param aMin The lowest corner of the bounds.
+	 * @param aMax The highest corner of the bounds.
+	 * @param someCodes A buffer to write the code of each point into, at least as large as the point count.
+	 */
+	template <typename T>
+	void MortonEncode(std::span<const Vector2<T>> somePoints, const Vector2<T>& aMin, const Vector2<T>& aMax, std::span<std::uint64_t> someCodes);
+
+	/**
+	 * @brief Quantize and encode many points within a box, splitting the work across threads for large batches.
+	 * @param somePoints The points to encode.
+	 * @param aMin The lowest corner of the bounds.
+	 * @param aMax The highest corner of the bounds.
+	 * @param someCodes A buffer to write the code of each point into, at least as large as the point count.
+	 */
+	template <typename T>
+	void MortonEncode(std::span<const Vector3<T>> somePoints, const Vector3<T>& aMin, const Vector3<T>& aMax, std::span<std::uint64_t> someCodes);
+
+	/**
+	 * @brief Extract the two coordinates interleaved in a Morton code.
+	 * @param aCode A code created by the two-dimensional MortonEncode.
+	 */
+	constexpr Vector2<std::uint32_t> MortonDecode2D(std::uint64_t aCode);
+
+	/**
+	 * @brief Extract the three coordinates interleaved in a Morton code.
+	 * @param aCode A code created by the three-dimensional MortonEncode.
+	 */
+	constexpr Vector3<std::uint32_t> MortonDecode3D(std::uint64_t aCode);
+}
+
+namespace RoseCommon::Math
+{
+	namespace _impl
+	{
+		constexpr std::uint64_t MortonMask2D = 0x5555555555555555ull;
+		constexpr std::uint64_t MortonMask3D = 0x1249249249249249ull;
+
+		constexpr std::uint64_t MortonSpread2D(std::uint64_t aValue)
+		{
+			aValue &= 0x00000000FFFFFFFFull;
+			aValue = (aValue | (aValue << 16)) & 0x0000FFFF0000FFFFull;
+			aValue = (aValue | (aValue << 8)) & 0x00FF00FF00FF00FFull;
+			aValue = (aValue | (aValue << 4)) & 0x0F0F0F0F0F0F0F0Full;
+			aValue = (aValue | (aValue << 2)) & 0x3333333333333333ull;
+			aValue = (aValue | (aValue << 1)) & 0x5555555555555555ull;
+			return aValue;
+		}
+
+		constexpr std::uint32_t MortonCompact2D(std::uint64_t aValue)
+		{
+			aValue &= 0x5555555555555555ull;
+			aValue = (aValue | (aValue >> 1)) & 0x3333333333333333ull;
+			aValue = (aValue | (aValue >> 2)) & 0x0F0F0F0F0F0F0F0Full;
+			aValue = (aValue | (aValue >> 4)) & 0x00FF00FF00FF00FFull;
+			aValue = (aValue | (aValue >> 8)) & 0x0000FFFF0000FFFFull;
+			aValue = (aValue | (aValue >> 16)) & 0x00000000FFFFFFFFull;
+			return static_cast<std::uint32_t>(aValue);
+		}
+
+		constexpr std::uint64_t MortonSpread3D(std::uint64_t aValue)
+		{
+			aValue &= 0x00000000001FFFFFull;
+			aValue = (aValue | (aValue << 32)) & 0x001F00000000FFFFull;
+			aValue = (aValue | (aValue << 16)) & 0x001F0000FF0000FFull;
+			aValue = (aValue | (aValue << 8)) & 0x100F00F00F00F00Full;
+			aValue = (aValue | (aValue << 4)) & 0x10C30C30C30C30C3ull;
+			aValue = (aValue | (aValue << 2)) & 0x1249249249249249ull;
+			return aValue;
+		}
+
+		constexpr std::uint32_t MortonCompact3D(std::uint64_t aValue)
+		{
+			aValue &= 0x1249249249249249ull;
+			aValue = (aValue | (aValue >> 2)) & 0x10C30C30C30C30C3ull;
+			aValue = (aValue | (aValue >> 4)) & 0x100F00F00F00F00Full;
+			aValue = (aValue | (aValue >> 8)) & 0x001F0000FF0000FFull;
+			aValue = (aValue | (aValue >> 16)) & 0x001F00000000FFFFull;
+			aValue = (aValue | (aValue >> 32)) & 0x00000000001FFFFFull;
+			return static_cast<std::uint32_t>(aValue);
+		}
+
+		template <typename T>
+		constexpr std::uint32_t MortonQuantize(T aValue, T aMin, T aMax, double aScale)
+		{
+			if (!(aMax > aMin))
+				return 0;
+
+			const double normalized = Math::Clamp<double>(static_cast<double>(aValue - aMin) / static_cast<double>(aMax - aMin), 0.0, 1.0);
+			return static_cast<std::uint32_t>(normalized * aScale);
+		}
+
+		template <typename Vector, typename Function>
+		void MortonEncodeBatch(std::span<const Vector> somePoints, std::span<std::uint64_t> someCodes, Function&& anEncoder)
+		{
+			constexpr std::size_t grainSize = 1 << 16;
+
+			Parallel::ForEachChunk(somePoints.size(), Parallel::GetChunkCount(somePoints.size(), grainSize),
+				[&](std::size_t, std::size_t aBegin, std::size_t anEnd)
+				{
+					for (std::size_t i = aBegin; i < anEnd; ++i)
+						someCodes[i] = anEncoder(somePoints[i]);
+				});
+		}
+	}
+
+	constexpr std::uint64_t MortonEncode(std::uint32_t anX, std::uint32_t aY)
+	{
+#if defined(ROSECOMMON_SIMD_BMI2)
+		if (!std::is_constant_evaluated())
+			return _pdep_u64(anX, _impl::MortonMask2D) | _pdep_u64(aY, _impl::MortonMask2D << 1);
+#endif
+
+		return _impl::MortonSpread2D(anX) | (_impl::MortonSpread2D(aY) << 1);
+	}
+
+	constexpr std::uint64_t MortonEncode(std::uint32_t anX, std::uint32_t aY, std::uint32_t aZ)
+	{
+#if defined(ROSECOMMON_SIMD_BMI2)
+		if (!std::is_constant_evaluated())
+			return _pdep_u64(anX, _impl::MortonMask3D) | _pdep_u64(aY, _impl::MortonMask3D << 1) | _pdep_u64(aZ, _impl::MortonMask3D << 2);
+#endif
+
+		return _impl::MortonSpread3D(anX) | (_impl::MortonSpread3D(aY) << 1) | (_impl::MortonSpread3D(aZ) << 2);
+	}
+
+	template <typename T>
+	constexpr std::uint64_t MortonEncode(const Vector2<T>& aPoint, const Vector2<T>& aMin, const Vector2<T>& aMax)
+	{
+		constexpr double scale = 4294967295.0;
+		return MortonEncode(
+			_impl::MortonQuantize<T>(aPoint.X, aMin.X, aMax.X, scale),
+			_impl::MortonQuantize<T>(aPoint.Y, aMin.Y, aMax.Y, scale)
+		);
+	}
+
+	template <typename T>
+	constexpr std::uint64_t MortonEncode(const Vector3<T>& aPoint, const Vector3<T>& aMin, const Vector3<T>& aMax)
+	{
+		constexpr double scale = 2097151.0;
+		return MortonEncode(
+			_impl::MortonQuantize<T>(aPoint.X, aMin.X, aMax.X, scale),
+			_impl::MortonQuantize<T>(aPoint.Y, aMin.Y, aMax.Y, scale),
+			_impl::MortonQuantize<T>(aPoint.Z, aMin.Z, aMax.Z, scale)
+		);
+	}
+
+	template <typename T>
+	void MortonEncode(std::span<const Vector2<T>> somePoints, const Vector2<T>& aMin, const Vector2<T>& aMax, std::span<std::uint64_t> someCodes)
+	{
+		_impl::MortonEncodeBatch(somePoints, someCodes, [&](const Vector2<T>& aPoint) { return MortonEncode<T>(aPoint, aMin, aMax); });
+	}
+
+	template <typename T>
+	void MortonEncode(std::span<const Vector3<T>> somePoints, const Vector3<T>& aMin, const Vector3<T>& aMax, std::span<std::uint64_t> someCodes)
+	{
+		_impl::MortonEncodeBatch(somePoints, someCodes, [&](const Vector3<T>& aPoint) { return MortonEncode<T>(aPoint, aMin, aMax); });
+	}
+
+	constexpr Vector2<std::uint32_t> MortonDecode2D(std::uint64_t aCode)
+	{
+#if defined(ROSECOMMON_SIMD_BMI2)
+		if (!std::is_constant_evaluated())
+		{
+			return Vector2<std::uint32_t>(
+				static_cast<std::uint32_t>(_pext_u64(aCode, _impl::MortonMask2D)),
+				static_cast<std::uint32_t>(_pext_u64(aCode, _impl::MortonMask2D << 1))
+			);
+		}
+#endif
+
+		return Vector2<std::uint32_t>(_impl::MortonCompact2D(aCode), _impl::MortonCompact2D(aCode >> 1));
+	}
+
+	constexpr Vector3<std::uint32_t> MortonDecode3D(std::uint64_t aCode)
+	{
+#if defined(ROSECOMMON_SIMD_BMI2)
+		if (!std::is_constant_evaluated())
+		{
+			return Vector3<std::uint32_t>(
+				static_cast<std::uint32_t>(_pext_u64(aCode, _impl::MortonMask3D)),
+				static_cast<std::uint32_t>(_pext_u64(aCode, _impl::MortonMask3D << 1)),
+				static_cast<std::uint32_t>(_pext_u64(aCode, _impl::MortonMask3D << 2))
+			);
+		}
+#endif
+
+		return Vector3<std::uint32_t>(_impl::MortonCompact3D(aCode), _impl::MortonCompact3D(aCode >> 1), _impl::MortonCompact3D(aCode >> 2));
+	}
+}
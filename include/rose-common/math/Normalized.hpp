@@ -0,0 +1,293 @@
+#pragma once
+
+#include "../Color.hpp"
+#include "../Parallel.hpp"
+#include "../Simd.hpp"
+
+#include <compare>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <type_traits>
+
+namespace RoseCommon::Math
+{
+	/**
+	 * @brief A fixed-point number stored as an integer that maps its full range onto 0 - 1 if unsigned, or -1 - 1 if signed.
+	 *        Converting from other values clamps to that range and rounds to nearest, with halves rounded away from zero.
+	 *        Arithmetic is done in single precision and converted back.
+	 * @tparam Storage The 8 or 16-bit integer type to store the value in.
+	 */
+	template <typename Storage>
+	class Normalized
+	{
+		static_assert(std::is_integral_v<Storage> && !std::is_same_v<Storage, bool>, "Normalized values are stored in integers.");
+		static_assert(sizeof(Storage) <= 2, "Normalized values are stored in 8 or 16 bits, so that every stored integer is exact in single precision.");
+
+	public:
+
+		//--------------------------------------------------
+		// * Static constants
+		//--------------------------------------------------
+		#pragma region Static constants
+
+		/**
+		 * @brief The stored integer which represents one.
+		 */
+		static constexpr Storage One = std::numeric_limits<Storage>::max();
+
+		/**
+		 * @brief The lowest value, being zero for unsigned storage and minus one for signed storage.
+		 */
+		static constexpr float Lowest = std::is_signed_v<Storage> ? -1.f : 0.f;
+
+		#pragma endregion
+
+		//--------------------------------------------------
+		// * Construction
+		//--------------------------------------------------
+		#pragma region Construction
+
+		/**
+		 * @brief Initialize to zero.
+		 */
+		constexpr Normalized() = default;
+
+		/**
+		 * @brief Initialize to the nearest representable value.
+		 * @param aValue The value to convert, which is clamped to the representable range.
+		 */
+		template <typename T> requires(std::is_arithmetic_v<T>)
+		constexpr Normalized(T aValue) : myValue(FromFloat(static_cast<float>(aValue))) { }
+
+		/**
+		 * @brief Create a value from its stored integer.
+		 * @param aValue The stored integer, where the largest value of the storage type represents one.
+		 */
+		static constexpr Normalized FromStorage(Storage aValue);
+
+		#pragma endregion
+
+		//--------------------------------------------------
+		// * Properties
+		//--------------------------------------------------
+		#pragma region Properties
+
+		/**
+		 * @brief Get the stored integer.
+		 */
+		constexpr Storage GetStorage() const { return myValue; }
+
+		#pragma endregion
+
+		//--------------------------------------------------
+		// * Methods
+		//--------------------------------------------------
+		#pragma region Methods
+
+		/**
+		 * @brief Convert the value to single precision.
+		 */
+		constexpr float ToFloat() const;
+
+		#pragma endregion
+
+		//--------------------------------------------------
+		// * Operators
+		//--------------------------------------------------
+		#pragma region Operators
+
+		template <typename T> requires(std::is_arithmetic_v<T>)
+		explicit constexpr operator T() const { return static_cast<T>(ToFloat()); }
+
+		constexpr Normalized operator-() const { return -ToFloat(); }
+
+		friend constexpr Normalized operator+(Normalized aValue, Normalized anOther) { return aValue.ToFloat() + anOther.ToFloat(); }
+		friend constexpr Normalized operator-(Normalized aValue, Normalized anOther) { return aValue.ToFloat() - anOther.ToFloat(); }
+		friend constexpr Normalized operator*(Normalized aValue, Normalized anOther) { return aValue.ToFloat() * anOther.ToFloat(); }
+		friend constexpr Normalized operator/(Normalized aValue, Normalized anOther) { return aValue.ToFloat() / anOther.ToFloat(); }
+
+		constexpr Normalized& operator+=(Normalized aValue) { return *this = *this + aValue; }
+		constexpr Normalized& operator-=(Normalized aValue) { return *this = *this - aValue; }
+		constexpr Normalized& operator*=(Normalized aValue) { return *this = *this * aValue; }
+		constexpr Normalized& operator/=(Normalized aValue) { return *this = *this / aValue; }
+
+		friend constexpr bool operator==(Normalized aValue, Normalized anOther) { return aValue.ToFloat() == anOther.ToFloat(); }
+		friend constexpr std::partial_ordering operator<=>(Normalized aValue, Normalized anOther) { return aValue.ToFloat() <=> anOther.ToFloat(); }
+
+		#pragma endregion
+
+	private:
+		static constexpr Storage FromFloat(float aValue);
+
+		Storage myValue = 0;
+	};
+
+	/**
+	 * @brief An 8-bit value in range 0 - 1.
+	 */
+	using Unorm8 = Normalized<std::uint8_t>;
+
+	/**
+	 * @brief A 16-bit value in range 0 - 1.
+	 */
+	using Unorm16 = Normalized<std::uint16_t>;
+
+	/**
+	 * @brief An 8-bit value in range -1 - 1.
+	 */
+	using Snorm8 = Normalized<std::int8_t>;
+
+	/**
+	 * @brief A 16-bit value in range -1 - 1.
+	 */
+	using Snorm16 = Normalized<std::int16_t>;
+
+	/**
+	 * @brief Convert normalized values to single precision. Unorm8 and Snorm16 are converted 16 and 8 at a time with SSE2.
+	 * @param someValues The values to convert.
+	 * @param someResults A buffer for the converted values, at least as large as the input.
+	 */
+	template <typename Storage>
+	void ConvertToFloat(std::span<const Normalized<Storage>> someValues, std::span<float> someResults);
+
+	/**
+	 * @brief Convert single-precision values to normalized values. Unorm8 and Snorm16 are converted 16 and 8 at a time with SSE2.
+	 * @param someValues The values to convert, which are clamped to the representable range.
+	 * @param someResults A buffer for the converted values, at least as large as the input.
+	 */
+	template <typename Storage>
+	void ConvertFromFloat(std::span<const float> someValues, std::span<Normalized<Storage>> someResults);
+}
+
+namespace RoseCommon
+{
+	template <typename Storage>
+	inline constexpr bool IsNormalizedColorComponent<Math::Normalized<Storage>> = true;
+}
+
+namespace RoseCommon::Math
+{
+	template <typename Storage>
+	constexpr Normalized<Storage> Normalized<Storage>::FromStorage(Storage aValue)
+	{
+		Normalized value;
+		value.myValue = aValue;
+		return value;
+	}
+
+	template <typename Storage>
+	constexpr float Normalized<Storage>::ToFloat() const
+	{
+		const float value = static_cast<float>(myValue) * (1.f / One);
+
+		// Signed storage has one more negative value than positive, which also maps to minus one.
+		if constexpr (std::is_signed_v<Storage>)
+			return value < -1.f ? -1.f : value;
+		else
+			return value;
+	}
+
+	template <typename Storage>
+	constexpr Storage Normalized<Storage>::FromFloat(float aValue)
+	{
+		// Written so that NaN falls through to the lowest value.
+		const float clamped = aValue > Lowest ? (aValue < 1.f ? aValue : 1.f) : Lowest;
+		const float scaled = clamped * One;
+		return static_cast<Storage>(scaled < 0.f ? scaled - 0.5f : scaled + 0.5f);
+	}
+
+	namespace _impl
+	{
+#if defined(ROSECOMMON_SIMD_SSE2)
+		// Clamp, scale and round away from zero like Normalized::FromFloat(), giving 32-bit integers.
+		template <typename Storage>
+		inline __m128i QuantizeNormalized(__m128 someValues)
+		{
+			const __m128 lowest = _mm_set1_ps(Normalized<Storage>::Lowest);
+			const __m128 scaled = _mm_mul_ps(_mm_min_ps(_mm_max_ps(someValues, lowest), _mm_set1_ps(1.f)), _mm_set1_ps(Normalized<Storage>::One));
+			const __m128 half = _mm_or_ps(_mm_and_ps(scaled, _mm_set1_ps(-0.f)), _mm_set1_ps(0.5f));
+			return _mm_cvttps_epi32(_mm_add_ps(scaled, half));
+		}
+#endif
+	}
+
+	template <typename Storage>
+	void ConvertToFloat(std::span<const Normalized<Storage>> someValues, std::span<float> someResults)
+	{
+		Parallel::ForEachChunk(someValues.size(), Parallel::GetChunkCount(someValues.size(), 1 << 16), [&](std::size_t, std::size_t aBegin, std::size_t anEnd)
+		{
+			std::size_t i = aBegin;
+
+#if defined(ROSECOMMON_SIMD_SSE2)
+			const __m128 scale = _mm_set1_ps(1.f / Normalized<Storage>::One);
+
+			if constexpr (std::is_same_v<Storage, std::uint8_t>)
+			{
+				const __m128i zero = _mm_setzero_si128();
+				for (; i + 16 <= anEnd; i += 16)
+				{
+					const __m128i values = _mm_loadu_si128(reinterpret_cast<const __m128i*>(someValues.data() + i));
+					const __m128i low = _mm_unpacklo_epi8(values, zero);
+					const __m128i high = _mm_unpackhi_epi8(values, zero);
+					_mm_storeu_ps(someResults.data() + i + 0, _mm_mul_ps(_mm_cvtepi32_ps(_mm_unpacklo_epi16(low, zero)), scale));
+					_mm_storeu_ps(someResults.data() + i + 4, _mm_mul_ps(_mm_cvtepi32_ps(_mm_unpackhi_epi16(low, zero)), scale));
+					_mm_storeu_ps(someResults.data() + i + 8, _mm_mul_ps(_mm_cvtepi32_ps(_mm_unpacklo_epi16(high, zero)), scale));
+					_mm_storeu_ps(someResults.data() + i + 12, _mm_mul_ps(_mm_cvtepi32_ps(_mm_unpackhi_epi16(high, zero)), scale));
+				}
+			}
+			else if constexpr (std::is_same_v<Storage, std::int16_t>)
+			{
+				const __m128 lowest = _mm_set1_ps(-1.f);
+				for (; i + 8 <= anEnd; i += 8)
+				{
+					// Sign-extend by placing each value in the upper half of a 32-bit lane and shifting it back down.
+					const __m128i values = _mm_loadu_si128(reinterpret_cast<const __m128i*>(someValues.data() + i));
+					const __m128i low = _mm_srai_epi32(_mm_unpacklo_epi16(values, values), 16);
+					const __m128i high = _mm_srai_epi32(_mm_unpackhi_epi16(values, values), 16);
+					_mm_storeu_ps(someResults.data() + i + 0, _mm_max_ps(_mm_mul_ps(_mm_cvtepi32_ps(low), scale), lowest));
+					_mm_storeu_ps(someResults.data() + i + 4, _mm_max_ps(_mm_mul_ps(_mm_cvtepi32_ps(high), scale), lowest));
+				}
+			}
+#endif
+
+			for (; i < anEnd; ++i)
+				someResults[i] = someValues[i].ToFloat();
+		});
+	}
+
+	template <typename Storage>
+	void ConvertFromFloat(std::span<const float> someValues, std::span<Normalized<Storage>> someResults)
+	{
+		Parallel::ForEachChunk(someValues.size(), Parallel::GetChunkCount(someValues.size(), 1 << 16), [&](std::size_t, std::size_t aBegin, std::size_t anEnd)
+		{
+			std::size_t i = aBegin;
+
+#if defined(ROSECOMMON_SIMD_SSE2)
+			if constexpr (std::is_same_v<Storage, std::uint8_t>)
+			{
+				for (; i + 16 <= anEnd; i += 16)
+				{
+					const __m128i values0 = _impl::QuantizeNormalized<Storage>(_mm_loadu_ps(someValues.data() + i + 0));
+					const __m128i values1 = _impl::QuantizeNormalized<Storage>(_mm_loadu_ps(someValues.data() + i + 4));
+					const __m128i values2 = _impl::QuantizeNormalized<Storage>(_mm_loadu_ps(someValues.data() + i + 8));
+					const __m128i values3 = _impl::QuantizeNormalized<Storage>(_mm_loadu_ps(someValues.data() + i + 12));
+					_mm_storeu_si128(reinterpret_cast<__m128i*>(someResults.data() + i), _mm_packus_epi16(_mm_packs_epi32(values0, values1), _mm_packs_epi32(values2, values3)));
+				}
+			}
+			else if constexpr (std::is_same_v<Storage, std::int16_t>)
+			{
+				for (; i + 8 <= anEnd; i += 8)
+				{
+					const __m128i values0 = _impl::QuantizeNormalized<Storage>(_mm_loadu_ps(someValues.data() + i + 0));
+					const __m128i values1 = _impl::QuantizeNormalized<Storage>(_mm_loadu_ps(someValues.data() + i + 4));
+					_mm_storeu_si128(reinterpret_cast<__m128i*>(someResults.data() + i), _mm_packs_epi32(values0, values1));
+				}
+			}
+#endif
+
+			for (; i < anEnd; ++i)
+				someResults[i] = someValues[i];
+		});
+	}
+}
@@ -0,0 +1,1210 @@
+#pragma once
+
+#include "Geometry.hpp"
+#include "Morton.hpp"
+#include "Vector.hpp"
+
+#include "../Parallel.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <type_traits>
+#include <vector>
+
+/*
+ * Polygon operations on spans of Vector2, for large inputs such as map data.
+ *
+ * Polygons are lists of vertices with an implied edge from the last vertex back to the first.
+ * Results are written to caller-owned vectors, which are cleared and refilled while keeping their capacity,
+ * so calls that reuse the same vectors stop allocating once those have grown to fit.
+ */
+namespace RoseCommon::Math::Polygon
+{
+	namespace _impl
+	{
+		template <typename T>
+		struct EarNode
+		{
+			Vector2<T> Position;
+			std::uint64_t Z;
+			std::uint32_t Index;
+			std::uint32_t Previous, Next;
+			std::uint32_t PreviousZ, NextZ;
+			std::uint32_t QueuePosition;
+		};
+
+		template <typename T>
+		struct SweepVertex
+		{
+			Vector2<T> Position;
+			std::uint32_t Index;
+			std::uint32_t Rank;
+			std::uint32_t Helper;
+			std::uint32_t TreeLeft, TreeRight;
+			std::uint32_t FirstLink;
+			bool IsMerge;
+			bool IsOnLeftChain;
+		};
+
+		struct SweepLink
+		{
+			std::uint32_t Vertex;
+			bool IsTraced;
+		};
+	}
+
+	/**
+	 * @brief Reusable buffers for Triangulate(), so repeated calls stop allocating once they have grown large enough.
+	 */
+	template <typename T>
+	struct TriangulationScratch
+	{
+		std::vector<_impl::EarNode<T>> Nodes;
+		std::vector<_impl::SweepVertex<T>> Vertices;
+		std::vector<_impl::SweepLink> Links;
+		std::vector<std::uint32_t> Order;
+		std::vector<std::uint32_t> Diagonals;
+		std::vector<std::uint32_t> Piece;
+		std::vector<std::uint32_t> Stack;
+	};
+
+	/**
+	 * @brief Calculate the signed area of a polygon, which is positive for counter-clockwise vertices in a coordinate system with Y pointing up.
+	 * @param somePolygon The vertices of the polygon.
+	 * @return The signed area.
+	 */
+	template <typename T>
+	constexpr T SignedArea(std::span<const Vector2<T>> somePolygon);
+
+	/**
+	 * @brief Find the convex hull of a set of points, using Andrew's monotone chain algorithm.
+	 *        Large inputs are split into chunks whose hulls are found in parallel, and the hull of those is the result.
+	 * @param somePoints The points to find the hull of.
+	 * @param outHull Receives the hull vertices with a positive signed area, without collinear points.
+	 * @param aScratch A buffer which is resized to three times the point count.
+	 */
+	template <typename T>
+	void ConvexHull(std::span<const Vector2<std::type_identity_t<T>>> somePoints, std::vector<Vector2<T>>& outHull, std::vector<Vector2<T>>& aScratch);
+
+	/**
+	 * @brief Clip a polygon against a rectangle, using the Sutherland-Hodgman algorithm.
+	 *        Convex polygons give exact results. Concave polygons that are split in several pieces by the rectangle stay as one polygon,
+	 *        with the pieces connected by zero-area edges along the rectangle sides, which fill and triangulate to the correct area.
+	 * @param somePolygon The vertices of the polygon.
+	 * @param aRectangle The rectangle to clip against.
+	 * @param outPolygon Receives the clipped polygon, which is empty if nothing was inside.
+	 * @param aScratch A buffer for the intermediate results.
+	 */
+	template <typename T>
+	void ClipToRectangle(std::span<const Vector2<std::type_identity_t<T>>> somePolygon, const Rectangle<T>& aRectangle, std::vector<Vector2<T>>& outPolygon, std::vector<Vector2<T>>& aScratch);
+
+	/**
+	 * @brief Triangulate a simple polygon, in either winding order.
+	 *        Large polygons are split into y-monotone pieces by a sweep line, which takes O(n log n) time whatever their shape.
+	 *        Small polygons, and those the sweep finds not to be simple such as the zero-area edges left by ClipToRectangle(), are triangulated by ear clipping instead.
+	 *        That keeps its vertices in Morton order so ear tests only look at nearby vertices, but can still take quadratic time on strongly non-convex input.
+	 * @param somePolygon The vertices of the polygon.
+	 * @param outIndices Receives three vertex indices per triangle, with a positive signed area.
+	 * @param aScratch Buffers for the vertex links and the sweep.
+	 * @return Whether the whole polygon was triangulated. Self-intersecting polygons can leave parts which have no ear to clip.
+	 */
+	template <typename T>
+	bool Triangulate(std::span<const Vector2<std::type_identity_t<T>>> somePolygon, std::vector<std::uint32_t>& outIndices, TriangulationScratch<T>& aScratch);
+}
+
+namespace RoseCommon::Math::Polygon
+{
+	namespace _impl
+	{
+		constexpr std::uint32_t NoNode = std::numeric_limits<std::uint32_t>::max();
+
+		// Above this many vertices the ear tests use the Morton order, below it a plain walk around the polygon is faster.
+		constexpr std::size_t MortonThreshold = 80;
+
+		// Above this many vertices polygons are triangulated by the sweep, below it ear clipping is faster.
+		constexpr std::size_t SweepThreshold = 80;
+
+		// The hulls of at most this many chunks are merged, which limits the per-chunk bookkeeping to a fixed-size array.
+		constexpr std::size_t MaxHullChunks = 64;
+
+		// Twice the signed area of the triangle, positive when the vertices turn counter-clockwise.
+		template <typename T>
+		constexpr T Cross(const Vector2<T>& anOrigin, const Vector2<T>& aPointA, const Vector2<T>& aPointB)
+		{
+			return (aPointA.X - anOrigin.X) * (aPointB.Y - anOrigin.Y) - (aPointA.Y - anOrigin.Y) * (aPointB.X - anOrigin.X);
+		}
+
+		// Exact comparison, as the predicates below need to agree with each other rather than tolerate rounding.
+		template <typename T>
+		constexpr bool IsSamePoint(const Vector2<T>& aPoint, const Vector2<T>& anOther)
+		{
+			return aPoint.X == anOther.X && aPoint.Y == anOther.Y;
+		}
+
+		template <typename T>
+		constexpr bool IsLexicographicallyLess(const Vector2<T>& aPoint, const Vector2<T>& anOther)
+		{
+			return aPoint.X < anOther.X || (aPoint.X == anOther.X && aPoint.Y < anOther.Y);
+		}
+
+		// Monotone chain over sorted points, writing at most twice the point count. Returns the hull size.
+		template <typename T>
+		std::size_t MonotoneChain(const Vector2<T>* someSortedPoints, std::size_t aCount, Vector2<T>* outHull)
+		{
+			if (aCount < 3)
+			{
+				std::size_t hullSize = 0;
+				for (std::size_t i = 0; i < aCount; ++i)
+				{
+					if (hullSize == 0 || !IsSamePoint(someSortedPoints[i], outHull[hullSize - 1]))
+						outHull[hullSize++] = someSortedPoints[i];
+				}
+				return hullSize;
+			}
+
+			std::size_t hullSize = 0;
+
+			for (std::size_t i = 0; i < aCount; ++i)
+			{
+				while (hullSize >= 2 && Cross(outHull[hullSize - 2], outHull[hullSize - 1], someSortedPoints[i]) <= T(0))
+					--hullSize;
+				outHull[hullSize++] = someSortedPoints[i];
+			}
+
+			const std::size_t lowerSize = hullSize + 1;
+			for (std::size_t i = aCount - 1; i-- > 0;)
+			{
+				while (hullSize >= lowerSize && Cross(outHull[hullSize - 2], outHull[hullSize - 1], someSortedPoints[i]) <= T(0))
+					--hullSize;
+				outHull[hullSize++] = someSortedPoints[i];
+			}
+
+			// The last point is the first one again. When all points are the same, so is the one before that.
+			if (hullSize == 3 && IsSamePoint(outHull[0], outHull[1]))
+				return 1;
+
+			return hullSize - 1;
+		}
+
+		// One Sutherland-Hodgman pass, keeping the side of an axis-aligned line where the coordinate is at least (or at most) the bound.
+		template <typename T, bool IsXAxis, bool IsMinimum>
+		void ClipToAxis(std::span<const Vector2<T>> somePolygon, T aBound, std::vector<Vector2<T>>& outPolygon)
+		{
+			outPolygon.clear();
+			if (somePolygon.empty())
+				return;
+
+			outPolygon.reserve(somePolygon.size() * 2);
+
+			const auto coordinate = [](const Vector2<T>& aPoint) { return IsXAxis ? aPoint.X : aPoint.Y; };
+			const auto isInside = [&](const Vector2<T>& aPoint) { return IsMinimum ? coordinate(aPoint) >= aBound : coordinate(aPoint) <= aBound; };
+
+			Vector2<T> previous = somePolygon.back();
+			bool isPreviousInside = isInside(previous);
+
+			for (const Vector2<T>& current : somePolygon)
+			{
+				const bool isCurrentInside = isInside(current);
+				if (isCurrentInside != isPreviousInside)
+				{
+					const T amount = (aBound - coordinate(previous)) / (coordinate(current) - coordinate(previous));
+					if constexpr (IsXAxis)
+						outPolygon.push_back(Vector2<T>(aBound, previous.Y + (current.Y - previous.Y) * amount));
+					else
+						outPolygon.push_back(Vector2<T>(previous.X + (current.X - previous.X) * amount, aBound));
+				}
+
+				if (isCurrentInside)
+					outPolygon.push_back(current);
+
+				previous = current;
+				isPreviousInside = isCurrentInside;
+			}
+		}
+
+		/**
+		 * @brief Ear clipping over a circular doubly linked list of polygon vertices, with a second list in Morton order for large polygons.
+		 */
+		template <typename T>
+		class EarClipper
+		{
+		public:
+			EarClipper(std::vector<EarNode<T>>& someNodes, std::vector<std::uint32_t>& aQueue, std::vector<std::uint32_t>& someIndices)
+				: myNodes(someNodes)
+				, myQueue(aQueue)
+				, myIndices(someIndices)
+			{
+
+			}
+
+			// Use the Morton links for the ear tests, with codes relative to the bounds of the polygon.
+			void SetMortonBounds(const Vector2<T>& aMinimum, const Vector2<T>& aMaximum)
+			{
+				myUseMorton = true;
+				myMinimum = aMinimum;
+				myMaximum = aMaximum;
+			}
+
+			std::uint64_t GetMortonCode(const Vector2<T>& aPosition) const
+			{
+				return Math::MortonEncode(aPosition, myMinimum, myMaximum);
+			}
+
+			// Clip ears from a queue of candidates. A vertex only becomes an ear when a neighbour is clipped, so only those are queued again,
+			// and runs of reflex vertices aren't walked over and over. Queuing both neighbours at the back also skips ahead after each clip,
+			// which makes for fewer sliver triangles. Rare cases the queue misses, like the removal of a vertex blocking an ear, are found by rescanning.
+			bool Run(std::uint32_t aStart)
+			{
+				std::uint32_t start = aStart;
+				int pass = 0;
+
+				while (true)
+				{
+					std::size_t clippedCount = 0;
+
+					myQueue.clear();
+					std::uint32_t node = start;
+					do
+					{
+						Enqueue(node);
+						node = myNodes[node].Next;
+					} while (node != start);
+
+					for (std::size_t head = 0; head < myQueue.size(); ++head)
+					{
+						const std::uint32_t ear = myQueue[head];
+						if (myNodes[ear].QueuePosition != head)
+							continue;
+
+						const std::uint32_t previous = myNodes[ear].Previous;
+						const std::uint32_t next = myNodes[ear].Next;
+						if (previous == next)
+							return true;
+
+						if (!IsEar(ear))
+							continue;
+
+						myIndices.push_back(myNodes[previous].Index);
+						myIndices.push_back(myNodes[ear].Index);
+						myIndices.push_back(myNodes[next].Index);
+
+						Remove(ear);
+						Enqueue(previous);
+						Enqueue(next);
+						start = next;
+						++clippedCount;
+					}
+
+					if (myNodes[start].Previous == myNodes[start].Next)
+						return true;
+
+					if (clippedCount > 0)
+						continue;
+
+					// A full scan without an ear. Drop degenerate vertices first, then try to untangle self-intersections.
+					if (pass == 0)
+						start = FilterPoints(start);
+					else if (pass == 1)
+						start = CureLocalIntersections(start);
+					else
+						return false;
+
+					if (start == NoNode)
+						return true;
+
+					++pass;
+				}
+			}
+
+			// Remove duplicate and collinear vertices, returning a remaining vertex or NoNode if fewer than three are left.
+			std::uint32_t FilterPoints(std::uint32_t aStart)
+			{
+				std::uint32_t node = aStart;
+				std::uint32_t end = aStart;
+
+				while (true)
+				{
+					const EarNode<T>& current = myNodes[node];
+					const EarNode<T>& next = myNodes[current.Next];
+
+					if (IsSamePoint(current.Position, next.Position) || Cross(myNodes[current.Previous].Position, current.Position, next.Position) == T(0))
+					{
+						const std::uint32_t previous = current.Previous;
+						Remove(node);
+
+						if (previous == myNodes[previous].Next || myNodes[previous].Previous == myNodes[previous].Next)
+							return NoNode;
+
+						node = end = previous;
+						continue;
+					}
+
+					node = current.Next;
+					if (node == end)
+						return end;
+				}
+			}
+
+		private:
+			bool IsEar(std::uint32_t anEar) const
+			{
+				const EarNode<T>& a = myNodes[myNodes[anEar].Previous];
+				const EarNode<T>& b = myNodes[anEar];
+				const EarNode<T>& c = myNodes[b.Next];
+
+				// Reflex vertices can't be ears.
+				if (Cross(a.Position, b.Position, c.Position) <= T(0))
+					return false;
+
+				if (!myUseMorton)
+				{
+					for (std::uint32_t node = c.Next; node != b.Previous; node = myNodes[node].Next)
+					{
+						if (BlocksEar(node, a, b, c))
+							return false;
+					}
+
+					return true;
+				}
+
+				const T minX = Math::Min<T>(a.Position.X, b.Position.X, c.Position.X);
+				const T minY = Math::Min<T>(a.Position.Y, b.Position.Y, c.Position.Y);
+				const T maxX = Math::Max<T>(a.Position.X, b.Position.X, c.Position.X);
+				const T maxY = Math::Max<T>(a.Position.Y, b.Position.Y, c.Position.Y);
+
+				// Only vertices whose Morton code is between those of the triangle's bounding box corners can be inside it.
+				const std::uint64_t minZ = GetMortonCode(Vector2<T>(minX, minY));
+				const std::uint64_t maxZ = GetMortonCode(Vector2<T>(maxX, maxY));
+
+				for (std::uint32_t node = b.PreviousZ; node != NoNode && myNodes[node].Z >= minZ; node = myNodes[node].PreviousZ)
+				{
+					if (BlocksEar(node, a, b, c))
+						return false;
+				}
+
+				for (std::uint32_t node = b.NextZ; node != NoNode && myNodes[node].Z <= maxZ; node = myNodes[node].NextZ)
+				{
+					if (BlocksEar(node, a, b, c))
+						return false;
+				}
+
+				return true;
+			}
+
+			// Whether a vertex lies within the ear triangle, and is reflex so that the polygon actually reaches into the ear there.
+			bool BlocksEar(std::uint32_t aNode, const EarNode<T>& a, const EarNode<T>& b, const EarNode<T>& c) const
+			{
+				const EarNode<T>& node = myNodes[aNode];
+				if (IsSamePoint(node.Position, a.Position) || IsSamePoint(node.Position, b.Position) || IsSamePoint(node.Position, c.Position))
+					return false;
+
+				return
+					Cross(a.Position, b.Position, node.Position) >= T(0) &&
+					Cross(b.Position, c.Position, node.Position) >= T(0) &&
+					Cross(c.Position, a.Position, node.Position) >= T(0) &&
+					Cross(myNodes[node.Previous].Position, node.Position, myNodes[node.Next].Position) <= T(0);
+			}
+
+			// Clip away small loops where an edge crosses the edge after next, which ear clipping can't otherwise get past.
+			std::uint32_t CureLocalIntersections(std::uint32_t aStart)
+			{
+				std::uint32_t start = aStart;
+				std::uint32_t node = start;
+
+				do
+				{
+					const std::uint32_t a = myNodes[node].Previous;
+					const std::uint32_t next = myNodes[node].Next;
+					const std::uint32_t b = myNodes[next].Next;
+
+					if (!IsSamePoint(myNodes[a].Position, myNodes[b].Position) && Intersects(a, node, next, b) && IsLocallyInside(a, b) && IsLocallyInside(b, a))
+					{
+						myIndices.push_back(myNodes[a].Index);
+						myIndices.push_back(myNodes[node].Index);
+						myIndices.push_back(myNodes[b].Index);
+
+						Remove(node);
+						Remove(next);
+
+						if (myNodes[b].Previous == myNodes[b].Next)
+							return NoNode;
+
+						node = start = b;
+					}
+
+					node = myNodes[node].Next;
+				} while (node != start);
+
+				return FilterPoints(node);
+			}
+
+			bool Intersects(std::uint32_t aP1, std::uint32_t aQ1, std::uint32_t aP2, std::uint32_t aQ2) const
+			{
+				const Vector2<T>& p1 = myNodes[aP1].Position;
+				const Vector2<T>& q1 = myNodes[aQ1].Position;
+				const Vector2<T>& p2 = myNodes[aP2].Position;
+				const Vector2<T>& q2 = myNodes[aQ2].Position;
+
+				const auto sign = [](T aValue) { return (aValue > T(0)) - (aValue < T(0)); };
+				return sign(Cross(p1, q1, p2)) != sign(Cross(p1, q1, q2)) && sign(Cross(p2, q2, p1)) != sign(Cross(p2, q2, q1));
+			}
+
+			// Whether the diagonal from a to b starts off inside the polygon at a.
+			bool IsLocallyInside(std::uint32_t anA, std::uint32_t aB) const
+			{
+				const EarNode<T>& a = myNodes[anA];
+				const Vector2<T>& previous = myNodes[a.Previous].Position;
+				const Vector2<T>& next = myNodes[a.Next].Position;
+				const Vector2<T>& b = myNodes[aB].Position;
+
+				if (Cross(previous, a.Position, next) < T(0))
+					return Cross(a.Position, b, next) < T(0) || Cross(a.Position, previous, b) < T(0);
+
+				return Cross(a.Position, b, previous) >= T(0) && Cross(a.Position, next, b) >= T(0);
+			}
+
+			void Enqueue(std::uint32_t aNode)
+			{
+				myNodes[aNode].QueuePosition = static_cast<std::uint32_t>(myQueue.size());
+				myQueue.push_back(aNode);
+			}
+
+			void Remove(std::uint32_t aNode)
+			{
+				EarNode<T>& node = myNodes[aNode];
+				node.QueuePosition = NoNode;
+				myNodes[node.Previous].Next = node.Next;
+				myNodes[node.Next].Previous = node.Previous;
+
+				if (node.PreviousZ != NoNode)
+					myNodes[node.PreviousZ].NextZ = node.NextZ;
+				if (node.NextZ != NoNode)
+					myNodes[node.NextZ].PreviousZ = node.PreviousZ;
+			}
+
+			std::vector<EarNode<T>>& myNodes;
+			std::vector<std::uint32_t>& myQueue;
+			std::vector<std::uint32_t>& myIndices;
+			Vector2<T> myMinimum;
+			Vector2<T> myMaximum;
+			bool myUseMorton = false;
+		};
+
+		// Priorities of the sweep status treap, from a hash of the vertex so the tree stays balanced whatever the polygon's order.
+		constexpr std::uint32_t GetTreePriority(std::uint32_t aVertex)
+		{
+			std::uint32_t hash = aVertex * 0x9E3779B9u;
+			hash ^= hash >> 16;
+			hash *= 0x85EBCA6Bu;
+			hash ^= hash >> 13;
+			return hash;
+		}
+
+		/**
+		 * @brief Triangulation by splitting the polygon into y-monotone pieces with a sweep line, then walking down the two chains of each piece.
+		 *        Takes O(n log n) time for any simple polygon, and gives up when the sweep shows the polygon isn't simple.
+		 */
+		template <typename T>
+		class MonotoneTriangulator
+		{
+		public:
+			MonotoneTriangulator(TriangulationScratch<T>& aScratch, std::vector<std::uint32_t>& someIndices)
+				: myVertices(aScratch.Vertices)
+				, myLinks(aScratch.Links)
+				, myOrder(aScratch.Order)
+				, myDiagonals(aScratch.Diagonals)
+				, myPiece(aScratch.Piece)
+				, myStack(aScratch.Stack)
+				, myIndices(someIndices)
+			{
+
+			}
+
+			// Returns false when the polygon turned out not to be simple, leaving the indices incomplete.
+			bool Run(std::span<const Vector2<T>> somePolygon, bool anIsClockwise)
+			{
+				const std::size_t count = somePolygon.size();
+
+				// Link the vertices counter-clockwise, without repeated vertices as their zero-length edges have no side.
+				myVertices.clear();
+				for (std::size_t i = 0; i < count; ++i)
+				{
+					const std::size_t index = anIsClockwise ? count - 1 - i : i;
+					if (!myVertices.empty() && IsSamePoint(myVertices.back().Position, somePolygon[index]))
+						continue;
+
+					SweepVertex<T>& vertex = myVertices.emplace_back();
+					vertex.Position = somePolygon[index];
+					vertex.Index = static_cast<std::uint32_t>(index);
+					vertex.Helper = NoNode;
+					vertex.TreeLeft = NoNode;
+					vertex.TreeRight = NoNode;
+					vertex.IsMerge = false;
+				}
+				while (myVertices.size() > 1 && IsSamePoint(myVertices.back().Position, myVertices.front().Position))
+					myVertices.pop_back();
+
+				if (myVertices.size() < 3)
+					return true;
+
+				return SplitIntoPieces() && LinkDiagonals() && TriangulatePieces();
+			}
+
+		private:
+			// Sweep from the top down, adding diagonals at the vertices where the polygon splits or merges.
+			// The status holds the edges with the interior on their right, ordered left to right, and each one's lowest vertex seen so far as its helper.
+			bool SplitIntoPieces()
+			{
+				const std::uint32_t count = static_cast<std::uint32_t>(myVertices.size());
+
+				// Vertices in the same row are swept left to right, as if the polygon were rotated ever so slightly.
+				myOrder.resize(count);
+				for (std::uint32_t i = 0; i < count; ++i)
+					myOrder[i] = i;
+
+				std::sort(myOrder.begin(), myOrder.end(), [this](std::uint32_t aVertex, std::uint32_t anOther)
+				{
+					const Vector2<T>& position = myVertices[aVertex].Position;
+					const Vector2<T>& otherPosition = myVertices[anOther].Position;
+					if (position.Y != otherPosition.Y)
+						return position.Y > otherPosition.Y;
+					if (position.X != otherPosition.X)
+						return position.X < otherPosition.X;
+					return aVertex < anOther;
+				});
+
+				for (std::uint32_t i = 0; i < count; ++i)
+					myVertices[myOrder[i]].Rank = i;
+
+				myRoot = NoNode;
+				myDiagonals.clear();
+
+				for (const std::uint32_t vertex : myOrder)
+				{
+					const std::uint32_t previous = GetPrevious(vertex);
+					const std::uint32_t next = GetNext(vertex);
+					const SweepVertex<T>& current = myVertices[vertex];
+					const bool isPreviousBelow = myVertices[previous].Rank > current.Rank;
+					const bool isNextBelow = myVertices[next].Rank > current.Rank;
+					const bool isReflex = Cross(myVertices[previous].Position, current.Position, myVertices[next].Position) < T(0);
+
+					if (isPreviousBelow && isNextBelow)
+					{
+						// A split vertex connects up to the closest vertex above that sees it.
+						if (isReflex)
+						{
+							const std::uint32_t left = FindEdgeLeftOf(current.Position);
+							if (left == NoNode)
+								return false;
+
+							AddDiagonal(vertex, myVertices[left].Helper);
+							myVertices[left].Helper = vertex;
+						}
+
+						InsertEdge(vertex);
+					}
+					else if (!isPreviousBelow && !isNextBelow)
+					{
+						if (!EraseEdge(previous, vertex))
+							return false;
+
+						// A merge vertex is connected down later, by whichever vertex next takes over as the helper of the edge on its left.
+						if (isReflex)
+						{
+							const std::uint32_t left = FindEdgeLeftOf(current.Position);
+							if (left == NoNode)
+								return false;
+
+							SetHelper(left, vertex);
+							myVertices[vertex].IsMerge = true;
+						}
+					}
+					else if (isNextBelow)
+					{
+						if (!EraseEdge(previous, vertex))
+							return false;
+
+						InsertEdge(vertex);
+					}
+					else
+					{
+						const std::uint32_t left = FindEdgeLeftOf(current.Position);
+						if (left == NoNode)
+							return false;
+
+						SetHelper(left, vertex);
+					}
+				}
+
+				return myRoot == NoNode;
+			}
+
+			// Give each vertex its neighbours and diagonals as links in counter-clockwise order, so the pieces can be traced.
+			bool LinkDiagonals()
+			{
+				const std::size_t count = myVertices.size();
+
+				// Count the links into each vertex's end, and fill them in from there so it ends up at the start.
+				std::uint32_t linkCount = 0;
+				for (std::size_t i = 0; i < count; ++i)
+					myVertices[i].FirstLink = 2;
+				for (const std::uint32_t vertex : myDiagonals)
+					++myVertices[vertex].FirstLink;
+				for (std::size_t i = 0; i < count; ++i)
+				{
+					linkCount += myVertices[i].FirstLink;
+					myVertices[i].FirstLink = linkCount;
+				}
+
+				myLinks.resize(linkCount);
+				const auto addLink = [this](std::uint32_t aVertex, std::uint32_t aTarget) { myLinks[--myVertices[aVertex].FirstLink] = SweepLink{ aTarget, false }; };
+				for (std::size_t i = 0; i < myDiagonals.size(); i += 2)
+				{
+					addLink(myDiagonals[i], myDiagonals[i + 1]);
+					addLink(myDiagonals[i + 1], myDiagonals[i]);
+				}
+				for (std::uint32_t i = 0; i < count; ++i)
+				{
+					addLink(i, GetNext(i));
+					addLink(i, GetPrevious(i));
+				}
+
+				for (std::uint32_t i = 0; i < count; ++i)
+				{
+					if (GetLinkEnd(i) - myVertices[i].FirstLink <= 2)
+						continue;
+
+					const Vector2<T>& origin = myVertices[i].Position;
+					const auto isLowerHalf = [&origin](const Vector2<T>& aPoint) { return aPoint.Y < origin.Y || (aPoint.Y == origin.Y && aPoint.X < origin.X); };
+					std::sort(myLinks.begin() + myVertices[i].FirstLink, myLinks.begin() + GetLinkEnd(i), [&](const SweepLink& aLink, const SweepLink& anOther)
+					{
+						const Vector2<T>& position = myVertices[aLink.Vertex].Position;
+						const Vector2<T>& otherPosition = myVertices[anOther.Vertex].Position;
+						const bool isLower = isLowerHalf(position);
+						if (isLower != isLowerHalf(otherPosition))
+							return !isLower;
+						return Cross(origin, position, otherPosition) > T(0);
+					});
+				}
+
+				return true;
+			}
+
+			// Walk around each piece once, starting from every link which hasn't been walked and doesn't face the outside.
+			bool TriangulatePieces()
+			{
+				T polygonArea = T(0);
+				const Vector2<T>& origin = myVertices[0].Position;
+				for (std::size_t i = 2; i < myVertices.size(); ++i)
+					polygonArea += Cross(origin, myVertices[i - 1].Position, myVertices[i].Position);
+
+				myTriangleArea = T(0);
+
+				for (std::uint32_t vertex = 0; vertex < myVertices.size(); ++vertex)
+				{
+					for (std::uint32_t link = myVertices[vertex].FirstLink; link < GetLinkEnd(vertex); ++link)
+					{
+						if (myLinks[link].IsTraced || myLinks[link].Vertex == GetPrevious(vertex))
+							continue;
+
+						if (!TracePiece(vertex, link) || !TriangulatePiece())
+							return false;
+					}
+				}
+
+				// Overlapping edges can get past the checks above, but not without the triangles covering a different area.
+				T tolerance = T(0);
+				if constexpr (std::is_floating_point_v<T>)
+					tolerance = polygonArea * std::sqrt(std::numeric_limits<T>::epsilon());
+
+				return myTriangleArea <= polygonArea + tolerance && myTriangleArea >= polygonArea - tolerance;
+			}
+
+			// Collect the vertices of the piece to the left of a link, by turning as far right as possible at each vertex.
+			bool TracePiece(std::uint32_t aVertex, std::uint32_t aLink)
+			{
+				myPiece.clear();
+
+				std::uint32_t vertex = aVertex;
+				std::uint32_t link = aLink;
+				do
+				{
+					if (myLinks[link].IsTraced || myPiece.size() == myVertices.size())
+						return false;
+
+					myLinks[link].IsTraced = true;
+					myPiece.push_back(vertex);
+
+					const std::uint32_t target = myLinks[link].Vertex;
+					const std::uint32_t first = myVertices[target].FirstLink;
+					std::uint32_t back = first;
+					while (myLinks[back].Vertex != vertex)
+						++back;
+
+					link = back == first ? GetLinkEnd(target) - 1 : back - 1;
+					vertex = target;
+
+					if (myLinks[link].Vertex == GetPrevious(vertex))
+						return false;
+				} while (link != aLink);
+
+				return true;
+			}
+
+			// Triangulate a y-monotone piece by taking its vertices from the top down, keeping those that can't be connected yet on a stack.
+			bool TriangulatePiece()
+			{
+				const std::size_t size = myPiece.size();
+				const auto forward = [size](std::size_t anIndex) { return anIndex + 1 == size ? 0 : anIndex + 1; };
+				const auto backward = [size](std::size_t anIndex) { return anIndex == 0 ? size - 1 : anIndex - 1; };
+				const auto rank = [this](std::size_t anIndex) { return myVertices[myPiece[anIndex]].Rank; };
+
+				std::size_t top = 0;
+				std::size_t bottom = 0;
+				for (std::size_t i = 1; i < size; ++i)
+				{
+					if (rank(i) < rank(top))
+						top = i;
+					if (rank(i) > rank(bottom))
+						bottom = i;
+				}
+
+				// Going forward from the top is the left chain down to the bottom, and back up along the right one. Anything else isn't monotone.
+				for (std::size_t i = top; i != bottom; i = forward(i))
+				{
+					if (rank(forward(i)) < rank(i))
+						return false;
+				}
+				for (std::size_t i = bottom; i != top; i = forward(i))
+				{
+					if (rank(forward(i)) > rank(i))
+						return false;
+				}
+
+				myStack.clear();
+				myStack.push_back(myPiece[top]);
+
+				std::size_t left = forward(top);
+				std::size_t right = backward(top);
+				std::uint32_t previous = myPiece[top];
+
+				for (std::size_t i = 1; i < size; ++i)
+				{
+					std::uint32_t current;
+					if (left != bottom && (right == bottom || rank(left) < rank(right)))
+					{
+						current = myPiece[left];
+						myVertices[current].IsOnLeftChain = true;
+						left = forward(left);
+					}
+					else if (right != bottom)
+					{
+						current = myPiece[right];
+						myVertices[current].IsOnLeftChain = false;
+						right = backward(right);
+					}
+					else
+					{
+						current = myPiece[bottom];
+					}
+
+					if (i == 1)
+					{
+						myStack.push_back(current);
+					}
+					else if (i + 1 == size || myVertices[current].IsOnLeftChain != myVertices[myStack.back()].IsOnLeftChain)
+					{
+						// The other chain sees the whole stack.
+						for (std::size_t j = 0; j + 1 < myStack.size(); ++j)
+							AddTriangle(current, myStack[j], myStack[j + 1]);
+
+						myStack.clear();
+						myStack.push_back(previous);
+						myStack.push_back(current);
+					}
+					else
+					{
+						// The same chain sees back up the stack until it turns away.
+						const bool isOnLeftChain = myVertices[current].IsOnLeftChain;
+						std::uint32_t last = myStack.back();
+						myStack.pop_back();
+
+						while (!myStack.empty())
+						{
+							const Vector2<T>& stacked = myVertices[myStack.back()].Position;
+							const Vector2<T>& lastPosition = myVertices[last].Position;
+							const Vector2<T>& position = myVertices[current].Position;
+							if ((isOnLeftChain ? Cross(stacked, lastPosition, position) : Cross(position, lastPosition, stacked)) <= T(0))
+								break;
+
+							AddTriangle(myStack.back(), last, current);
+							last = myStack.back();
+							myStack.pop_back();
+						}
+
+						myStack.push_back(last);
+						myStack.push_back(current);
+					}
+
+					previous = current;
+				}
+
+				return true;
+			}
+
+			void AddTriangle(std::uint32_t aVertex, std::uint32_t aSecond, std::uint32_t aThird)
+			{
+				const T area = Cross(myVertices[aVertex].Position, myVertices[aSecond].Position, myVertices[aThird].Position);
+				if (area == T(0))
+					return;
+
+				const bool isCounterClockwise = area > T(0);
+				myIndices.push_back(myVertices[aVertex].Index);
+				myIndices.push_back(myVertices[isCounterClockwise ? aSecond : aThird].Index);
+				myIndices.push_back(myVertices[isCounterClockwise ? aThird : aSecond].Index);
+				myTriangleArea += isCounterClockwise ? area : -area;
+			}
+
+			void AddDiagonal(std::uint32_t aVertex, std::uint32_t anOther)
+			{
+				myDiagonals.push_back(aVertex);
+				myDiagonals.push_back(anOther);
+			}
+
+			// Connect a merge vertex helping an edge to the vertex that takes over from it.
+			void SetHelper(std::uint32_t anEdge, std::uint32_t aVertex)
+			{
+				const std::uint32_t helper = myVertices[anEdge].Helper;
+				if (myVertices[helper].IsMerge)
+					AddDiagonal(aVertex, helper);
+
+				myVertices[anEdge].Helper = aVertex;
+			}
+
+			// Whether the edge from a vertex to the next one passes left of a point, going by the line through it so the edge must span the point's row.
+			bool IsEdgeLeftOf(std::uint32_t anEdge, const Vector2<T>& aPoint) const
+			{
+				const SweepVertex<T>& start = myVertices[anEdge];
+				const SweepVertex<T>& end = myVertices[GetNext(anEdge)];
+				const bool isStartUpper = start.Rank < end.Rank;
+				return Cross(isStartUpper ? end.Position : start.Position, isStartUpper ? start.Position : end.Position, aPoint) < T(0);
+			}
+
+			std::uint32_t FindEdgeLeftOf(const Vector2<T>& aPoint) const
+			{
+				std::uint32_t closest = NoNode;
+				std::uint32_t edge = myRoot;
+				while (edge != NoNode)
+				{
+					if (IsEdgeLeftOf(edge, aPoint))
+					{
+						closest = edge;
+						edge = myVertices[edge].TreeRight;
+					}
+					else
+					{
+						edge = myVertices[edge].TreeLeft;
+					}
+				}
+				return closest;
+			}
+
+			void InsertEdge(std::uint32_t aVertex)
+			{
+				myVertices[aVertex].Helper = aVertex;
+				myRoot = InsertIntoTree(myRoot, aVertex, myVertices[aVertex].Position);
+			}
+
+			// Remove the edge ending at a vertex, connecting the vertex to its helper if that was a merge vertex.
+			bool EraseEdge(std::uint32_t anEdge, std::uint32_t aVertex)
+			{
+				const std::uint32_t helper = myVertices[anEdge].Helper;
+				if (helper == NoNode)
+					return false;
+				if (myVertices[helper].IsMerge)
+					AddDiagonal(aVertex, helper);
+
+				bool isFound = false;
+				myRoot = EraseFromTree(myRoot, anEdge, myVertices[aVertex].Position, isFound);
+				myVertices[anEdge].Helper = NoNode;
+				return isFound;
+			}
+
+			// Insert an edge starting at a point, which it must not pass left of.
+			std::uint32_t InsertIntoTree(std::uint32_t aTree, std::uint32_t anEdge, const Vector2<T>& aPoint)
+			{
+				if (aTree == NoNode)
+					return anEdge;
+
+				SweepVertex<T>& node = myVertices[aTree];
+				if (GetTreePriority(anEdge) > GetTreePriority(aTree))
+				{
+					SplitTree(aTree, aPoint, myVertices[anEdge].TreeLeft, myVertices[anEdge].TreeRight);
+					return anEdge;
+				}
+
+				if (IsEdgeLeftOf(aTree, aPoint))
+					node.TreeRight = InsertIntoTree(node.TreeRight, anEdge, aPoint);
+				else
+					node.TreeLeft = InsertIntoTree(node.TreeLeft, anEdge, aPoint);
+				return aTree;
+			}
+
+			// Erase an edge ending at a point, which makes it the leftmost edge that doesn't pass left of that point.
+			std::uint32_t EraseFromTree(std::uint32_t aTree, std::uint32_t anEdge, const Vector2<T>& aPoint, bool& outIsFound)
+			{
+				if (aTree == NoNode)
+					return NoNode;
+
+				SweepVertex<T>& node = myVertices[aTree];
+				if (aTree == anEdge)
+				{
+					outIsFound = true;
+					const std::uint32_t merged = MergeTrees(node.TreeLeft, node.TreeRight);
+					node.TreeLeft = NoNode;
+					node.TreeRight = NoNode;
+					return merged;
+				}
+
+				if (IsEdgeLeftOf(aTree, aPoint))
+					node.TreeRight = EraseFromTree(node.TreeRight, anEdge, aPoint, outIsFound);
+				else
+					node.TreeLeft = EraseFromTree(node.TreeLeft, anEdge, aPoint, outIsFound);
+				return aTree;
+			}
+
+			void SplitTree(std::uint32_t aTree, const Vector2<T>& aPoint, std::uint32_t& outLeft, std::uint32_t& outRight)
+			{
+				if (aTree == NoNode)
+				{
+					outLeft = NoNode;
+					outRight = NoNode;
+				}
+				else if (IsEdgeLeftOf(aTree, aPoint))
+				{
+					SplitTree(myVertices[aTree].TreeRight, aPoint, myVertices[aTree].TreeRight, outRight);
+					outLeft = aTree;
+				}
+				else
+				{
+					SplitTree(myVertices[aTree].TreeLeft, aPoint, outLeft, myVertices[aTree].TreeLeft);
+					outRight = aTree;
+				}
+			}
+
+			std::uint32_t MergeTrees(std::uint32_t aLeft, std::uint32_t aRight)
+			{
+				if (aLeft == NoNode)
+					return aRight;
+				if (aRight == NoNode)
+					return aLeft;
+
+				if (GetTreePriority(aLeft) > GetTreePriority(aRight))
+				{
+					myVertices[aLeft].TreeRight = MergeTrees(myVertices[aLeft].TreeRight, aRight);
+					return aLeft;
+				}
+
+				myVertices[aRight].TreeLeft = MergeTrees(aLeft, myVertices[aRight].TreeLeft);
+				return aRight;
+			}
+
+			std::uint32_t GetPrevious(std::uint32_t aVertex) const
+			{
+				return aVertex == 0 ? static_cast<std::uint32_t>(myVertices.size() - 1) : aVertex - 1;
+			}
+
+			std::uint32_t GetNext(std::uint32_t aVertex) const
+			{
+				return aVertex + 1 == myVertices.size() ? 0 : aVertex + 1;
+			}
+
+			std::uint32_t GetLinkEnd(std::uint32_t aVertex) const
+			{
+				return aVertex + 1 == myVertices.size() ? static_cast<std::uint32_t>(myLinks.size()) : myVertices[aVertex + 1].FirstLink;
+			}
+
+			std::vector<SweepVertex<T>>& myVertices;
+			std::vector<SweepLink>& myLinks;
+			std::vector<std::uint32_t>& myOrder;
+			std::vector<std::uint32_t>& myDiagonals;
+			std::vector<std::uint32_t>& myPiece;
+			std::vector<std::uint32_t>& myStack;
+			std::vector<std::uint32_t>& myIndices;
+			std::uint32_t myRoot = NoNode;
+			T myTriangleArea = T(0);
+		};
+	}
+
+	template <typename T>
+	constexpr T SignedArea(std::span<const Vector2<T>> somePolygon)
+	{
+		if (somePolygon.size() < 3)
+			return T(0);
+
+		T doubleArea = T(0);
+		Vector2<T> previous = somePolygon.back();
+		for (const Vector2<T>& current : somePolygon)
+		{
+			doubleArea += previous.X * current.Y - current.X * previous.Y;
+			previous = current;
+		}
+
+		return doubleArea / T(2);
+	}
+
+	template <typename T>
+	void ConvexHull(std::span<const Vector2<std::type_identity_t<T>>> somePoints, std::vector<Vector2<T>>& outHull, std::vector<Vector2<T>>& aScratch)
+	{
+		const std::size_t count = somePoints.size();
+		const std::size_t chunkCount = std::min(Parallel::GetChunkCount(count, 1 << 16), _impl::MaxHullChunks);
+
+		// The first third holds sorted copies of each chunk, the rest each chunk's hull at twice its size.
+		aScratch.resize(count * 3);
+		std::array<std::size_t, _impl::MaxHullChunks> chunkBegins;
+		std::array<std::size_t, _impl::MaxHullChunks> chunkHullSizes;
+
+		Parallel::ForEachChunk(count, chunkCount, [&](std::size_t aChunk, std::size_t aBegin, std::size_t anEnd)
+		{
+			Vector2<T>* sorted = aScratch.data() + aBegin;
+			std::copy(somePoints.begin() + aBegin, somePoints.begin() + anEnd, sorted);
+			std::sort(sorted, sorted + (anEnd - aBegin), [](const Vector2<T>& aPoint, const Vector2<T>& anOther) { return _impl::IsLexicographicallyLess(aPoint, anOther); });
+
+			chunkBegins[aChunk] = aBegin;
+			chunkHullSizes[aChunk] = _impl::MonotoneChain(sorted, anEnd - aBegin, aScratch.data() + count + aBegin * 2);
+		});
+
+		if (chunkCount == 1)
+		{
+			outHull.assign(aScratch.begin() + count, aScratch.begin() + count + chunkHullSizes[0]);
+			return;
+		}
+
+		// Gather the chunk hulls at the front, which never overlaps a hull that is yet to be moved.
+		std::size_t mergedCount = 0;
+		for (std::size_t i = 0; i < chunkCount; ++i)
+		{
+			const auto hullBegin = aScratch.begin() + count + chunkBegins[i] * 2;
+			std::copy(hullBegin, hullBegin + chunkHullSizes[i], aScratch.begin() + mergedCount);
+			mergedCount += chunkHullSizes[i];
+		}
+
+		std::sort(aScratch.begin(), aScratch.begin() + mergedCount, [](const Vector2<T>& aPoint, const Vector2<T>& anOther) { return _impl::IsLexicographicallyLess(aPoint, anOther); });
+
+		outHull.resize(mergedCount * 2);
+		outHull.resize(_impl::MonotoneChain(aScratch.data(), mergedCount, outHull.data()));
+	}
+
+	template <typename T>
+	void ClipToRectangle(std::span<const Vector2<std::type_identity_t<T>>> somePolygon, const Rectangle<T>& aRectangle, std::vector<Vector2<T>>& outPolygon, std::vector<Vector2<T>>& aScratch)
+	{
+		_impl::ClipToAxis<T, true, true>(somePolygon, aRectangle.Left(), outPolygon);
+		_impl::ClipToAxis<T, true, false>(outPolygon, aRectangle.Right(), aScratch);
+		_impl::ClipToAxis<T, false, true>(aScratch, aRectangle.Top(), outPolygon);
+		_impl::ClipToAxis<T, false, false>(outPolygon, aRectangle.Bottom(), aScratch);
+
+		// Swapping keeps both buffers' capacity with the caller.
+		outPolygon.swap(aScratch);
+	}
+
+	template <typename T>
+	bool Triangulate(std::span<const Vector2<std::type_identity_t<T>>> somePolygon, std::vector<std::uint32_t>& outIndices, TriangulationScratch<T>& aScratch)
+	{
+		outIndices.clear();
+
+		const std::size_t count = somePolygon.size();
+		if (count < 3)
+			return true;
+
+		outIndices.reserve((count - 2) * 3);
+
+		const bool isClockwise = SignedArea<T>(somePolygon) < T(0);
+
+		if (count > _impl::SweepThreshold)
+		{
+			_impl::MonotoneTriangulator<T> triangulator(aScratch, outIndices);
+			if (triangulator.Run(somePolygon, isClockwise))
+				return true;
+
+			outIndices.clear();
+		}
+
+		// Link the vertices counter-clockwise, so ears are the vertices turning left.
+
+		std::vector<_impl::EarNode<T>>& nodes = aScratch.Nodes;
+		nodes.resize(count);
+		for (std::size_t i = 0; i < count; ++i)
+		{
+			const std::size_t index = isClockwise ? count - 1 - i : i;
+
+			_impl::EarNode<T>& node = nodes[i];
+			node.Position = somePolygon[index];
+			node.Index = static_cast<std::uint32_t>(index);
+			node.Previous = static_cast<std::uint32_t>(i == 0 ? count - 1 : i - 1);
+			node.Next = static_cast<std::uint32_t>(i + 1 == count ? 0 : i + 1);
+			node.PreviousZ = _impl::NoNode;
+			node.NextZ = _impl::NoNode;
+			node.Z = 0;
+			node.QueuePosition = _impl::NoNode;
+		}
+
+		_impl::EarClipper<T> clipper(nodes, aScratch.Order, outIndices);
+
+		std::uint32_t start = clipper.FilterPoints(0);
+		if (start == _impl::NoNode)
+			return true;
+
+		if (count > _impl::MortonThreshold)
+		{
+			Vector2<T> minimum = nodes[start].Position;
+			Vector2<T> maximum = minimum;
+			for (const _impl::EarNode<T>& node : nodes)
+			{
+				minimum = Vector2<T>::Min(minimum, node.Position);
+				maximum = Vector2<T>::Max(maximum, node.Position);
+			}
+			clipper.SetMortonBounds(minimum, maximum);
+
+			// Sort the remaining vertices by Morton code.
+			std::vector<std::uint32_t>& order = aScratch.Order;
+			order.clear();
+			std::uint32_t node = start;
+			do
+			{
+				nodes[node].Z = clipper.GetMortonCode(nodes[node].Position);
+				order.push_back(node);
+				node = nodes[node].Next;
+			} while (node != start);
+
+			std::sort(order.begin(), order.end(), [&nodes](std::uint32_t aNode, std::uint32_t anOther) { return nodes[aNode].Z < nodes[anOther].Z; });
+
+			// Then store them in that order, which keeps the neighbourhood walks of the ear tests within nearby memory.
+			// The order is followed by the new position of each old node, and the reordered nodes go after the old ones until moved down.
+			const std::size_t remainingCount = order.size();
+			order.resize(remainingCount + count);
+			for (std::size_t i = 0; i < remainingCount; ++i)
+				order[remainingCount + order[i]] = static_cast<std::uint32_t>(i);
+
+			nodes.resize(count + remainingCount);
+			for (std::size_t i = 0; i < remainingCount; ++i)
+			{
+				_impl::EarNode<T>& reordered = nodes[count + i];
+				reordered = nodes[order[i]];
+				reordered.Previous = order[remainingCount + reordered.Previous];
+				reordered.Next = order[remainingCount + reordered.Next];
+				reordered.PreviousZ = i == 0 ? _impl::NoNode : static_cast<std::uint32_t>(i - 1);
+				reordered.NextZ = i + 1 == remainingCount ? _impl::NoNode : static_cast<std::uint32_t>(i + 1);
+			}
+
+			start = order[remainingCount + start];
+			std::copy(nodes.begin() + count, nodes.end(), nodes.begin());
+			nodes.resize(remainingCount);
+		}
+
+		return clipper.Run(start);
+	}
+}
@@ -1,329 +1,362 @@
 #pragma once
 
-#include "Matrix.hpp"
+#include "Matrix3D.hpp"
 #include "Trigonometry.hpp"
 #include "Vector.hpp"
+#include "VectorTraits.hpp"
 
 namespace RoseCommon::Math
 {
-	//template <typename T>
-	//class Quaternion
-	//{
-	//public:
-	//	/// <summary>A Quaternion representing no rotation.</summary>
-	//	static constexpr Quaternion Identity() { return { 0, 0, 0, 1 }; }
-
-	//public:
-	//	/// <summary>
-	//	/// Creates a Quaternion from a vector and an angle to rotate about the vector.
-	//	/// </summary>
-	//	/// <param name="anAxis">The vector axis to rotate around.</param>
-	//	/// <param name="anAngle">The angle, in radians, to rotate around the vector.</param>
-	//	/// <returns>The created Quaternion.</returns>
-	//	static constexpr Quaternion CreateFromAxisAngle(const Vector3<T>& anAxis, const T& anAngle)
-	//	{
-	//		const T halfAngle = anAngle / 2;
-	//		const T s = Math::Sine(halfAngle);
-
-	//		return Quaternion(
-	//			anAxis.X * s,
-	//			anAxis.Y * s,
-	//			anAxis.Z * s,
-	//			Math::Cosine(halfAngle)
-	//		);
-	//	}
-
-	//	/// <summary>
-	//	/// Creates a Quaternion from specified yaw, pitch and roll angles.
-	//	/// </summary>
-	//	/// <param name="aYaw">The yaw angle, in radians, around the y-axis.</param>
-	//	/// <param name="aPitch">The pitch angle, in radians, around the x-axis.</param>
-	//	/// <param name="aRoll">The roll angle, in radians, around the z-axis.</param>
-	//	/// <returns>The created Quaternion expressing the specified angles.</returns>
-	//	static constexpr Quaternion CreateFromYawPitchRoll(const T& aYaw, const T& aPitch, const T& aRoll)
-	//	{
-	//		Quaternion quaternion;
-	//		quaternion.Set(aYaw, aPitch, aRoll);
-	//		return quaternion;
-	//	}
-
-	//	/// <summary>
-	//	/// Calculates the dot product of two Quaternions.
-	//	/// </summary>
-	//	/// <returns>The calculated dot product.</returns>
-	//	static constexpr T Dot(const Quaternion& aQuaternion, const Quaternion& anOtherQuaternion)
-	//	{
-	//		return
-	//			(aQuaternion.X * anOtherQuaternion.X) +
-	//			(aQuaternion.Y * anOtherQuaternion.Y) +
-	//			(aQuaternion.Z * anOtherQuaternion.Z) +
-	//			(aQuaternion.W * anOtherQuaternion.W);
-	//	}
-
-	//	/// <summary>
-	//	/// Returns the inverse of a Quaternion.
-	//	/// </summary>
-	//	/// <param name="aQuaternion">The Quaternion to invert.</param>
-	//	/// <returns>The inverted Quaternion.</returns>
-	//	static constexpr Quaternion Inverse(const Quaternion& aQuaternion)
-	//	{
-	//		return Quaternion(-aQuaternion.X, -aQuaternion.Y, -aQuaternion.Z, aQuaternion.W);
-	//	}
-
-	//	/// <summary>
-	//	/// Divides each component of the quaternion by the length of the quaternion.
-	//	/// </summary>
-	//	/// <returns>The normalized Quaternion.</returns>
-	//	static constexpr Quaternion Normalize(const Quaternion& aQuaternion)
-	//	{
-	//		Quaternion resultQuaternion = aQuaternion;
-	//		resultQuaternion.Normalize();
-	//		return resultQuaternion;
-	//	}
-
-	//	/// <summary>
-	//	/// Linearly interpolates between two Quaternions.
-	//	/// </summary>
-	//	/// <param name="aQuaternion">Source Quaternion.</param>
-	//	/// <param name="anOtherQuaternion">Source Quaternion.</param>
-	//	/// <param name="anAmount">Value indicating how far to interpolate between the quaternions.</param>
-	//	/// <returns>The interpolated Quaternion.</returns>
-	//	static constexpr Quaternion Lerp(const Quaternion& aQuaternion, const Quaternion& anOtherQuaternion, const T& anAmount)
-	//	{
-	//		const T scale = static_cast<T>(1) - anAmount;
-	//		return (aQuaternion * scale) + (anOtherQuaternion * anAmount);
-	//	}
-
-	//	/// <summary>
-	//	/// Interpolates between two quaternions, using spherical linear interpolation.
-	//	/// </summary>
-	//	/// <param name="aQuaternion">Source Quaternion.</param>
-	//	/// <param name="anOtherQuaternion">Source Quaternion.</param>
-	//	/// <param name="anAmount">Value indicating how far to interpolate between the quaternions.</param>
-	//	/// <returns>The interpolated Quaternion.</returns>
-	//	static constexpr Quaternion Slerp(const Quaternion& aQuaternion, const Quaternion& anOtherQuaternion, const T& anAmount)
-	//	{
-	//		const Float32 threshold(0);
-
-	//		Quaternion q1 = aQuaternion;
-	//		Quaternion q2 = anOtherQuaternion;
-
-	//		T angle = Quaternion::Dot(q1, q2);
-
-	//		if (angle < static_cast<T>(0.0))
-	//		{
-	//			q1 *= static_cast<T>(-1.0);
-	//			angle *= static_cast<T>(-1.0);
-	//		}
-
-	//		if (angle <= (1 - threshold)) // spherical interpolation
-	//		{
-	//			const T theta = Math::ArcCosine(angle);
-	//			const T invsintheta = Math::Reciprocal(Math::Sine(theta));
-	//			const T scale = Math::Sine(theta * (1.0f - anAmount)) * invsintheta;
-	//			const T invscale = Math::Sine(theta * anAmount) * invsintheta;
-
-	//			Quaternion quaternion((q1 * scale) + (q2 * invscale));
-	//			return quaternion;
-	//		}
-	//		else // linear interpolation
-	//		{
-	//			return Lerp(q1, q2, anAmount);
-	//		}
-	//	}
-
-	//public:
-	//	constexpr Quaternion()
-	//		: Quaternion(0, 0, 0, 0)
-	//	{ }
-
-	//	/// <summary>
-	//	/// Initializes a new instance of Quaternion.
-	//	/// </summary>
-	//	/// <param name="anX">The x-value of the quaternion.</param>
-	//	/// <param name="aY">The y-value of the quaternion.</param>
-	//	/// <param name="aZ">The z-value of the quaternion.</param>
-	//	/// <param name="aW">The w-value of the quaternion.</param>
-	//	constexpr Quaternion(const T& anX, const T& aY, const T& aZ, const T& aW)
-	//		: X(anX)
-	//		, Y(aY)
-	//		, Z(aZ)
-	//		, W(aW)
-	//	{ }
-
-	//	/// <summary>
-	//	/// Initializes a new instance of Quaternion.
-	//	/// </summary>
-	//	/// <param name="aVectorPart">The vector component of the Quaternion.</param>
-	//	/// <param name="aScalarPart">The rotation component of the quaternion.</param>
-	//	explicit constexpr Quaternion(const Vector3& aVectorPart, const T& aScalarPart)
-	//		: X(aVectorPart.X)
-	//		, Y(aVectorPart.Y)
-	//		, Z(aVectorPart.Z)
-	//		, W(aScalarPart)
-	//	{ }
-
-	//	void Normalize()
-	//	{
-	//		operator*=(Math::ReciprocalSquareroot(Quaternion::Dot(*this, *this)));
-	//	}
-
-	//	void Set(const T& anX, const T& aY, const T& aZ)
-	//	{
-	//		Float64 angle;
-
-	//		angle = static_cast<Float64>(anX) * static_cast<Float64>(0.5);
-	//		const Float64 sr = Math::Sine(angle);
-	//		const Float64 cr = Math::Cosine(angle);
-
-	//		angle = static_cast<Float64>(aY) * static_cast<Float64>(0.5);
-	//		const Float64 sp = Math::Sine(angle);
-	//		const Float64 cp = Math::Cosine(angle);
-
-	//		angle = static_cast<Float64>(aZ) * static_cast<Float64>(0.5);
-	//		const Float64 sy = Math::Sine(angle);
-	//		const Float64 cy = Math::Cosine(angle);
-
-	//		const Float64 cpcy = cp * cy;
-	//		const Float64 spcy = sp * cy;
-	//		const Float64 cpsy = cp * sy;
-	//		const Float64 spsy = sp * sy;
-
-	//		X = static_cast<Float32>(sr * cpcy - cr * spsy);
-	//		Y = static_cast<Float32>(cr * spcy + sr * cpsy);
-	//		Z = static_cast<Float32>(cr * cpsy - sr * spcy);
-	//		W = static_cast<Float32>(cr * cpcy + sr * spsy);
-
-	//		*this = Quaternion::Normalize(*this);
-	//	}
-
-	//	void ToAxisAngle(Vector3& anAxisOut, Float32& anAngleOut) const
-	//	{
-	//		const Float32 scale = Math::Squareroot(X * X + Y * Y + Z * Z);
-
-	//		if (Math::IsZero(scale) || W > static_cast<Float32>(1.0) || W < static_cast<Float32>(-1.0))
-	//		{
-	//			anAngleOut = static_cast<Float32>(0);
-	//			anAxisOut.X = static_cast<Float32>(0);
-	//			anAxisOut.Y = static_cast<Float32>(1);
-	//			anAxisOut.Z = static_cast<Float32>(0);
-	//		}
-	//		else
-	//		{
-	//			const Float32 invscale = Math::Reciprocal(scale);
-
-	//			anAngleOut = static_cast<Float32>(2.0 * Math::ArcCosine(W));
-	//			anAxisOut.X = static_cast<Float32>(X * invscale);
-	//			anAxisOut.Y = static_cast<Float32>(Y * invscale);
-	//			anAxisOut.Z = static_cast<Float32>(Z * invscale);
-	//		}
-	//	}
-
-	//	void ToEulerAngles(Vector3& anEulerOut) const
-	//	{
-	//		const Float64 sqw = W * W;
-	//		const Float64 sqx = X * X;
-	//		const Float64 sqy = Y * Y;
-	//		const Float64 sqz = Z * Z;
-	//		const Float64 test = 2.0 * (Y * W - X * Z);
-
-	//		if (Math::Equals(test, static_cast<Float64>(1), static_cast<Float64>(0.000001)))
-	//		{
-	//			// heading = rotation about z-axis
-	//			anEulerOut.Z = (Float32)(-2.0 * Math::ArcTangent2(X, W));
-	//			// bank = rotation about x-axis
-	//			anEulerOut.X = 0;
-	//			// attitude = rotation about y-axis
-	//			anEulerOut.Y = (Float32)(Math::Pi64 / 2.0);
-	//		}
-	//		else if (Math::Equals(test, static_cast<Float64>(-1), static_cast<Float64>(0.000001)))
-	//		{
-	//			// heading = rotation about z-axis
-	//			anEulerOut.Z = (Float32)(2.0 * Math::ArcTangent2(X, W));
-	//			// bank = rotation about x-axis
-	//			anEulerOut.X = 0;
-	//			// attitude = rotation about y-axis
-	//			anEulerOut.Y = (Float32)(Math::Pi64 / -2.0);
-	//		}
-	//		else
-	//		{
-	//			// heading = rotation about z-axis
-	//			anEulerOut.Z = (Float32)Math::ArcTangent2(2.0 * (X * Y + Z * W), (sqx - sqy - sqz + sqw));
-	//			// bank = rotation about x-axis
-	//			anEulerOut.X = (Float32)Math::ArcTangent2(2.0 * (Y * Z + X * W), (-sqx - sqy + sqz + sqw));
-	//			// attitude = rotation about y-axis
-	//			anEulerOut.Y = (Float32)Math::ArcSine(Math::Clamp(test, -1.0, 1.0));
-	//		}
-	//	}
-
-	//	void operator+=(const Quaternion& aQuaternion)
-	//	{
-	//		X += aQuaternion.X;
-	//		Y += aQuaternion.Y;
-	//		Z += aQuaternion.Z;
-	//		W += aQuaternion.W;
-	//	}
-
-	//	void operator*=(const Quaternion& aQuaternion)
-	//	{
-	//		Quaternion quat(*this);
-
-	//		W = (aQuaternion.W * quat.W) - (aQuaternion.X * quat.X) -
-	//			(aQuaternion.Y * quat.Y) - (aQuaternion.Z * quat.Z);
-
-	//		X = (aQuaternion.W * quat.X) + (aQuaternion.X * quat.W) +
-	//			(aQuaternion.Y * quat.Z) - (aQuaternion.Z * quat.Y);
-
-	//		Y = (aQuaternion.W * quat.Y) + (aQuaternion.Y * quat.W) +
-	//			(aQuaternion.Z * quat.X) - (aQuaternion.X * quat.Z);
-
-	//		Z = (aQuaternion.W * quat.Z) + (aQuaternion.Z * quat.W) +
-	//			(aQuaternion.X * quat.Y) - (aQuaternion.Y * quat.X);
-	//	}
-
-	//	void operator*=(const T& aScalar)
-	//	{
-	//		X *= aScalar;
-	//		Y *= aScalar;
-	//		Z *= aScalar;
-	//		W *= aScalar;
-	//	}
-
-	//	Vector3 operator*=(const Vector3& aScalar)
-	//	{
-	//		// nVidia SDK implementation
-
-	//		Vector3 uv, uuv;
-	//		Vector3 qvec(X, Y, Z);
-	//		uv = Vector3<T>::Cross(qvec, aVector);
-	//		uuv = Vector3<T>::Cross(qvec, uv);
-	//		uv *= (2.0f * W);
-	//		uuv *= 2.0f;
-
-	//		return aVector + uv + uuv;
-	//	}
-
-	//	bool operator==(const Quaternion& b) const
-	//	{
-	//		return Math::Equals(X, b.X)
-	//			&& Math::Equals(Y, b.Y)
-	//			&& Math::Equals(Z, b.Z)
-	//			&& Math::Equals(W, b.W);
-	//	}
-
-	//	bool operator!=(const Quaternion& b) const
-	//	{
-	//		return !operator==(b);
-	//	}
-
-	//public:
-	//	/// <summary>The X-value of the quaternion vector component.</summary>
-	//	T X;
-	//	/// <summary>The Y-value of the quaternion vector component.</summary>
-	//	T Y;
-	//	/// <summary>The Z-value of the quaternion vector component.</summary>
-	//	T Z;
-	//	/// <summary>The rotation component of the quaternion</summary>
-	//	T W;
-	//};
+	/**
+	 * @brief A rotation in 3D, stored as a unit quaternion.
+	 *        Quaternions combine and convert in the same order as Matrix3D, so (a * b).ToMatrix() equals a.ToMatrix() * b.ToMatrix(), rotating by a first.
+	 * @tparam T A type used for each component.
+	 */
+	template <typename T>
+	class Quaternion
+	{
+	public:
+
+		//--------------------------------------------------
+		// * Types
+		//--------------------------------------------------
+		#pragma region Types
+
+		using ComponentType = T;
+
+		#pragma endregion
+
+		//--------------------------------------------------
+		// * Static constants
+		//--------------------------------------------------
+		#pragma region Static constants
+
+		/**
+		 * @brief Create a quaternion representing no rotation.
+		 */
+		static constexpr Quaternion Identity() { return { 0, 0, 0, 1 }; }
+
+		#pragma endregion
+
+		//--------------------------------------------------
+		// * Construction
+		//--------------------------------------------------
+		#pragma region Construction
+
+		/**
+		 * @brief Initialize to no rotation.
+		 */
+		constexpr Quaternion();
+
+		/**
+		 * @brief Initialize each component to the specified value.
+		 * @param anX Value of the X component.
+		 * @param aY Value of the Y component.
+		 * @param aZ Value of the Z component.
+		 * @param aW Value of the W component.
+		 */
+		constexpr Quaternion(const T& anX, const T& aY, const T& aZ, const T& aW);
+
+		/**
+		 * @brief Initialize the components from a vector part and a scalar part.
+		 * @param aVectorPart The X, Y and Z components.
+		 * @param aScalarPart The W component.
+		 */
+		explicit constexpr Quaternion(const Vector3<T>& aVectorPart, const T& aScalarPart);
+
+		/**
+		 * @brief Create a quaternion that rotates around an arbitrary axis, the same way as Matrix3D::CreateFromAxisAngle().
+		 * @param anAxis A normalized vector specifying the axis.
+		 * @param anAngle The amount, in radians, in which to rotate.
+		 * @return The rotation.
+		 */
+		static constexpr Quaternion CreateFromAxisAngle(const Vector3<T>& anAxis, const T& anAngle) requires(IsFractional<T>);
+
+		#pragma endregion
+
+		//--------------------------------------------------
+		// * Properties
+		//--------------------------------------------------
+		#pragma region Properties
+
+		/**
+		 * @brief The X-component of the vector part.
+		 */
+		T X;
+
+		/**
+		 * @brief The Y-component of the vector part.
+		 */
+		T Y;
+
+		/**
+		 * @brief The Z-component of the vector part.
+		 */
+		T Z;
+
+		/**
+		 * @brief The scalar part.
+		 */
+		T W;
+
+		#pragma endregion
+
+		//--------------------------------------------------
+		// * Methods
+		//--------------------------------------------------
+		#pragma region Methods
+
+		/**
+		 * @brief Get the conjugate, which for a unit quaternion is the opposite rotation.
+		 */
+		constexpr Quaternion Conjugate() const { return Quaternion(-X, -Y, -Z, W); }
+
+		/**
+		 * @brief Calculate the dot product of two quaternions.
+		 *        Its sign tells whether they're on the same side of the 4D sphere, where interpolating between them takes the shortest path.
+		 */
+		static constexpr T Dot(const Quaternion& aValue1, const Quaternion& aValue2);
+
+		/**
+		 * @brief Get the inverse, undoing the rotation even if the quaternion isn't normalized.
+		 */
+		constexpr Quaternion Inverse() const;
+
+		/**
+		 * @brief Calculate the length of the quaternion, which is one for rotations.
+		 */
+		constexpr T Length() const;
+
+		/**
+		 * @brief Calculate the squared length of the quaternion.
+		 */
+		constexpr T LengthSquared() const;
+
+		/**
+		 * @brief Interpolate linearly between two rotations along the shortest path, and normalize the result.
+		 * @param aValue1 Source rotation.
+		 * @param aValue2 Source rotation.
+		 * @param anAmount Value between 0 and 1 indicating the weight of the second rotation.
+		 * @return The interpolated rotation.
+		 */
+		static constexpr Quaternion Lerp(const Quaternion& aValue1, const Quaternion& aValue2, const T& anAmount) requires(IsFractional<T>);
+
+		/**
+		 * @brief Get the quaternion scaled to a length of one.
+		 */
+		constexpr Quaternion Normalized() const requires(IsFractional<T>);
+
+		/**
+		 * @brief Rotate a vector.
+		 * @param aVector The vector to rotate.
+		 * @return The same as multiplying the vector by ToMatrix().
+		 */
+		constexpr Vector3<T> Rotate(const Vector3<T>& aVector) const;
+
+		/**
+		 * @brief Interpolate between two rotations at a constant angular speed along the shortest path.
+		 * @param aValue1 Source rotation.
+		 * @param aValue2 Source rotation.
+		 * @param anAmount Value between 0 and 1 indicating the weight of the second rotation.
+		 * @return The interpolated rotation.
+		 */
+		static constexpr Quaternion Slerp(const Quaternion& aValue1, const Quaternion& aValue2, const T& anAmount) requires(IsFractional<T>);
+
+		/**
+		 * @brief Get the rotation as a matrix.
+		 */
+		constexpr Matrix3D<T> ToMatrix() const;
+
+		/**
+		 * @brief Get the components as a Vector4 (X, Y, Z, W).
+		 */
+		constexpr Vector4<T> ToVector() const { return Vector4<T>(X, Y, Z, W); }
+
+		#pragma endregion
+
+		//--------------------------------------------------
+		// * Operators
+		//--------------------------------------------------
+		#pragma region Operators
+
+		inline constexpr Quaternion operator-() const { return Quaternion(-X, -Y, -Z, -W); }
+
+		inline constexpr Quaternion operator+(const Quaternion& aQuaternion) const { return Quaternion(X + aQuaternion.X, Y + aQuaternion.Y, Z + aQuaternion.Z, W + aQuaternion.W); }
+		inline constexpr Quaternion operator-(const Quaternion& aQuaternion) const { return Quaternion(X - aQuaternion.X, Y - aQuaternion.Y, Z - aQuaternion.Z, W - aQuaternion.W); }
+		inline constexpr Quaternion operator*(const T& aScalar) const { return Quaternion(X * aScalar, Y * aScalar, Z * aScalar, W * aScalar); }
+
+		/**
+		 * @brief Combine two rotations, rotating by this one first and then the other.
+		 */
+		constexpr Quaternion operator*(const Quaternion& aQuaternion) const;
+
+		inline void operator*=(const Quaternion& aQuaternion) { (*this) = (*this) * aQuaternion; }
+		inline void operator*=(const T& aScalar) { (*this) = (*this) * aScalar; }
+
+		inline constexpr bool operator==(const Quaternion& aQuaternion) const { return X == aQuaternion.X && Y == aQuaternion.Y && Z == aQuaternion.Z && W == aQuaternion.W; }
+
+		#pragma endregion
+	};
+
+	namespace _impl
+	{
+		template <typename T>
+		struct VectorTraits<Quaternion<T>>
+		{
+			using Component = T;
+			static constexpr std::size_t Count = 4;
+			static constexpr T Get(const Quaternion<T>& aQuaternion, std::size_t anIndex) { return anIndex == 0 ? aQuaternion.X : (anIndex == 1 ? aQuaternion.Y : (anIndex == 2 ? aQuaternion.Z : aQuaternion.W)); }
+			static constexpr void Set(Quaternion<T>& aQuaternion, std::size_t anIndex, T aComponent) { (anIndex == 0 ? aQuaternion.X : (anIndex == 1 ? aQuaternion.Y : (anIndex == 2 ? aQuaternion.Z : aQuaternion.W))) = aComponent; }
+		};
+	}
+}
+
+namespace RoseCommon::Math
+{
+	template <typename T>
+	constexpr Quaternion<T>::Quaternion()
+		: Quaternion(0, 0, 0, 1)
+	{
+
+	}
+
+	template <typename T>
+	constexpr Quaternion<T>::Quaternion(const T& anX, const T& aY, const T& aZ, const T& aW)
+		: X(anX)
+		, Y(aY)
+		, Z(aZ)
+		, W(aW)
+	{
+
+	}
+
+	template <typename T>
+	constexpr Quaternion<T>::Quaternion(const Vector3<T>& aVectorPart, const T& aScalarPart)
+		: Quaternion(aVectorPart.X, aVectorPart.Y, aVectorPart.Z, aScalarPart)
+	{
+
+	}
+
+	template <typename T>
+	constexpr Quaternion<T> Quaternion<T>::CreateFromAxisAngle(const Vector3<T>& anAxis, const T& anAngle) requires(IsFractional<T>)
+	{
+		const T halfAngle = anAngle / T(2);
+		const T s = Math::Sine<T>(halfAngle);
+		return Quaternion(anAxis * s, Math::Cosine<T>(halfAngle));
+	}
+
+	template <typename T>
+	constexpr T Quaternion<T>::Dot(const Quaternion& aValue1, const Quaternion& aValue2)
+	{
+		return
+			(aValue1.X * aValue2.X) +
+			(aValue1.Y * aValue2.Y) +
+			(aValue1.Z * aValue2.Z) +
+			(aValue1.W * aValue2.W);
+	}
+
+	template <typename T>
+	constexpr Quaternion<T> Quaternion<T>::Inverse() const
+	{
+		const Quaternion conjugate = Conjugate();
+		const T lengthSquared = LengthSquared();
+		return Quaternion(conjugate.X / lengthSquared, conjugate.Y / lengthSquared, conjugate.Z / lengthSquared, conjugate.W / lengthSquared);
+	}
+
+	template <typename T>
+	constexpr T Quaternion<T>::Length() const
+	{
+		return Math::Squareroot(LengthSquared());
+	}
+
+	template <typename T>
+	constexpr T Quaternion<T>::LengthSquared() const
+	{
+		return Dot(*this, *this);
+	}
+
+	template <typename T>
+	constexpr Quaternion<T> Quaternion<T>::Lerp(const Quaternion& aValue1, const Quaternion& aValue2, const T& anAmount) requires(IsFractional<T>)
+	{
+		const Quaternion target = Dot(aValue1, aValue2) < T(0) ? -aValue2 : aValue2;
+		return (aValue1 + (target - aValue1) * anAmount).Normalized();
+	}
+
+	template <typename T>
+	constexpr Quaternion<T> Quaternion<T>::Normalized() const requires(IsFractional<T>)
+	{
+		const T length = Length();
+		return Quaternion(X / length, Y / length, Z / length, W / length);
+	}
+
+	template <typename T>
+	constexpr Vector3<T> Quaternion<T>::Rotate(const Vector3<T>& aVector) const
+	{
+		// v + 2w(u x v) + 2u x (u x v), with u the vector part, rotated in the same direction as the matrix.
+		const Vector3<T> vectorPart(X, Y, Z);
+		const Vector3<T> uv = Vector3<T>::Cross(vectorPart, aVector);
+		const Vector3<T> uuv = Vector3<T>::Cross(vectorPart, uv);
+		return aVector + uv * (W * T(2)) + uuv * T(2);
+	}
+
+	template <typename T>
+	constexpr Quaternion<T> Quaternion<T>::Slerp(const Quaternion& aValue1, const Quaternion& aValue2, const T& anAmount) requires(IsFractional<T>)
+	{
+		T cosine = Dot(aValue1, aValue2);
+		Quaternion target = aValue2;
+		if (cosine < T(0))
+		{
+			cosine = -cosine;
+			target = -aValue2;
+		}
+
+		// Close rotations fall back to interpolating linearly, where the sine of the angle gets too small to divide by.
+		if (cosine > T(1) - std::numeric_limits<T>::epsilon() * T(64))
+			return Lerp(aValue1, target, anAmount);
+
+		const T angle = Math::ArcCosine<T>(cosine);
+		const T sine = Math::Sine<T>(angle);
+		const T weight1 = Math::Sine<T>((T(1) - anAmount) * angle) / sine;
+		const T weight2 = Math::Sine<T>(anAmount * angle) / sine;
+
+		// Math::Sine() is an approximation, so the weights don't quite keep the length at one by themselves.
+		return (aValue1 * weight1 + target * weight2).Normalized();
+	}
+
+	template <typename T>
+	constexpr Matrix3D<T> Quaternion<T>::ToMatrix() const
+	{
+		const T xx = X * X, yy = Y * Y, zz = Z * Z;
+		const T xy = X * Y, xz = X * Z, yz = Y * Z;
+		const T xw = X * W, yw = Y * W, zw = Z * W;
+
+		Matrix3D<T> result = Matrix3D<T>::Identity();
+
+		result.GetCell(0, 0) = T(1) - T(2) * (yy + zz);
+		result.GetCell(1, 0) = T(2) * (xy + zw);
+		result.GetCell(2, 0) = T(2) * (xz - yw);
+
+		result.GetCell(0, 1) = T(2) * (xy - zw);
+		result.GetCell(1, 1) = T(1) - T(2) * (xx + zz);
+		result.GetCell(2, 1) = T(2) * (yz + xw);
+
+		result.GetCell(0, 2) = T(2) * (xz + yw);
+		result.GetCell(1, 2) = T(2) * (yz - xw);
+		result.GetCell(2, 2) = T(1) - T(2) * (xx + yy);
+
+		return result;
+	}
+
+	template <typename T>
+	constexpr Quaternion<T> Quaternion<T>::operator*(const Quaternion& aQuaternion) const
+	{
+		// The Hamilton product of the other and this, so this rotation applies first like with row vectors and matrices.
+		const Quaternion& a = aQuaternion;
+		return Quaternion(
+			(a.W * X) + (a.X * W) + (a.Y * Z) - (a.Z * Y),
+			(a.W * Y) + (a.Y * W) + (a.Z * X) - (a.X * Z),
+			(a.W * Z) + (a.Z * W) + (a.X * Y) - (a.Y * X),
+			(a.W * W) - (a.X * X) - (a.Y * Y) - (a.Z * Z)
+		);
+	}
 }
@@ -0,0 +1,699 @@
+#pragma once
+
+#include "AxisAlignedBox.hpp"
+#include "Common.hpp"
+#include "Vector.hpp"
+
+#include "../Simd.hpp"
+
+#include <array>
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+namespace RoseCommon::Math
+{
+	template <typename T>
+	class TriangleBatch;
+
+	/**
+	 * @brief A half-line from an origin in a direction, with the reciprocal of the direction kept for slab tests.
+	 *        Distances along the ray are in multiples of the direction vector, which does not need to be normalized.
+	 * @tparam T A floating-point type for each component.
+	 */
+	template <typename T>
+	class Ray
+	{
+	public:
+
+		//--------------------------------------------------
+		// * Types
+		//--------------------------------------------------
+		#pragma region Types
+
+		using ComponentType = T;
+
+		/**
+		 * @brief Where a ray hits a triangle.
+		 */
+		struct TriangleHit
+		{
+			/**
+			 * @brief The distance along the ray.
+			 */
+			T Distance;
+
+			/**
+			 * @brief The barycentric weight of the second vertex.
+			 */
+			T U;
+
+			/**
+			 * @brief The barycentric weight of the third vertex.
+			 */
+			T V;
+		};
+
+		#pragma endregion
+
+		//--------------------------------------------------
+		// * Construction
+		//--------------------------------------------------
+		#pragma region Construction
+
+		/**
+		 * @brief Initialize to the specified origin and direction.
+		 * @param anOrigin The point the ray starts from.
+		 * @param aDirection The direction of the ray.
+		 */
+		constexpr Ray(const Vector3<T>& anOrigin, const Vector3<T>& aDirection);
+
+		#pragma endregion
+
+		//--------------------------------------------------
+		// * Properties
+		//--------------------------------------------------
+		#pragma region Properties
+
+		/**
+		 * @brief Get the point the ray starts from.
+		 */
+		constexpr const Vector3<T>& GetOrigin() const { return myOrigin; }
+
+		/**
+		 * @brief Set the point the ray starts from.
+		 */
+		constexpr void SetOrigin(const Vector3<T>& anOrigin) { myOrigin = anOrigin; }
+
+		/**
+		 * @brief Get the direction of the ray.
+		 */
+		constexpr const Vector3<T>& GetDirection() const { return myDirection; }
+
+		/**
+		 * @brief Set the direction of the ray, updating its reciprocal.
+		 */
+		constexpr void SetDirection(const Vector3<T>& aDirection);
+
+		/**
+		 * @brief Get the reciprocal of each component of the direction, being infinite for zero components.
+		 */
+		constexpr const Vector3<T>& GetInverseDirection() const { return myInverseDirection; }
+
+		#pragma endregion
+
+		//--------------------------------------------------
+		// * Methods
+		//--------------------------------------------------
+		#pragma region Methods
+
+		/**
+		 * @brief Get the point at a distance along the ray.
+		 * @param aDistance The distance, in multiples of the direction.
+		 */
+		constexpr Vector3<T> GetPoint(T aDistance) const { return myOrigin + myDirection * Vector3<T>(aDistance); }
+
+		/**
+		 * @brief Check whether the ray hits a box, using the slab method. Rays starting inside the box hit at distance zero.
+		 * @param aBox The box to test.
+		 * @param aMaxDistance The length of the ray.
+		 * @return The distance at which the ray enters the box, if it is hit.
+		 */
+		constexpr std::optional<T> Intersects(const AxisAlignedBox<T>& aBox, T aMaxDistance = std::numeric_limits<T>::max()) const;
+
+		/**
+		 * @brief Test which boxes are hit by the ray.
+		 * @param someBoxes The boxes to test.
+		 * @param aMaxDistance The length of the ray.
+		 * @param someResultMasks The bitmask to write the results to.
+		 */
+		void Intersects(const AxisAlignedBoxBatch<T>& someBoxes, T aMaxDistance, std::span<std::uint64_t> someResultMasks) const;
+
+		/**
+		 * @brief Check whether the ray hits a triangle from either side, using the Möller-Trumbore algorithm.
+		 * @param aVertex0 The first vertex of the triangle.
+		 * @param aVertex1 The second vertex of the triangle.
+		 * @param aVertex2 The third vertex of the triangle.
+		 * @param aMaxDistance The length of the ray.
+		 * @return The hit distance and barycentric coordinates, if the triangle is hit.
+		 */
+		constexpr std::optional<TriangleHit> IntersectsTriangle(const Vector3<T>& aVertex0, const Vector3<T>& aVertex1, const Vector3<T>& aVertex2, T aMaxDistance = std::numeric_limits<T>::max()) const;
+
+		/**
+		 * @brief Test which triangles are hit by the ray.
+		 * @param someTriangles The triangles to test.
+		 * @param aMaxDistance The length of the ray.
+		 * @param someResultMasks The bitmask to write the results to.
+		 * @param someDistances Optional buffer with one value per triangle, which gets the hit distance of each triangle that is hit.
+		 */
+		void IntersectsTriangles(const TriangleBatch<T>& someTriangles, T aMaxDistance, std::span<std::uint64_t> someResultMasks, std::span<T> someDistances = {}) const;
+
+		#pragma endregion
+
+	private:
+		Vector3<T> myOrigin;
+		Vector3<T> myDirection;
+		Vector3<T> myInverseDirection;
+	};
+
+	/**
+	 * @brief A structure-of-arrays collection of triangles, for testing one ray against many triangles at a time.
+	 *        Results are written as bitmasks, see Simd::GetMaskWordCount() for the required mask size.
+	 * @tparam T A floating-point type for each component. Single-precision floats use SSE/AVX when available.
+	 */
+	template <typename T>
+	class TriangleBatch
+	{
+	public:
+
+		//--------------------------------------------------
+		// * Construction
+		//--------------------------------------------------
+		#pragma region Construction
+
+		/**
+		 * @brief Initialize an empty batch.
+		 */
+		TriangleBatch() = default;
+
+		/**
+		 * @brief Initialize with a copy of the specified triangles.
+		 * @param someVertices Three vertices for each triangle.
+		 */
+		explicit TriangleBatch(std::span<const Vector3<T>> someVertices);
+
+		#pragma endregion
+
+		//--------------------------------------------------
+		// * Properties
+		//--------------------------------------------------
+		#pragma region Properties
+
+		/**
+		 * @brief Get the number of triangles in the batch.
+		 */
+		std::size_t Size() const { return myVertexX.size(); }
+
+		#pragma endregion
+
+		//--------------------------------------------------
+		// * Methods
+		//--------------------------------------------------
+		#pragma region Methods
+
+		/**
+		 * @brief Add a triangle to the end of the batch.
+		 * @param aVertex0 The first vertex of the triangle.
+		 * @param aVertex1 The second vertex of the triangle.
+		 * @param aVertex2 The third vertex of the triangle.
+		 */
+		void Add(const Vector3<T>& aVertex0, const Vector3<T>& aVertex1, const Vector3<T>& aVertex2);
+
+		/**
+		 * @brief Remove all triangles from the batch.
+		 */
+		void Clear();
+
+		/**
+		 * @brief Reserve memory for a number of triangles.
+		 * @param aCount The number of triangles to reserve memory for.
+		 */
+		void Reserve(std::size_t aCount);
+
+		/**
+		 * @brief Test which triangles are hit by a ray from either side, using the Möller-Trumbore algorithm.
+		 * @param aRay The ray to test.
+		 * @param aMaxDistance The length of the ray.
+		 * @param someResultMasks The bitmask to write the results to.
+		 * @param someDistances Optional buffer with one value per triangle, which gets the hit distance of each triangle that is hit.
+		 */
+		void IntersectsRay(const Ray<T>& aRay, T aMaxDistance, std::span<std::uint64_t> someResultMasks, std::span<T> someDistances = {}) const;
+
+		#pragma endregion
+
+	private:
+		// The first vertex, and the edges from it to the other two.
+		std::vector<T> myVertexX, myVertexY, myVertexZ;
+		std::vector<T> myEdge1X, myEdge1Y, myEdge1Z;
+		std::vector<T> myEdge2X, myEdge2Y, myEdge2Z;
+	};
+
+	/**
+	 * @brief A fixed number of rays stored as a structure of arrays, for testing many rays against one primitive at a time.
+	 *        Coherent rays, such as those from neighbouring pixels, tend to visit the same primitives and so share the work.
+	 * @tparam T A floating-point type for each component. Single-precision floats use SSE/AVX when available.
+	 * @tparam Width The number of rays, up to 64. Multiples of the native SIMD width use only full packs.
+	 */
+	template <typename T, std::size_t Width>
+	class RayPacket
+	{
+		static_assert(Width > 0 && Width <= Simd::MaskWordBits, "Packet results need to fit in a single mask word.");
+
+	public:
+
+		//--------------------------------------------------
+		// * Construction
+		//--------------------------------------------------
+		#pragma region Construction
+
+		/**
+		 * @brief Initialize with all rays at the origin, pointing along the Z axis.
+		 */
+		RayPacket();
+
+		/**
+		 * @brief Initialize with a copy of the specified rays.
+		 * @param someRays The rays to copy.
+		 */
+		explicit RayPacket(std::span<const Ray<T>, Width> someRays);
+
+		#pragma endregion
+
+		//--------------------------------------------------
+		// * Properties
+		//--------------------------------------------------
+		#pragma region Properties
+
+		/**
+		 * @brief Get a ray from the packet.
+		 * @param anIndex The index of the ray.
+		 * @return A copy of the ray.
+		 */
+		Ray<T> Get(std::size_t anIndex) const;
+
+		/**
+		 * @brief Replace a ray in the packet.
+		 * @param anIndex The index of the ray.
+		 * @param aRay The new ray.
+		 */
+		void Set(std::size_t anIndex, const Ray<T>& aRay);
+
+		#pragma endregion
+
+		//--------------------------------------------------
+		// * Methods
+		//--------------------------------------------------
+		#pragma region Methods
+
+		/**
+		 * @brief Test which rays hit a box, using the slab method.
+		 * @param aBox The box to test.
+		 * @param someMaxDistances The length of each ray.
+		 * @return One bit per ray, with the first ray in the lowest bit.
+		 */
+		std::uint64_t Intersects(const AxisAlignedBox<T>& aBox, std::span<const T, Width> someMaxDistances) const;
+
+		/**
+		 * @brief Test which rays hit a triangle from either side closer than their current distance, using the Möller-Trumbore algorithm.
+		 *        Testing each candidate triangle in turn leaves the closest hit distance of each ray.
+		 * @param aVertex0 The first vertex of the triangle.
+		 * @param aVertex1 The second vertex of the triangle.
+		 * @param aVertex2 The third vertex of the triangle.
+		 * @param someDistances The length of each ray, which is shortened to the hit distance for each ray that hits.
+		 * @return One bit per ray, with the first ray in the lowest bit.
+		 */
+		std::uint64_t IntersectsTriangle(const Vector3<T>& aVertex0, const Vector3<T>& aVertex1, const Vector3<T>& aVertex2, std::span<T, Width> someDistances) const;
+
+		#pragma endregion
+
+	private:
+		std::array<T, Width> myOriginX, myOriginY, myOriginZ;
+		std::array<T, Width> myDirectionX, myDirectionY, myDirectionZ;
+		std::array<T, Width> myInverseX, myInverseY, myInverseZ;
+	};
+
+	/**
+	 * @brief A packet of four rays, filling an SSE register.
+	 */
+	template <typename T>
+	using RayPacket4 = RayPacket<T, 4>;
+
+	/**
+	 * @brief A packet of eight rays, filling an AVX register.
+	 */
+	template <typename T>
+	using RayPacket8 = RayPacket<T, 8>;
+
+	/**
+	 * @brief A packet of sixteen rays, such as a 4x4 pixel tile.
+	 */
+	template <typename T>
+	using RayPacket16 = RayPacket<T, 16>;
+}
+
+namespace RoseCommon::Math
+{
+	namespace _impl
+	{
+		/**
+		 * @brief Three packs holding the components of one vector per lane.
+		 */
+		template <typename Pack>
+		struct PackedVector3
+		{
+			Pack X, Y, Z;
+
+			PackedVector3 operator-(const PackedVector3& aVector) const { return { X - aVector.X, Y - aVector.Y, Z - aVector.Z }; }
+
+			static Pack Dot(const PackedVector3& aValue1, const PackedVector3& aValue2) { return aValue1.X * aValue2.X + aValue1.Y * aValue2.Y + aValue1.Z * aValue2.Z; }
+
+			static PackedVector3 Cross(const PackedVector3& aValue1, const PackedVector3& aValue2)
+			{
+				return {
+					aValue1.Y * aValue2.Z - aValue1.Z * aValue2.Y,
+					aValue1.Z * aValue2.X - aValue1.X * aValue2.Z,
+					aValue1.X * aValue2.Y - aValue1.Y * aValue2.X
+				};
+			}
+		};
+
+		template <typename Pack, typename T>
+		PackedVector3<Pack> BroadcastVector3(const Vector3<T>& aVector)
+		{
+			return { Pack::Broadcast(aVector.X), Pack::Broadcast(aVector.Y), Pack::Broadcast(aVector.Z) };
+		}
+
+		template <typename Pack, typename T>
+		PackedVector3<Pack> LoadVector3(const T* someX, const T* someY, const T* someZ)
+		{
+			return { Pack::Load(someX), Pack::Load(someY), Pack::Load(someZ) };
+		}
+
+		/**
+		 * @brief Möller-Trumbore ray-triangle intersection for a pack of rays and triangles, accepting hits from either side.
+		 * @param anOrigin The ray origins.
+		 * @param aDirection The ray directions.
+		 * @param aVertex The first vertex of each triangle.
+		 * @param anEdge1 The edge from the first to the second vertex.
+		 * @param anEdge2 The edge from the first to the third vertex.
+		 * @param aMaxDistance The length of each ray.
+		 * @param outDistance The hit distance of each lane, only meaningful for lanes that hit.
+		 * @return The mask of lanes that hit within range.
+		 */
+		template <typename Pack>
+		auto IntersectTriangle(const PackedVector3<Pack>& anOrigin, const PackedVector3<Pack>& aDirection, const PackedVector3<Pack>& aVertex, const PackedVector3<Pack>& anEdge1, const PackedVector3<Pack>& anEdge2, const Pack& aMaxDistance, Pack& outDistance)
+		{
+			using Vector = PackedVector3<Pack>;
+
+			const Pack zero = Pack::Broadcast(0);
+			const Pack one = Pack::Broadcast(1);
+
+			const Vector p = Vector::Cross(aDirection, anEdge2);
+			const Pack determinant = Vector::Dot(anEdge1, p);
+
+			// A ray parallel to the triangle gives infinities and NaNs below, which fail the comparisons.
+			const Pack inverseDeterminant = one / determinant;
+
+			const Vector offset = anOrigin - aVertex;
+			const Pack u = Vector::Dot(offset, p) * inverseDeterminant;
+
+			const Vector q = Vector::Cross(offset, anEdge1);
+			const Pack v = Vector::Dot(aDirection, q) * inverseDeterminant;
+
+			outDistance = Vector::Dot(anEdge2, q) * inverseDeterminant;
+
+			return (u >= zero) & (v >= zero) & (u + v <= one) & (outDistance >= zero) & (outDistance <= aMaxDistance);
+		}
+
+		/**
+		 * @brief Slab-method ray-box intersection for a pack of rays and boxes.
+		 * @return The mask of lanes where the ray enters the box within range.
+		 */
+		template <typename Pack>
+		auto IntersectBox(const PackedVector3<Pack>& anOrigin, const PackedVector3<Pack>& anInverseDirection, const PackedVector3<Pack>& aMinimum, const PackedVector3<Pack>& aMaximum, const Pack& aMaxDistance)
+		{
+			const PackedVector3<Pack> nearPlanes = aMinimum - anOrigin;
+			const PackedVector3<Pack> farPlanes = aMaximum - anOrigin;
+
+			const Pack nearX = nearPlanes.X * anInverseDirection.X, farX = farPlanes.X * anInverseDirection.X;
+			const Pack nearY = nearPlanes.Y * anInverseDirection.Y, farY = farPlanes.Y * anInverseDirection.Y;
+			const Pack nearZ = nearPlanes.Z * anInverseDirection.Z, farZ = farPlanes.Z * anInverseDirection.Z;
+
+			const Pack entry = Pack::Max(Pack::Max(Pack::Min(nearX, farX), Pack::Min(nearY, farY)), Pack::Max(Pack::Min(nearZ, farZ), Pack::Broadcast(0)));
+			const Pack exit = Pack::Min(Pack::Min(Pack::Max(nearX, farX), Pack::Max(nearY, farY)), Pack::Min(Pack::Max(nearZ, farZ), aMaxDistance));
+
+			return entry <= exit;
+		}
+	}
+
+	#pragma region Ray implementation
+
+	template <typename T>
+	constexpr Ray<T>::Ray(const Vector3<T>& anOrigin, const Vector3<T>& aDirection)
+		: myOrigin(anOrigin)
+		, myDirection(aDirection)
+		, myInverseDirection(Math::Reciprocal(aDirection.X), Math::Reciprocal(aDirection.Y), Math::Reciprocal(aDirection.Z))
+	{
+
+	}
+
+	template <typename T>
+	constexpr void Ray<T>::SetDirection(const Vector3<T>& aDirection)
+	{
+		myDirection = aDirection;
+		myInverseDirection = Vector3<T>(Math::Reciprocal(aDirection.X), Math::Reciprocal(aDirection.Y), Math::Reciprocal(aDirection.Z));
+	}
+
+	template <typename T>
+	constexpr std::optional<T> Ray<T>::Intersects(const AxisAlignedBox<T>& aBox, T aMaxDistance) const
+	{
+		const Vector3<T> nearPlanes = (aBox.Min - myOrigin) * myInverseDirection;
+		const Vector3<T> farPlanes = (aBox.Max - myOrigin) * myInverseDirection;
+
+		const Vector3<T> entries = Vector3<T>::Min(nearPlanes, farPlanes);
+		const Vector3<T> exits = Vector3<T>::Max(nearPlanes, farPlanes);
+
+		const T entry = Math::Max<T>(Math::Max<T>(entries.X, entries.Y), Math::Max<T>(entries.Z, T(0)));
+		const T exit = Math::Min<T>(Math::Min<T>(exits.X, exits.Y), Math::Min<T>(exits.Z, aMaxDistance));
+
+		if (entry > exit)
+			return { };
+
+		return entry;
+	}
+
+	template <typename T>
+	void Ray<T>::Intersects(const AxisAlignedBoxBatch<T>& someBoxes, T aMaxDistance, std::span<std::uint64_t> someResultMasks) const
+	{
+		someBoxes.IntersectsRay(myOrigin, myInverseDirection, aMaxDistance, someResultMasks);
+	}
+
+	template <typename T>
+	constexpr std::optional<typename Ray<T>::TriangleHit> Ray<T>::IntersectsTriangle(const Vector3<T>& aVertex0, const Vector3<T>& aVertex1, const Vector3<T>& aVertex2, T aMaxDistance) const
+	{
+		const Vector3<T> edge1 = aVertex1 - aVertex0;
+		const Vector3<T> edge2 = aVertex2 - aVertex0;
+
+		const Vector3<T> p = Vector3<T>::Cross(myDirection, edge2);
+		const T determinant = Vector3<T>::Dot(edge1, p);
+		if (determinant == T(0))
+			return { };
+
+		const T inverseDeterminant = T(1) / determinant;
+
+		const Vector3<T> offset = myOrigin - aVertex0;
+		const T u = Vector3<T>::Dot(offset, p) * inverseDeterminant;
+		if (u < T(0) || u > T(1))
+			return { };
+
+		const Vector3<T> q = Vector3<T>::Cross(offset, edge1);
+		const T v = Vector3<T>::Dot(myDirection, q) * inverseDeterminant;
+		if (v < T(0) || u + v > T(1))
+			return { };
+
+		const T distance = Vector3<T>::Dot(edge2, q) * inverseDeterminant;
+		if (distance < T(0) || distance > aMaxDistance)
+			return { };
+
+		return TriangleHit{ distance, u, v };
+	}
+
+	template <typename T>
+	void Ray<T>::IntersectsTriangles(const TriangleBatch<T>& someTriangles, T aMaxDistance, std::span<std::uint64_t> someResultMasks, std::span<T> someDistances) const
+	{
+		someTriangles.IntersectsRay(*this, aMaxDistance, someResultMasks, someDistances);
+	}
+
+	#pragma endregion
+
+	#pragma region TriangleBatch implementation
+
+	template <typename T>
+	TriangleBatch<T>::TriangleBatch(std::span<const Vector3<T>> someVertices)
+	{
+		if (someVertices.size() % 3 != 0)
+			throw std::invalid_argument("Triangle vertices need to come in groups of three.");
+
+		Reserve(someVertices.size() / 3);
+		for (std::size_t i = 0; i < someVertices.size(); i += 3)
+			Add(someVertices[i], someVertices[i + 1], someVertices[i + 2]);
+	}
+
+	template <typename T>
+	void TriangleBatch<T>::Add(const Vector3<T>& aVertex0, const Vector3<T>& aVertex1, const Vector3<T>& aVertex2)
+	{
+		const Vector3<T> edge1 = aVertex1 - aVertex0;
+		const Vector3<T> edge2 = aVertex2 - aVertex0;
+
+		myVertexX.push_back(aVertex0.X);
+		myVertexY.push_back(aVertex0.Y);
+		myVertexZ.push_back(aVertex0.Z);
+		myEdge1X.push_back(edge1.X);
+		myEdge1Y.push_back(edge1.Y);
+		myEdge1Z.push_back(edge1.Z);
+		myEdge2X.push_back(edge2.X);
+		myEdge2Y.push_back(edge2.Y);
+		myEdge2Z.push_back(edge2.Z);
+	}
+
+	template <typename T>
+	void TriangleBatch<T>::Clear()
+	{
+		myVertexX.clear();
+		myVertexY.clear();
+		myVertexZ.clear();
+		myEdge1X.clear();
+		myEdge1Y.clear();
+		myEdge1Z.clear();
+		myEdge2X.clear();
+		myEdge2Y.clear();
+		myEdge2Z.clear();
+	}
+
+	template <typename T>
+	void TriangleBatch<T>::Reserve(std::size_t aCount)
+	{
+		myVertexX.reserve(aCount);
+		myVertexY.reserve(aCount);
+		myVertexZ.reserve(aCount);
+		myEdge1X.reserve(aCount);
+		myEdge1Y.reserve(aCount);
+		myEdge1Z.reserve(aCount);
+		myEdge2X.reserve(aCount);
+		myEdge2Y.reserve(aCount);
+		myEdge2Z.reserve(aCount);
+	}
+
+	template <typename T>
+	void TriangleBatch<T>::IntersectsRay(const Ray<T>& aRay, T aMaxDistance, std::span<std::uint64_t> someResultMasks, std::span<T> someDistances) const
+	{
+		Simd::ClearMask(someResultMasks, Size());
+
+		Simd::ForEachPack<T>(Size(), [&]<typename Pack>(std::size_t anIndex)
+		{
+			Pack distance = Pack::Broadcast(0);
+			const auto result = _impl::IntersectTriangle<Pack>(
+				_impl::BroadcastVector3<Pack>(aRay.GetOrigin()),
+				_impl::BroadcastVector3<Pack>(aRay.GetDirection()),
+				_impl::LoadVector3<Pack>(&myVertexX[anIndex], &myVertexY[anIndex], &myVertexZ[anIndex]),
+				_impl::LoadVector3<Pack>(&myEdge1X[anIndex], &myEdge1Y[anIndex], &myEdge1Z[anIndex]),
+				_impl::LoadVector3<Pack>(&myEdge2X[anIndex], &myEdge2Y[anIndex], &myEdge2Z[anIndex]),
+				Pack::Broadcast(aMaxDistance),
+				distance
+			);
+
+			if (!someDistances.empty())
+				Pack::Select(result, distance, Pack::Load(&someDistances[anIndex])).Store(&someDistances[anIndex]);
+
+			Simd::WriteMaskBits(someResultMasks, anIndex, result.MoveMask());
+		});
+	}
+
+	#pragma endregion
+
+	#pragma region RayPacket implementation
+
+	template <typename T, std::size_t Width>
+	RayPacket<T, Width>::RayPacket()
+	{
+		const Ray<T> ray(Vector3<T>(0, 0, 0), Vector3<T>(0, 0, 1));
+		for (std::size_t i = 0; i < Width; ++i)
+			Set(i, ray);
+	}
+
+	template <typename T, std::size_t Width>
+	RayPacket<T, Width>::RayPacket(std::span<const Ray<T>, Width> someRays)
+	{
+		for (std::size_t i = 0; i < Width; ++i)
+			Set(i, someRays[i]);
+	}
+
+	template <typename T, std::size_t Width>
+	Ray<T> RayPacket<T, Width>::Get(std::size_t anIndex) const
+	{
+		return Ray<T>(
+			Vector3<T>(myOriginX[anIndex], myOriginY[anIndex], myOriginZ[anIndex]),
+			Vector3<T>(myDirectionX[anIndex], myDirectionY[anIndex], myDirectionZ[anIndex])
+		);
+	}
+
+	template <typename T, std::size_t Width>
+	void RayPacket<T, Width>::Set(std::size_t anIndex, const Ray<T>& aRay)
+	{
+		myOriginX[anIndex] = aRay.GetOrigin().X;
+		myOriginY[anIndex] = aRay.GetOrigin().Y;
+		myOriginZ[anIndex] = aRay.GetOrigin().Z;
+		myDirectionX[anIndex] = aRay.GetDirection().X;
+		myDirectionY[anIndex] = aRay.GetDirection().Y;
+		myDirectionZ[anIndex] = aRay.GetDirection().Z;
+		myInverseX[anIndex] = aRay.GetInverseDirection().X;
+		myInverseY[anIndex] = aRay.GetInverseDirection().Y;
+		myInverseZ[anIndex] = aRay.GetInverseDirection().Z;
+	}
+
+	template <typename T, std::size_t Width>
+	std::uint64_t RayPacket<T, Width>::Intersects(const AxisAlignedBox<T>& aBox, std::span<const T, Width> someMaxDistances) const
+	{
+		std::uint64_t resultMask = 0;
+
+		Simd::ForEachPack<T>(Width, [&]<typename Pack>(std::size_t anIndex)
+		{
+			const auto result = _impl::IntersectBox<Pack>(
+				_impl::LoadVector3<Pack>(&myOriginX[anIndex], &myOriginY[anIndex], &myOriginZ[anIndex]),
+				_impl::LoadVector3<Pack>(&myInverseX[anIndex], &myInverseY[anIndex], &myInverseZ[anIndex]),
+				_impl::BroadcastVector3<Pack>(aBox.Min),
+				_impl::BroadcastVector3<Pack>(aBox.Max),
+				Pack::Load(&someMaxDistances[anIndex])
+			);
+
+			Simd::WriteMaskBits(std::span(&resultMask, 1), anIndex, result.MoveMask());
+		});
+
+		return resultMask;
+	}
+
+	template <typename T, std::size_t Width>
+	std::uint64_t RayPacket<T, Width>::IntersectsTriangle(const Vector3<T>& aVertex0, const Vector3<T>& aVertex1, const Vector3<T>& aVertex2, std::span<T, Width> someDistances) const
+	{
+		const Vector3<T> edge1 = aVertex1 - aVertex0;
+		const Vector3<T> edge2 = aVertex2 - aVertex0;
+
+		std::uint64_t resultMask = 0;
+
+		Simd::ForEachPack<T>(Width, [&]<typename Pack>(std::size_t anIndex)
+		{
+			const Pack maxDistance = Pack::Load(&someDistances[anIndex]);
+
+			Pack distance = maxDistance;
+			const auto result = _impl::IntersectTriangle<Pack>(
+				_impl::LoadVector3<Pack>(&myOriginX[anIndex], &myOriginY[anIndex], &myOriginZ[anIndex]),
+				_impl::LoadVector3<Pack>(&myDirectionX[anIndex], &myDirectionY[anIndex], &myDirectionZ[anIndex]),
+				_impl::BroadcastVector3<Pack>(aVertex0),
+				_impl::BroadcastVector3<Pack>(edge1),
+				_impl::BroadcastVector3<Pack>(edge2),
+				maxDistance,
+				distance
+			);
+
+			Pack::Select(result, distance, maxDistance).Store(&someDistances[anIndex]);
+			Simd::WriteMaskBits(std::span(&resultMask, 1), anIndex, result.MoveMask());
+		});
+
+		return resultMask;
+	}
+
+	#pragma endregion
+}
@@ -0,0 +1,237 @@
+#pragma once
+
+#include "Geometry.hpp"
+
+#include <algorithm>
+#include <numeric>
+#include <optional>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+namespace RoseCommon::Math
+{
+	/**
+	 * @brief Places rectangles into a fixed-size area without overlap, such as images into a texture atlas.
+	 *        Uses a skyline of the highest used position along the width. Each rectangle is placed where its bottom ends up the lowest.
+	 *        This makes an insertion linear in the skyline length, which stays short compared to the number of rectangles.
+	 *        Rectangles can be inserted one at a time as they arrive, or many at once, which sorts them first for a tighter packing.
+	 * @tparam T A type for each component.
+	 */
+	template <typename T>
+	class RectanglePacker
+	{
+	public:
+
+		//--------------------------------------------------
+		// * Construction
+		//--------------------------------------------------
+		#pragma region Construction
+
+		/**
+		 * @brief Initialize an empty packer.
+		 * @param aSize The size of the area to place rectangles in.
+		 */
+		explicit RectanglePacker(const Size<T>& aSize);
+
+		#pragma endregion
+
+		//--------------------------------------------------
+		// * Properties
+		//--------------------------------------------------
+		#pragma region Properties
+
+		/**
+		 * @brief Get the size of the area rectangles are placed in.
+		 */
+		const Size<T>& GetSize() const { return mySize; }
+
+		/**
+		 * @brief Get the total area of all placed rectangles.
+		 */
+		T GetUsedArea() const { return myUsedArea; }
+
+		#pragma endregion
+
+		//--------------------------------------------------
+		// * Methods
+		//--------------------------------------------------
+		#pragma region Methods
+
+		/**
+		 * @brief Remove all placed rectangles, keeping the size.
+		 */
+		void Clear();
+
+		/**
+		 * @brief Place a rectangle.
+		 * @param aSize The size of the rectangle.
+		 * @return Where the rectangle was placed, if there was room for it.
+		 */
+		std::optional<Rectangle<T>> Insert(const Size<T>& aSize);
+
+		/**
+		 * @brief Place many rectangles, tallest first, which packs tighter than placing them in any order.
+		 * @param someSizes The size of each rectangle.
+		 * @param outPlacements A buffer with one element per rectangle, receiving where it was placed if there was room for it.
+		 * @return The number of rectangles that were placed.
+		 */
+		std::size_t Insert(std::span<const Size<T>> someSizes, std::span<std::optional<Rectangle<T>>> outPlacements);
+
+		#pragma endregion
+
+	private:
+		// A horizontal segment of the skyline, with everything below it considered used.
+		struct Segment
+		{
+			T X;
+			T Y;
+			T Width;
+		};
+
+		// Find the lowest height a rectangle would rest at if its left side were at a segment, or nothing if it doesn't fit there.
+		std::optional<T> FindRestingHeight(std::size_t aSegmentIndex, const Size<T>& aSize) const;
+
+		void AddSegment(std::size_t aSegmentIndex, const Rectangle<T>& aRectangle);
+
+		Size<T> mySize;
+		T myUsedArea;
+		std::vector<Segment> mySkyline;
+	};
+}
+
+namespace RoseCommon::Math
+{
+	template <typename T>
+	RectanglePacker<T>::RectanglePacker(const Size<T>& aSize)
+		: mySize(aSize)
+		, myUsedArea(0)
+	{
+		if (aSize.Width <= T(0) || aSize.Height <= T(0))
+			throw std::invalid_argument("The packing area needs a positive size.");
+
+		Clear();
+	}
+
+	template <typename T>
+	void RectanglePacker<T>::Clear()
+	{
+		myUsedArea = T(0);
+		mySkyline.clear();
+		mySkyline.push_back(Segment{ T(0), T(0), mySize.Width });
+	}
+
+	template <typename T>
+	std::optional<Rectangle<T>> RectanglePacker<T>::Insert(const Size<T>& aSize)
+	{
+		if (aSize.Width <= T(0) || aSize.Height <= T(0))
+			return { };
+
+		std::size_t bestIndex = mySkyline.size();
+		T bestBottom = T(0);
+		T bestWidth = T(0);
+		T bestY = T(0);
+
+		for (std::size_t i = 0; i < mySkyline.size(); ++i)
+		{
+			const std::optional<T> y = FindRestingHeight(i, aSize);
+			if (!y.has_value())
+				continue;
+
+			// Prefer the lowest bottom edge, then the narrowest segment to leave wide segments for wide rectangles.
+			const T bottom = y.value() + aSize.Height;
+			if (bestIndex == mySkyline.size() || bottom < bestBottom || (bottom == bestBottom && mySkyline[i].Width < bestWidth))
+			{
+				bestIndex = i;
+				bestBottom = bottom;
+				bestWidth = mySkyline[i].Width;
+				bestY = y.value();
+			}
+		}
+
+		if (bestIndex == mySkyline.size())
+			return { };
+
+		const Rectangle<T> placement(Point<T>(mySkyline[bestIndex].X, bestY), aSize);
+		AddSegment(bestIndex, placement);
+		myUsedArea += placement.Area();
+		return placement;
+	}
+
+	template <typename T>
+	std::size_t RectanglePacker<T>::Insert(std::span<const Size<T>> someSizes, std::span<std::optional<Rectangle<T>>> outPlacements)
+	{
+		if (outPlacements.size() < someSizes.size())
+			throw std::invalid_argument("The placement buffer needs to be at least as large as the number of sizes.");
+
+		std::vector<std::size_t> order(someSizes.size());
+		std::iota(order.begin(), order.end(), std::size_t(0));
+		std::stable_sort(order.begin(), order.end(), [&someSizes](std::size_t anIndex, std::size_t anOtherIndex)
+		{
+			const Size<T>& size = someSizes[anIndex];
+			const Size<T>& otherSize = someSizes[anOtherIndex];
+			return size.Height != otherSize.Height ? size.Height > otherSize.Height : size.Width > otherSize.Width;
+		});
+
+		std::size_t placedCount = 0;
+		for (const std::size_t index : order)
+		{
+			outPlacements[index] = Insert(someSizes[index]);
+			if (outPlacements[index].has_value())
+				++placedCount;
+		}
+
+		return placedCount;
+	}
+
+	template <typename T>
+	std::optional<T> RectanglePacker<T>::FindRestingHeight(std::size_t aSegmentIndex, const Size<T>& aSize) const
+	{
+		const T left = mySkyline[aSegmentIndex].X;
+		if (left + aSize.Width > mySize.Width)
+			return { };
+
+		T y = T(0);
+		for (std::size_t i = aSegmentIndex; i < mySkyline.size() && mySkyline[i].X < left + aSize.Width; ++i)
+		{
+			y = Math::Max<T>(y, mySkyline[i].Y);
+			if (y + aSize.Height > mySize.Height)
+				return { };
+		}
+
+		return y;
+	}
+
+	template <typename T>
+	void RectanglePacker<T>::AddSegment(std::size_t aSegmentIndex, const Rectangle<T>& aRectangle)
+	{
+		mySkyline.insert(mySkyline.begin() + aSegmentIndex, Segment{ aRectangle.Left(), aRectangle.Bottom(), aRectangle.Width });
+
+		// Cut the segments the new one now covers.
+		const T right = aRectangle.Right();
+		std::size_t coveredEnd = aSegmentIndex + 1;
+		while (coveredEnd < mySkyline.size() && mySkyline[coveredEnd].X + mySkyline[coveredEnd].Width <= right)
+			++coveredEnd;
+
+		if (coveredEnd < mySkyline.size() && mySkyline[coveredEnd].X < right)
+		{
+			mySkyline[coveredEnd].Width -= right - mySkyline[coveredEnd].X;
+			mySkyline[coveredEnd].X = right;
+		}
+
+		mySkyline.erase(mySkyline.begin() + aSegmentIndex + 1, mySkyline.begin() + coveredEnd);
+
+		// Merge with neighbours at the same height, to keep the skyline short.
+		if (aSegmentIndex + 1 < mySkyline.size() && mySkyline[aSegmentIndex + 1].Y == mySkyline[aSegmentIndex].Y)
+		{
+			mySkyline[aSegmentIndex].Width += mySkyline[aSegmentIndex + 1].Width;
+			mySkyline.erase(mySkyline.begin() + aSegmentIndex + 1);
+		}
+
+		if (aSegmentIndex > 0 && mySkyline[aSegmentIndex - 1].Y == mySkyline[aSegmentIndex].Y)
+		{
+			mySkyline[aSegmentIndex - 1].Width += mySkyline[aSegmentIndex].Width;
+			mySkyline.erase(mySkyline.begin() + aSegmentIndex);
+		}
+	}
+}
@@ -0,0 +1,433 @@
+#pragma once
+
+#include "Common.hpp"
+#include "Geometry.hpp"
+
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <unordered_map>
+#include <vector>
+
+namespace RoseCommon::Math
+{
+	/**
+	 * @brief A two-dimensional spatial index which sorts rectangles into a uniform grid of hashed cells.
+	 *        Best suited for objects of similar size, with a cell size a few times larger than a typical object.
+	 *        Rectangles spanning several cells are stored in each of them, but reported only once per query.
+	 * @tparam T A type for each component.
+	 */
+	template <typename T>
+	class SpatialHashGrid
+	{
+	public:
+
+		//--------------------------------------------------
+		// * Types
+		//--------------------------------------------------
+		#pragma region Types
+
+		/**
+		 * @brief An entry found by a nearest-neighbor query.
+		 */
+		struct Neighbor
+		{
+			std::uint32_t Id = 0;
+			T DistanceSquared = 0;
+		};
+
+		#pragma endregion
+
+		//--------------------------------------------------
+		// * Construction
+		//--------------------------------------------------
+		#pragma region Construction
+
+		/**
+		 * @brief Initialize an empty grid.
+		 * @param aCellSize The width and height of each grid cell.
+		 */
+		explicit SpatialHashGrid(T aCellSize);
+
+		#pragma endregion
+
+		//--------------------------------------------------
+		// * Properties
+		//--------------------------------------------------
+		#pragma region Properties
+
+		/**
+		 * @brief Get the bounds an entry was last inserted or moved with.
+		 * @param anId The id of the entry.
+		 */
+		const Rectangle<T>& GetBounds(std::uint32_t anId) const { return myEntries[anId].Bounds; }
+
+		/**
+		 * @brief Get the width and height of each grid cell.
+		 */
+		T GetCellSize() const { return myCellSize; }
+
+		/**
+		 * @brief Get the number of entries in the grid.
+		 */
+		std::size_t Size() const { return myEntries.size() - myFreeIds.size(); }
+
+		#pragma endregion
+
+		//--------------------------------------------------
+		// * Methods
+		//--------------------------------------------------
+		#pragma region Methods
+
+		/**
+		 * @brief Replace the grid contents with the specified rectangles. Entry ids will match the rectangle indices.
+		 * @param someBounds The rectangles to insert.
+		 */
+		void Build(std::span<const Rectangle<T>> someBounds);
+
+		/**
+		 * @brief Remove all entries from the grid.
+		 */
+		void Clear();
+
+		/**
+		 * @brief Insert a rectangle into the grid.
+		 * @param aBounds The rectangle to insert.
+		 * @return An id for the new entry. Ids of removed entries are reused.
+		 */
+		std::uint32_t Insert(const Rectangle<T>& aBounds);
+
+		/**
+		 * @brief Move an entry to new bounds. Only touches the cell lists if the entry moved into different cells.
+		 * @param anId The id of the entry.
+		 * @param aBounds The new bounds of the entry.
+		 */
+		void Move(std::uint32_t anId, const Rectangle<T>& aBounds);
+
+		/**
+		 * @brief Find the entries closest to a point, measured to the closest point of their bounds.
+		 * @param aPoint The point to search from.
+		 * @param someResults A buffer to write the results into, ordered by increasing distance. Its size is the number of neighbors searched for.
+		 * @return The number of neighbors written, which is less than requested if the grid holds fewer entries.
+		 */
+		std::size_t Nearest(const Point<T>& aPoint, std::span<Neighbor> someResults) const;
+
+		/**
+		 * @brief Find all entries whose bounds contain a point.
+		 * @param aPoint The point to test.
+		 * @param aCallback Called as aCallback(id) for each entry containing the point.
+		 */
+		template <typename Callback>
+		void QueryPoint(const Point<T>& aPoint, Callback&& aCallback) const;
+
+		/**
+		 * @brief Find all entries whose bounds intersect a rectangle.
+		 * @param aRectangle The rectangle to test.
+		 * @param aCallback Called as aCallback(id) for each entry intersecting the rectangle.
+		 */
+		template <typename Callback>
+		void QueryRange(const Rectangle<T>& aRectangle, Callback&& aCallback) const;
+
+		/**
+		 * @brief Remove an entry from the grid.
+		 * @param anId The id of the entry.
+		 */
+		void Remove(std::uint32_t anId);
+
+		#pragma endregion
+
+	private:
+		struct CellRange
+		{
+			std::int32_t MinX = 0, MinY = 0, MaxX = -1, MaxY = -1;
+
+			constexpr bool operator==(const CellRange& aRange) const = default;
+		};
+
+		struct Entry
+		{
+			Rectangle<T> Bounds;
+			CellRange Cells;
+		};
+
+		static constexpr std::uint64_t GetCellKey(std::int32_t anX, std::int32_t aY) { return (static_cast<std::uint64_t>(static_cast<std::uint32_t>(anX)) << 32) | static_cast<std::uint32_t>(aY); }
+
+		std::int32_t GetCellCoordinate(T aValue) const { return Math::FloorTo<std::int32_t, double>(static_cast<double>(aValue) * myInverseCellSize); }
+		CellRange GetCellRange(const Rectangle<T>& aBounds) const;
+
+		void AddToCells(std::uint32_t anId, const CellRange& aRange);
+		void RemoveFromCells(std::uint32_t anId, const CellRange& aRange);
+
+	private:
+		T myCellSize;
+		double myInverseCellSize;
+
+		std::vector<Entry> myEntries;
+		std::vector<std::uint32_t> myFreeIds;
+		std::unordered_map<std::uint64_t, std::vector<std::uint32_t>> myCells;
+		CellRange myOccupiedCells;
+	};
+}
+
+namespace RoseCommon::Math
+{
+	template <typename T>
+	SpatialHashGrid<T>::SpatialHashGrid(T aCellSize)
+		: myCellSize(aCellSize)
+		, myInverseCellSize(1.0 / static_cast<double>(aCellSize))
+	{
+
+	}
+
+	template <typename T>
+	void SpatialHashGrid<T>::Build(std::span<const Rectangle<T>> someBounds)
+	{
+		Clear();
+
+		myEntries.reserve(someBounds.size());
+		for (const Rectangle<T>& bounds : someBounds)
+			Insert(bounds);
+	}
+
+	template <typename T>
+	void SpatialHashGrid<T>::Clear()
+	{
+		myEntries.clear();
+		myFreeIds.clear();
+		myCells.clear();
+		myOccupiedCells = CellRange();
+	}
+
+	template <typename T>
+	std::uint32_t SpatialHashGrid<T>::Insert(const Rectangle<T>& aBounds)
+	{
+		const CellRange cells = GetCellRange(aBounds);
+
+		std::uint32_t id;
+		if (myFreeIds.empty())
+		{
+			id = static_cast<std::uint32_t>(myEntries.size());
+			myEntries.push_back(Entry{ aBounds, cells });
+		}
+		else
+		{
+			id = myFreeIds.back();
+			myFreeIds.pop_back();
+			myEntries[id] = Entry{ aBounds, cells };
+		}
+
+		AddToCells(id, cells);
+		return id;
+	}
+
+	template <typename T>
+	void SpatialHashGrid<T>::Move(std::uint32_t anId, const Rectangle<T>& aBounds)
+	{
+		Entry& entry = myEntries[anId];
+		const CellRange cells = GetCellRange(aBounds);
+
+		if (cells != entry.Cells)
+		{
+			RemoveFromCells(anId, entry.Cells);
+			AddToCells(anId, cells);
+			entry.Cells = cells;
+		}
+
+		entry.Bounds = aBounds;
+	}
+
+	template <typename T>
+	std::size_t SpatialHashGrid<T>::Nearest(const Point<T>& aPoint, std::span<Neighbor> someResults) const
+	{
+		if (someResults.empty() || Size() == 0)
+			return 0;
+
+		const std::int32_t centerX = GetCellCoordinate(aPoint.X);
+		const std::int32_t centerY = GetCellCoordinate(aPoint.Y);
+
+		// Rings before the first one reaching the occupied cells are empty, and after the one covering all of them nothing more can be found.
+		const std::int32_t firstRing = Math::Max<std::int32_t>(
+			Math::Max<std::int32_t>(myOccupiedCells.MinX - centerX, centerX - myOccupiedCells.MaxX),
+			Math::Max<std::int32_t>(Math::Max<std::int32_t>(myOccupiedCells.MinY - centerY, centerY - myOccupiedCells.MaxY), 0)
+		);
+		const std::int32_t maxRing = Math::Max<std::int32_t>(
+			Math::Max<std::int32_t>(centerX - myOccupiedCells.MinX, myOccupiedCells.MaxX - centerX),
+			Math::Max<std::int32_t>(centerY - myOccupiedCells.MinY, myOccupiedCells.MaxY - centerY)
+		);
+
+		std::size_t count = 0;
+
+		auto visitCell = [&](std::int32_t anX, std::int32_t aY)
+		{
+			const auto cell = myCells.find(GetCellKey(anX, aY));
+			if (cell == myCells.end())
+				return;
+
+			for (const std::uint32_t id : cell->second)
+			{
+				// Only consider the entry from its cell closest to the center, so it is visited once.
+				const CellRange& cells = myEntries[id].Cells;
+				if (Math::Clamp<std::int32_t>(centerX, cells.MinX, cells.MaxX) != anX || Math::Clamp<std::int32_t>(centerY, cells.MinY, cells.MaxY) != aY)
+					continue;
+
+				const T distance = myEntries[id].Bounds.DistanceSquared(aPoint);
+				if (count == someResults.size() && distance >= someResults[count - 1].DistanceSquared)
+					continue;
+
+				// Insertion sort into the result buffer, dropping the furthest entry when full.
+				std::size_t position = count < someResults.size() ? count++ : count - 1;
+				for (; position > 0 && someResults[position - 1].DistanceSquared > distance; --position)
+					someResults[position] = someResults[position - 1];
+				someResults[position] = Neighbor{ id, distance };
+			}
+		};
+
+		// Visit the cells of a row or column of a ring which lie within the occupied cells, as the others are all empty.
+		auto visitRow = [&](std::int32_t aY, std::int32_t aMinX, std::int32_t aMaxX)
+		{
+			if (aY < myOccupiedCells.MinY || aY > myOccupiedCells.MaxY)
+				return;
+
+			for (std::int32_t x = Math::Max<std::int32_t>(aMinX, myOccupiedCells.MinX); x <= Math::Min<std::int32_t>(aMaxX, myOccupiedCells.MaxX); ++x)
+				visitCell(x, aY);
+		};
+		auto visitColumn = [&](std::int32_t anX, std::int32_t aMinY, std::int32_t aMaxY)
+		{
+			if (anX < myOccupiedCells.MinX || anX > myOccupiedCells.MaxX)
+				return;
+
+			for (std::int32_t y = Math::Max<std::int32_t>(aMinY, myOccupiedCells.MinY); y <= Math::Min<std::int32_t>(aMaxY, myOccupiedCells.MaxY); ++y)
+				visitCell(anX, y);
+		};
+
+		for (std::int32_t ring = firstRing; ring <= maxRing; ++ring)
+		{
+			if (ring == 0)
+			{
+				visitCell(centerX, centerY);
+			}
+			else
+			{
+				visitRow(centerY - ring, centerX - ring, centerX + ring);
+				visitRow(centerY + ring, centerX - ring, centerX + ring);
+				visitColumn(centerX - ring, centerY - ring + 1, centerY + ring - 1);
+				visitColumn(centerX + ring, centerY - ring + 1, centerY + ring - 1);
+			}
+
+			// Anything not yet visited is at least this far from the point.
+			const T unvisitedDistance = static_cast<T>(ring) * myCellSize;
+			if (count == someResults.size() && someResults[count - 1].DistanceSquared <= unvisitedDistance * unvisitedDistance)
+				break;
+		}
+
+		return count;
+	}
+
+	template <typename T>
+	template <typename Callback>
+	void SpatialHashGrid<T>::QueryPoint(const Point<T>& aPoint, Callback&& aCallback) const
+	{
+		const auto cell = myCells.find(GetCellKey(GetCellCoordinate(aPoint.X), GetCellCoordinate(aPoint.Y)));
+		if (cell == myCells.end())
+			return;
+
+		for (const std::uint32_t id : cell->second)
+		{
+			if (myEntries[id].Bounds.Contains(aPoint))
+				aCallback(id);
+		}
+	}
+
+	template <typename T>
+	template <typename Callback>
+	void SpatialHashGrid<T>::QueryRange(const Rectangle<T>& aRectangle, Callback&& aCallback) const
+	{
+		const CellRange range = GetCellRange(aRectangle);
+
+		for (std::int32_t y = range.MinY; y <= range.MaxY; ++y)
+		{
+			for (std::int32_t x = range.MinX; x <= range.MaxX; ++x)
+			{
+				const auto cell = myCells.find(GetCellKey(x, y));
+				if (cell == myCells.end())
+					continue;
+
+				for (const std::uint32_t id : cell->second)
+				{
+					// Entries spanning several cells are only reported from the first cell shared with the query.
+					const Entry& entry = myEntries[id];
+					if (Math::Max<std::int32_t>(entry.Cells.MinX, range.MinX) != x || Math::Max<std::int32_t>(entry.Cells.MinY, range.MinY) != y)
+						continue;
+
+					if (entry.Bounds.IntersectsWith(aRectangle))
+						aCallback(id);
+				}
+			}
+		}
+	}
+
+	template <typename T>
+	void SpatialHashGrid<T>::Remove(std::uint32_t anId)
+	{
+		RemoveFromCells(anId, myEntries[anId].Cells);
+		myFreeIds.push_back(anId);
+	}
+
+	template <typename T>
+	typename SpatialHashGrid<T>::CellRange SpatialHashGrid<T>::GetCellRange(const Rectangle<T>& aBounds) const
+	{
+		CellRange range;
+		range.MinX = GetCellCoordinate(aBounds.Left());
+		range.MinY = GetCellCoordinate(aBounds.Top());
+		range.MaxX = GetCellCoordinate(aBounds.Right());
+		range.MaxY = GetCellCoordinate(aBounds.Bottom());
+		return range;
+	}
+
+	template <typename T>
+	void SpatialHashGrid<T>::AddToCells(std::uint32_t anId, const CellRange& aRange)
+	{
+		for (std::int32_t y = aRange.MinY; y <= aRange.MaxY; ++y)
+		{
+			for (std::int32_t x = aRange.MinX; x <= aRange.MaxX; ++x)
+				myCells[GetCellKey(x, y)].push_back(anId);
+		}
+
+		if (myOccupiedCells.MaxX < myOccupiedCells.MinX)
+		{
+			myOccupiedCells = aRange;
+		}
+		else
+		{
+			myOccupiedCells.MinX = Math::Min<std::int32_t>(myOccupiedCells.MinX, aRange.MinX);
+			myOccupiedCells.MinY = Math::Min<std::int32_t>(myOccupiedCells.MinY, aRange.MinY);
+			myOccupiedCells.MaxX = Math::Max<std::int32_t>(myOccupiedCells.MaxX, aRange.MaxX);
+			myOccupiedCells.MaxY = Math::Max<std::int32_t>(myOccupiedCells.MaxY, aRange.MaxY);
+		}
+	}
+
+	template <typename T>
+	void SpatialHashGrid<T>::RemoveFromCells(std::uint32_t anId, const CellRange& aRange)
+	{
+		for (std::int32_t y = aRange.MinY; y <= aRange.MaxY; ++y)
+		{
+			for (std::int32_t x = aRange.MinX; x <= aRange.MaxX; ++x)
+			{
+				const auto cell = myCells.find(GetCellKey(x, y));
+				if (cell == myCells.end())
+					continue;
+
+				std::vector<std::uint32_t>& ids = cell->second;
+				for (std::size_t i = 0; i < ids.size(); ++i)
+				{
+					if (ids[i] != anId)
+						continue;
+
+					ids[i] = ids.back();
+					ids.pop_back();
+					break;
+				}
+			}
+		}
+	}
+}
@@ -0,0 +1,486 @@
+#pragma once
+
+#include "../Simd.hpp"
+#include "Common.hpp"
+#include "Vector.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+namespace RoseCommon::Math
+{
+	/**
+	 * @brief A piecewise cubic curve with its polynomial coefficients precomputed per segment.
+	 *        Catmull-Rom, Hermite, Bézier and monotone cubic curves are all converted to the same form on creation,
+	 *        so evaluating any of them is a segment lookup followed by a single Horner evaluation.
+	 * @tparam Value The type of value being interpolated, either a scalar or one of Vector2, Vector3 or Vector4.
+	 * @tparam T The type of the time parameter, matching the value components.
+	 */
+	template <typename Value, typename T = typename _impl::VectorTraits<Value>::Component>
+	class CubicSpline
+	{
+		using Traits = _impl::VectorTraits<Value>;
+
+	public:
+
+		//--------------------------------------------------
+		// * Types
+		//--------------------------------------------------
+		#pragma region Types
+
+		/**
+		 * @brief The coefficients of one segment, evaluated as ((A * u + B) * u + C) * u + D for u between 0 and 1.
+		 */
+		struct Segment
+		{
+			Value A;
+			Value B;
+			Value C;
+			Value D;
+		};
+
+		#pragma endregion
+
+		//--------------------------------------------------
+		// * Construction
+		//--------------------------------------------------
+		#pragma region Construction
+
+		/**
+		 * @brief Initialize an empty spline.
+		 */
+		CubicSpline() = default;
+
+		/**
+		 * @brief Create a spline from a chain of cubic Bézier segments which share their end points.
+		 * @param someControlPoints The control points, being 3 * N + 1 for N segments.
+		 * @param someKnots The start time of each segment followed by the end time of the last, or empty for one segment per time unit starting at 0.
+		 */
+		static CubicSpline CreateBezier(std::span<const Value> someControlPoints, std::span<const T> someKnots = { });
+
+		/**
+		 * @brief Create a spline passing through each point, with tangents given by the neighboring points.
+		 *        For uniform knots, interior segments match Math::CatmullRom. The end tangents use one-sided differences.
+		 * @param somePoints The points to pass through, at least two.
+		 * @param someKnots The time of each point, or empty for one point per time unit starting at 0.
+		 */
+		static CubicSpline CreateCatmullRom(std::span<const Value> somePoints, std::span<const T> someKnots = { });
+
+		/**
+		 * @brief Create a spline passing through each point with the specified tangents.
+		 *        For uniform knots, segments match Math::Hermite.
+		 * @param somePoints The points to pass through, at least two.
+		 * @param someTangents The rate of change per time unit at each point.
+		 * @param someKnots The time of each point, or empty for one point per time unit starting at 0.
+		 */
+		static CubicSpline CreateHermite(std::span<const Value> somePoints, std::span<const Value> someTangents, std::span<const T> someKnots = { });
+
+		/**
+		 * @brief Create a spline passing through each point which never overshoots them,
+		 *        so each component is monotonic wherever the points are. Tangents are picked per component with the Fritsch-Butland method.
+		 * @param somePoints The points to pass through, at least two.
+		 * @param someKnots The time of each point, or empty for one point per time unit starting at 0.
+		 */
+		static CubicSpline CreateMonotone(std::span<const Value> somePoints, std::span<const T> someKnots = { });
+
+		#pragma endregion
+
+		//--------------------------------------------------
+		// * Properties
+		//--------------------------------------------------
+		#pragma region Properties
+
+		/**
+		 * @brief Get the time at the end of the last segment.
+		 */
+		T EndTime() const { return myKnots.empty() ? T(0) : myKnots.back(); }
+
+		/**
+		 * @brief Get the segment boundaries, being one more than the segment count.
+		 */
+		std::span<const T> GetKnots() const { return myKnots; }
+
+		/**
+		 * @brief Get the precomputed coefficients of each segment.
+		 */
+		std::span<const Segment> GetSegments() const { return mySegments; }
+
+		/**
+		 * @brief Get the number of segments.
+		 */
+		std::size_t SegmentCount() const { return mySegments.size(); }
+
+		/**
+		 * @brief Get the time at the start of the first segment.
+		 */
+		T StartTime() const { return myKnots.empty() ? T(0) : myKnots.front(); }
+
+		#pragma endregion
+
+		//--------------------------------------------------
+		// * Methods
+		//--------------------------------------------------
+		#pragma region Methods
+
+		/**
+		 * @brief Calculate the rate of change of the spline at a time.
+		 * @param aTime The time to evaluate at. Times outside the spline use the closest end.
+		 */
+		Value Derivative(T aTime) const;
+
+		/**
+		 * @brief Evaluate the spline at a time.
+		 * @param aTime The time to evaluate at. Times outside the spline are clamped to the closest end.
+		 */
+		Value Evaluate(T aTime) const;
+
+		/**
+		 * @brief Evaluate the spline at many times. Consecutive times in the same segment are evaluated together with SIMD,
+		 *        and sorted times only need a short linear step to find the next segment.
+		 * @param someTimes The times to evaluate at. Need not be sorted, but sorted times are the fastest.
+		 * @param someResults A buffer to write the value at each time into, at least as large as the time count.
+		 */
+		void Evaluate(std::span<const T> someTimes, std::span<Value> someResults) const;
+
+		/**
+		 * @brief Evaluate a single segment.
+		 * @param aSegment The index of the segment.
+		 * @param anAmount The position within the segment, between 0 and 1.
+		 */
+		Value EvaluateSegment(std::size_t aSegment, T anAmount) const;
+
+		/**
+		 * @brief Calculate the rate of change per time unit within a single segment.
+		 * @param aSegment The index of the segment.
+		 * @param anAmount The position within the segment, between 0 and 1.
+		 */
+		Value EvaluateSegmentDerivative(std::size_t aSegment, T anAmount) const;
+
+		/**
+		 * @brief Find the segment containing a time with a binary search.
+		 * @param aTime The time to look for. Times outside the spline give the closest end segment.
+		 */
+		std::size_t FindSegment(T aTime) const;
+
+		/**
+		 * @brief Find the segment containing a time, starting from a guess such as the segment of a previous query.
+		 *        Checks the guess and the segment after it before falling back to a binary search.
+		 * @param aTime The time to look for. Times outside the spline give the closest end segment.
+		 * @param aHint The segment to check first.
+		 */
+		std::size_t FindSegment(T aTime, std::size_t aHint) const;
+
+		/**
+		 * @brief Get the position of a time within a segment.
+		 * @param aSegment The index of the segment.
+		 * @param aTime The time to convert.
+		 * @return An amount between 0 and 1.
+		 */
+		T GetSegmentAmount(std::size_t aSegment, T aTime) const { return Math::Clamp<T>((aTime - myKnots[aSegment]) * myInverseDurations[aSegment], T(0), T(1)); }
+
+		#pragma endregion
+
+	private:
+		static std::vector<T> CreateKnots(std::span<const T> someKnots, std::size_t aPointCount);
+		static Segment CreateHermiteSegment(const Value& aPoint1, const Value& aTangent1, const Value& aPoint2, const Value& aTangent2);
+
+		void SetKnots(std::vector<T>&& someKnots);
+
+		bool IsInSegment(std::size_t aSegment, T aTime) const;
+
+		template <typename Pack>
+		static Pack EvaluatePack(const Segment& aSegment, std::size_t aComponent, const Pack& anAmount);
+
+	private:
+		std::vector<T> myKnots;
+		std::vector<T> myInverseDurations;
+		std::vector<Segment> mySegments;
+	};
+}
+
+namespace RoseCommon::Math
+{
+	template <typename Value, typename T>
+	CubicSpline<Value, T> CubicSpline<Value, T>::CreateBezier(std::span<const Value> someControlPoints, std::span<const T> someKnots)
+	{
+		if (someControlPoints.size() < 4 || (someControlPoints.size() - 1) % 3 != 0)
+			throw std::invalid_argument("A Bézier spline needs 3 * N + 1 control points.");
+
+		const std::size_t segmentCount = (someControlPoints.size() - 1) / 3;
+
+		CubicSpline spline;
+		spline.SetKnots(CreateKnots(someKnots, segmentCount + 1));
+		spline.mySegments.reserve(segmentCount);
+
+		for (std::size_t i = 0; i < segmentCount; ++i)
+		{
+			const Value& p0 = someControlPoints[i * 3 + 0];
+			const Value& p1 = someControlPoints[i * 3 + 1];
+			const Value& p2 = someControlPoints[i * 3 + 2];
+			const Value& p3 = someControlPoints[i * 3 + 3];
+
+			spline.mySegments.push_back(Segment{
+				(p1 - p2) * T(3) + p3 - p0,
+				(p0 + p2) * T(3) - p1 * T(6),
+				(p1 - p0) * T(3),
+				p0
+				});
+		}
+
+		return spline;
+	}
+
+	template <typename Value, typename T>
+	CubicSpline<Value, T> CubicSpline<Value, T>::CreateCatmullRom(std::span<const Value> somePoints, std::span<const T> someKnots)
+	{
+		if (somePoints.size() < 2)
+			throw std::invalid_argument("A Catmull-Rom spline needs at least two points.");
+
+		std::vector<T> knots = CreateKnots(someKnots, somePoints.size());
+
+		std::vector<Value> tangents(somePoints.size());
+		const std::size_t last = somePoints.size() - 1;
+		tangents[0] = (somePoints[1] - somePoints[0]) * (T(1) / (knots[1] - knots[0]));
+		tangents[last] = (somePoints[last] - somePoints[last - 1]) * (T(1) / (knots[last] - knots[last - 1]));
+		for (std::size_t i = 1; i < last; ++i)
+			tangents[i] = (somePoints[i + 1] - somePoints[i - 1]) * (T(1) / (knots[i + 1] - knots[i - 1]));
+
+		return CreateHermite(somePoints, tangents, knots);
+	}
+
+	template <typename Value, typename T>
+	CubicSpline<Value, T> CubicSpline<Value, T>::CreateHermite(std::span<const Value> somePoints, std::span<const Value> someTangents, std::span<const T> someKnots)
+	{
+		if (somePoints.size() < 2)
+			throw std::invalid_argument("A Hermite spline needs at least two points.");
+		if (someTangents.size() != somePoints.size())
+			throw std::invalid_argument("A Hermite spline needs one tangent per point.");
+
+		CubicSpline spline;
+		spline.SetKnots(CreateKnots(someKnots, somePoints.size()));
+		spline.mySegments.reserve(somePoints.size() - 1);
+
+		// Tangents are per time unit, and the segments are evaluated per segment amount.
+		for (std::size_t i = 0; i + 1 < somePoints.size(); ++i)
+		{
+			const T duration = spline.myKnots[i + 1] - spline.myKnots[i];
+			spline.mySegments.push_back(CreateHermiteSegment(somePoints[i], someTangents[i] * duration, somePoints[i + 1], someTangents[i + 1] * duration));
+		}
+
+		return spline;
+	}
+
+	template <typename Value, typename T>
+	CubicSpline<Value, T> CubicSpline<Value, T>::CreateMonotone(std::span<const Value> somePoints, std::span<const T> someKnots)
+	{
+		if (somePoints.size() < 2)
+			throw std::invalid_argument("A monotone spline needs at least two points.");
+
+		const std::vector<T> knots = CreateKnots(someKnots, somePoints.size());
+		const std::size_t last = somePoints.size() - 1;
+
+		std::vector<Value> tangents(somePoints.size());
+		for (std::size_t c = 0; c < Traits::Count; ++c)
+		{
+			auto slope = [&](std::size_t i) { return (Traits::Get(somePoints[i + 1], c) - Traits::Get(somePoints[i], c)) / (knots[i + 1] - knots[i]); };
+
+			Traits::Set(tangents[0], c, slope(0));
+			Traits::Set(tangents[last], c, slope(last - 1));
+
+			for (std::size_t i = 1; i < last; ++i)
+			{
+				const T slopeBefore = slope(i - 1);
+				const T slopeAfter = slope(i);
+
+				// A weighted harmonic mean of the neighboring slopes, flattened at local extremes.
+				T tangent = T(0);
+				if (slopeBefore * slopeAfter > T(0))
+				{
+					const T durationBefore = knots[i] - knots[i - 1];
+					const T durationAfter = knots[i + 1] - knots[i];
+					tangent = T(3) * (durationBefore + durationAfter) /
+						((T(2) * durationAfter + durationBefore) / slopeBefore + (durationAfter + T(2) * durationBefore) / slopeAfter);
+				}
+
+				Traits::Set(tangents[i], c, tangent);
+			}
+		}
+
+		return CreateHermite(somePoints, tangents, knots);
+	}
+
+	template <typename Value, typename T>
+	Value CubicSpline<Value, T>::Derivative(T aTime) const
+	{
+		if (mySegments.empty())
+			return Value();
+
+		const std::size_t segment = FindSegment(aTime);
+		return EvaluateSegmentDerivative(segment, GetSegmentAmount(segment, aTime));
+	}
+
+	template <typename Value, typename T>
+	Value CubicSpline<Value, T>::Evaluate(T aTime) const
+	{
+		if (mySegments.empty())
+			return Value();
+
+		const std::size_t segment = FindSegment(aTime);
+		return EvaluateSegment(segment, GetSegmentAmount(segment, aTime));
+	}
+
+	template <typename Value, typename T>
+	void CubicSpline<Value, T>::Evaluate(std::span<const T> someTimes, std::span<Value> someResults) const
+	{
+		if (mySegments.empty())
+		{
+			std::fill_n(someResults.begin(), someTimes.size(), Value());
+			return;
+		}
+
+		std::size_t segment = 0;
+		for (std::size_t first = 0; first < someTimes.size();)
+		{
+			segment = FindSegment(someTimes[first], segment);
+
+			std::size_t end = first + 1;
+			while (end < someTimes.size() && IsInSegment(segment, someTimes[end]))
+				++end;
+
+			const Segment& coefficients = mySegments[segment];
+			const T start = myKnots[segment];
+			const T inverseDuration = myInverseDurations[segment];
+
+			Simd::ForEachPack<T>(end - first, [&]<typename Pack>(std::size_t anIndex)
+			{
+				const std::size_t index = first + anIndex;
+
+				Pack amount = (Pack::Load(&someTimes[index]) - Pack::Broadcast(start)) * Pack::Broadcast(inverseDuration);
+				amount = Pack::Min(Pack::Max(amount, Pack::Broadcast(T(0))), Pack::Broadcast(T(1)));
+
+				if constexpr (std::is_same_v<Value, T>)
+				{
+					EvaluatePack<Pack>(coefficients, 0, amount).Store(&someResults[index]);
+				}
+				else
+				{
+					T lanes[Pack::Width];
+					for (std::size_t c = 0; c < Traits::Count; ++c)
+					{
+						EvaluatePack<Pack>(coefficients, c, amount).Store(lanes);
+						for (std::size_t lane = 0; lane < Pack::Width; ++lane)
+							Traits::Set(someResults[index + lane], c, lanes[lane]);
+					}
+				}
+			});
+
+			first = end;
+		}
+	}
+
+	template <typename Value, typename T>
+	Value CubicSpline<Value, T>::EvaluateSegment(std::size_t aSegment, T anAmount) const
+	{
+		const Segment& coefficients = mySegments[aSegment];
+		return ((coefficients.A * anAmount + coefficients.B) * anAmount + coefficients.C) * anAmount + coefficients.D;
+	}
+
+	template <typename Value, typename T>
+	Value CubicSpline<Value, T>::EvaluateSegmentDerivative(std::size_t aSegment, T anAmount) const
+	{
+		const Segment& coefficients = mySegments[aSegment];
+		return ((coefficients.A * (T(3) * anAmount) + coefficients.B * T(2)) * anAmount + coefficients.C) * myInverseDurations[aSegment];
+	}
+
+	template <typename Value, typename T>
+	std::size_t CubicSpline<Value, T>::FindSegment(T aTime) const
+	{
+		// The number of interior knots at or before the time is the segment index.
+		const auto interiorBegin = myKnots.begin() + 1;
+		const auto interiorEnd = myKnots.end() - 1;
+		return static_cast<std::size_t>(std::upper_bound(interiorBegin, interiorEnd, aTime) - interiorBegin);
+	}
+
+	template <typename Value, typename T>
+	std::size_t CubicSpline<Value, T>::FindSegment(T aTime, std::size_t aHint) const
+	{
+		if (aHint < mySegments.size())
+		{
+			if (IsInSegment(aHint, aTime))
+				return aHint;
+
+			if (aHint + 1 < mySegments.size() && IsInSegment(aHint + 1, aTime))
+				return aHint + 1;
+		}
+
+		return FindSegment(aTime);
+	}
+
+	template <typename Value, typename T>
+	std::vector<T> CubicSpline<Value, T>::CreateKnots(std::span<const T> someKnots, std::size_t aPointCount)
+	{
+		if (someKnots.empty())
+		{
+			std::vector<T> knots(aPointCount);
+			for (std::size_t i = 0; i < aPointCount; ++i)
+				knots[i] = static_cast<T>(i);
+			return knots;
+		}
+
+		if (someKnots.size() != aPointCount)
+			throw std::invalid_argument("A spline needs one more knot than it has segments.");
+
+		for (std::size_t i = 1; i < someKnots.size(); ++i)
+		{
+			if (!(someKnots[i - 1] < someKnots[i]))
+				throw std::invalid_argument("Spline knots must be strictly increasing.");
+		}
+
+		return std::vector<T>(someKnots.begin(), someKnots.end());
+	}
+
+	template <typename Value, typename T>
+	typename CubicSpline<Value, T>::Segment CubicSpline<Value, T>::CreateHermiteSegment(const Value& aPoint1, const Value& aTangent1, const Value& aPoint2, const Value& aTangent2)
+	{
+		return Segment{
+			(aPoint1 - aPoint2) * T(2) + aTangent1 + aTangent2,
+			(aPoint2 - aPoint1) * T(3) - aTangent1 * T(2) - aTangent2,
+			aTangent1,
+			aPoint1
+		};
+	}
+
+	template <typename Value, typename T>
+	void CubicSpline<Value, T>::SetKnots(std::vector<T>&& someKnots)
+	{
+		myKnots = std::move(someKnots);
+
+		myInverseDurations.resize(myKnots.size() - 1);
+		for (std::size_t i = 0; i + 1 < myKnots.size(); ++i)
+			myInverseDurations[i] = T(1) / (myKnots[i + 1] - myKnots[i]);
+	}
+
+	template <typename Value, typename T>
+	bool CubicSpline<Value, T>::IsInSegment(std::size_t aSegment, T aTime) const
+	{
+		// The end segments also cover the times before and after the spline.
+		return
+			(aSegment == 0 || myKnots[aSegment] <= aTime) &&
+			(aSegment + 1 == mySegments.size() || aTime < myKnots[aSegment + 1]);
+	}
+
+	template <typename Value, typename T>
+	template <typename Pack>
+	Pack CubicSpline<Value, T>::EvaluatePack(const Segment& aSegment, std::size_t aComponent, const Pack& anAmount)
+	{
+		const Pack a = Pack::Broadcast(Traits::Get(aSegment.A, aComponent));
+		const Pack b = Pack::Broadcast(Traits::Get(aSegment.B, aComponent));
+		const Pack c = Pack::Broadcast(Traits::Get(aSegment.C, aComponent));
+		const Pack d = Pack::Broadcast(Traits::Get(aSegment.D, aComponent));
+		return ((a * anAmount + b) * anAmount + c) * anAmount + d;
+	}
+}
@@ -252,35 +252,45 @@ namespace RoseCommon::Math
 	template <typename T>
 	constexpr T Sine(T aValue)
 	{
-		const T a = aValue * Math::ReciprocalTwoPiT<T>;
-		aValue -= static_cast<int>(a) * Math::TwoPiT<T>;
-		if (aValue < static_cast<T>(0))
+		if constexpr (requires { _impl::NumberTraits<T>::Sine(aValue); })
 		{
-			aValue += Math::TwoPiT<T>;
-		}
-
-		if (aValue < Math::HalfPiT<T>)
-		{
-			return Hill(Math::HalfPiT<T> - aValue);
-		}
-		else if (aValue < Math::PiT<T>)
-		{
-			return Hill(aValue - Math::HalfPiT<T>);
-		}
-		else if (aValue < static_cast<T>(3) * Math::HalfPiT<T>)
-		{
-			return -Hill((static_cast<T>(3) * Math::HalfPiT<T>) - aValue);
+			return _impl::NumberTraits<T>::Sine(aValue);
 		}
 		else
 		{
-			return -Hill(aValue - (static_cast<T>(3) * Math::HalfPiT<T>));
+			const T a = aValue * Math::ReciprocalTwoPiT<T>;
+			aValue -= static_cast<int>(a) * Math::TwoPiT<T>;
+			if (aValue < static_cast<T>(0))
+			{
+				aValue += Math::TwoPiT<T>;
+			}
+
+			if (aValue < Math::HalfPiT<T>)
+			{
+				return Hill(Math::HalfPiT<T> - aValue);
+			}
+			else if (aValue < Math::PiT<T>)
+			{
+				return Hill(aValue - Math::HalfPiT<T>);
+			}
+			else if (aValue < static_cast<T>(3) * Math::HalfPiT<T>)
+			{
+				return -Hill((static_cast<T>(3) * Math::HalfPiT<T>) - aValue);
+			}
+			else
+			{
+				return -Hill(aValue - (static_cast<T>(3) * Math::HalfPiT<T>));
+			}
 		}
 	}
 
 	template <typename T>
 	constexpr T Cosine(T aValue)
 	{
-		return Sine(aValue + Math::HalfPiT<T>);
+		if constexpr (requires { _impl::NumberTraits<T>::Cosine(aValue); })
+			return _impl::NumberTraits<T>::Cosine(aValue);
+		else
+			return Sine(aValue + Math::HalfPiT<T>);
 	}
 
 	template <typename T>
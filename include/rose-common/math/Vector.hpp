@@ -4,6 +4,7 @@
 #include "Curve.hpp"
 #include "Matrix.hpp"
 #include "Trigonometry.hpp"
+#include "VectorTraits.hpp"
 
 namespace RoseCommon::Math
 {
@@ -919,6 +920,36 @@ namespace RoseCommon::Math
 
 		#pragma endregion
 	};
+
+	namespace _impl
+	{
+		template <typename T>
+		struct VectorTraits<Vector2<T>>
+		{
+			using Component = T;
+			static constexpr std::size_t Count = 2;
+			static constexpr T Get(const Vector2<T>& aVector, std::size_t anIndex) { return anIndex == 0 ? aVector.X : aVector.Y; }
+			static constexpr void Set(Vector2<T>& aVector, std::size_t anIndex, T aComponent) { (anIndex == 0 ? aVector.X : aVector.Y) = aComponent; }
+		};
+
+		template <typename T>
+		struct VectorTraits<Vector3<T>>
+		{
+			using Component = T;
+			static constexpr std::size_t Count = 3;
+			static constexpr T Get(const Vector3<T>& aVector, std::size_t anIndex) { return anIndex == 0 ? aVector.X : (anIndex == 1 ? aVector.Y : aVector.Z); }
+			static constexpr void Set(Vector3<T>& aVector, std::size_t anIndex, T aComponent) { (anIndex == 0 ? aVector.X : (anIndex == 1 ? aVector.Y : aVector.Z)) = aComponent; }
+		};
+
+		template <typename T>
+		struct VectorTraits<Vector4<T>>
+		{
+			using Component = T;
+			static constexpr std::size_t Count = 4;
+			static constexpr T Get(const Vector4<T>& aVector, std::size_t anIndex) { return anIndex == 0 ? aVector.X : (anIndex == 1 ? aVector.Y : (anIndex == 2 ? aVector.Z : aVector.W)); }
+			static constexpr void Set(Vector4<T>& aVector, std::size_t anIndex, T aComponent) { (anIndex == 0 ? aVector.X : (anIndex == 1 ? aVector.Y : (anIndex == 2 ? aVector.Z : aVector.W))) = aComponent; }
+		};
+	}
 }
 
 namespace RoseCommon::Math
@@ -1047,8 +1078,8 @@ namespace RoseCommon::Math
 		const T dotProduct = Dot(aVector, aNormal);
 
 		return Vector2(
-			aVector.X - (2.0f * aNormal.X) * dotProduct,
-			aVector.Y - (2.0f * aNormal.Y) * dotProduct
+			aVector.X - (T(2) * aNormal.X) * dotProduct,
+			aVector.Y - (T(2) * aNormal.Y) * dotProduct
 		);
 	}
 
@@ -1194,7 +1225,7 @@ namespace RoseCommon::Math
 		if (aValue1 == aValue2)
 			return aValue1;
 
-		const T dot = Math::Clamp(Dot(aValue1, aValue2), -1.f, 1.f);
+		const T dot = Math::Clamp(Dot(aValue1, aValue2), T(-1), T(1));
 		const T theta = Math::ArcCosine(dot) * anAmount;
 		Vector3 relativeVector = aValue2 - (aValue1 * dot);
 		relativeVector.Normalize();
@@ -1226,9 +1257,9 @@ namespace RoseCommon::Math
 	{
 		Vector3 result;
 		const T dotProduct = Dot(aVector, aNormal);
-		result.X = aVector.X - (2.0f * aNormal.X) * dotProduct;
-		result.Y = aVector.Y - (2.0f * aNormal.Y) * dotProduct;
-		result.Z = aVector.Z - (2.0f * aNormal.Z) * dotProduct;
+		result.X = aVector.X - (T(2) * aNormal.X) * dotProduct;
+		result.Y = aVector.Y - (T(2) * aNormal.Y) * dotProduct;
+		result.Z = aVector.Z - (T(2) * aNormal.Z) * dotProduct;
 		return result;
 	}
 
@@ -1248,7 +1279,7 @@ namespace RoseCommon::Math
 
 	template <typename T>
 	constexpr Vector4<T>::Vector4()
-		: Vector4(0, 0, 0)
+		: Vector4(0, 0, 0, 0)
 	{
 
 	}
@@ -0,0 +1,451 @@
+#pragma once
+
+#include "Common.hpp"
+#include "Matrix.hpp"
+#include "Vector.hpp"
+
+#include "../Parallel.hpp"
+#include "../Simd.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <limits>
+#include <span>
+#include <stdexcept>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+/*
+ * Reductions and prefix sums over spans of scalars, Vector2, Vector3 or Vector4.
+ *
+ * Large spans are split into blocks of a fixed size, which are reduced concurrently and then combined pairwise in a fixed tree.
+ * Within a block, components are accumulated in a fixed number of lanes regardless of the SIMD width of the target.
+ * Floating-point results therefore only depend on the input, and not on the thread count, scheduling or instruction set,
+ * though they can differ in the last bits from a plain loop over the elements.
+ */
+namespace RoseCommon::Math
+{
+	/**
+	 * @brief Find the smallest value of each component.
+	 * @param someVectors The vectors to search.
+	 * @return The component-wise minimum, or the highest representable value if there are no vectors.
+	 */
+	template <typename Vector>
+	Vector Minimum(std::span<const Vector> someVectors);
+
+	/**
+	 * @brief Find the largest value of each component.
+	 * @param someVectors The vectors to search.
+	 * @return The component-wise maximum, or the lowest representable value if there are no vectors.
+	 */
+	template <typename Vector>
+	Vector Maximum(std::span<const Vector> someVectors);
+
+	/**
+	 * @brief Find the smallest and largest value of each component in a single pass, such as for the bounding box of points.
+	 * @param someVectors The vectors to search.
+	 * @return The component-wise minimum and maximum, which are inverted if there are no vectors.
+	 */
+	template <typename Vector>
+	std::pair<Vector, Vector> Bounds(std::span<const Vector> someVectors);
+
+	/**
+	 * @brief Add up all vectors.
+	 * @param someVectors The vectors to add up.
+	 * @return The sum, which is zero if there are no vectors.
+	 */
+	template <typename Vector>
+	Vector Sum(std::span<const Vector> someVectors);
+
+	/**
+	 * @brief Calculate the average of all vectors, such as the centroid of points.
+	 * @param someVectors The vectors to average, of which there must be at least one.
+	 * @return The mean.
+	 */
+	template <typename Vector>
+	Vector Mean(std::span<const Vector> someVectors);
+
+	/**
+	 * @brief Calculate the weighted average of all vectors.
+	 * @param someVectors The vectors to average.
+	 * @param someWeights The weight of each vector, which may not sum to zero.
+	 * @return The weighted mean.
+	 */
+	template <typename Vector>
+	Vector WeightedMean(std::span<const Vector> someVectors, std::span<const typename _impl::VectorTraits<Vector>::Component> someWeights);
+
+	/**
+	 * @brief Calculate the population covariance between each pair of components, such as for fitting an oriented box to points.
+	 * @param someVectors The vectors to calculate the covariance of, of which there must be at least one.
+	 * @return A symmetric matrix with the covariance between components at the column and row of their indices, and the variance along the diagonal.
+	 */
+	template <typename Vector>
+	Matrix<_impl::VectorTraits<Vector>::Count, _impl::VectorTraits<Vector>::Count, typename _impl::VectorTraits<Vector>::Component> Covariance(std::span<const Vector> someVectors);
+
+	/**
+	 * @brief Calculate the running sum of vectors, where each result includes the vector at its own index.
+	 * @param someVectors The vectors to add up.
+	 * @param outSums A buffer at least as large as the input, receiving the sums. May be the same memory as the input.
+	 */
+	template <typename Vector>
+	void InclusiveScan(std::span<const Vector> someVectors, std::span<Vector> outSums);
+
+	/**
+	 * @brief Calculate the running sum of vectors, where each result only includes the vectors before its own index.
+	 * @param someVectors The vectors to add up.
+	 * @param outSums A buffer at least as large as the input, receiving the sums. May be the same memory as the input.
+	 */
+	template <typename Vector>
+	void ExclusiveScan(std::span<const Vector> someVectors, std::span<Vector> outSums);
+}
+
+namespace RoseCommon::Math
+{
+	namespace _impl
+	{
+		// Elements per block. Fixed rather than derived from the thread count, so that the grouping of operations doesn't change between machines.
+		constexpr std::size_t ReductionBlockSize = 1 << 14;
+
+		// Lanes each component is accumulated in. Fixed rather than the native pack width, so that every target adds in the same order.
+		constexpr std::size_t ReductionLaneCount = 8;
+
+		template <typename Vector>
+		const typename VectorTraits<Vector>::Component* GetComponents(std::span<const Vector> someVectors)
+		{
+			static_assert(sizeof(Vector) == sizeof(typename VectorTraits<Vector>::Component) * VectorTraits<Vector>::Count, "Vectors need to be tightly packed components.");
+			return reinterpret_cast<const typename VectorTraits<Vector>::Component*>(someVectors.data());
+		}
+
+		template <typename Vector>
+		Vector MakeVector(const std::array<typename VectorTraits<Vector>::Component, VectorTraits<Vector>::Count>& someComponents)
+		{
+			Vector vector;
+			for (std::size_t i = 0; i < VectorTraits<Vector>::Count; ++i)
+				VectorTraits<Vector>::Set(vector, i, someComponents[i]);
+			return vector;
+		}
+
+		template <typename Pack, std::size_t Count, typename T>
+		std::array<Pack, Count> BroadcastPacks(T aValue)
+		{
+			return [&]<std::size_t... Indices>(std::index_sequence<Indices...>)
+			{
+				return std::array<Pack, Count>{ ((void)Indices, Pack::Broadcast(aValue))... };
+			}(std::make_index_sequence<Count>());
+		}
+
+		// Reduce fixed-size blocks of elements concurrently, then combine the block results pairwise in a fixed tree.
+		template <typename Result, typename BlockFunction, typename CombineFunction>
+		Result ReduceBlocks(std::size_t aCount, BlockFunction&& aBlockFunction, CombineFunction&& aCombineFunction)
+		{
+			const std::size_t blockCount = std::max<std::size_t>((aCount + ReductionBlockSize - 1) / ReductionBlockSize, 1);
+			if (blockCount == 1)
+				return aBlockFunction(std::size_t(0), aCount);
+
+			std::vector<Result> blockResults(blockCount);
+			Parallel::ForEachChunk(blockCount, Parallel::GetChunkCount(blockCount, 4), [&](std::size_t, std::size_t aBegin, std::size_t anEnd)
+			{
+				for (std::size_t i = aBegin; i < anEnd; ++i)
+					blockResults[i] = aBlockFunction(i * ReductionBlockSize, std::min((i + 1) * ReductionBlockSize, aCount));
+			});
+
+			for (std::size_t stride = 1; stride < blockCount; stride *= 2)
+			{
+				for (std::size_t i = 0; i + stride < blockCount; i += stride * 2)
+					blockResults[i] = aCombineFunction(blockResults[i], blockResults[i + stride]);
+			}
+
+			return blockResults[0];
+		}
+
+		/**
+		 * @brief Fold tightly packed vectors into one value per component, for each of several operations in a single pass.
+		 *        Each step reads ReductionLaneCount vectors as rows of ReductionLaneCount components, the component at flat position i being i % Count.
+		 *        Each row has an accumulator per operation, which are folded into the per-component results in order at the end.
+		 * @param someOperations Generic functions taking and returning two packs of the same type.
+		 */
+		template <std::size_t Count, typename T, typename... Operations>
+		std::array<std::array<T, Count>, sizeof...(Operations)> FoldComponents(const T* someComponents, std::size_t aVectorCount, const std::array<T, sizeof...(Operations)>& someIdentities, const Operations&... someOperations)
+		{
+			using Pack = Simd::NativePack<T>;
+			static_assert(ReductionLaneCount % Pack::Width == 0, "The lane count needs to be a multiple of the pack width.");
+
+			constexpr std::size_t operationCount = sizeof...(Operations);
+			constexpr std::size_t stepSize = Count * ReductionLaneCount;
+			constexpr std::size_t packCount = stepSize / Pack::Width;
+
+			const std::tuple<const Operations&...> operations(someOperations...);
+
+			auto accumulators = [&]<std::size_t... Indices>(std::index_sequence<Indices...>)
+			{
+				return std::array<std::array<Pack, packCount>, operationCount>{ BroadcastPacks<Pack, packCount>(someIdentities[Indices])... };
+			}(std::make_index_sequence<operationCount>());
+
+			const std::size_t stepCount = aVectorCount / ReductionLaneCount;
+			for (std::size_t step = 0; step < stepCount; ++step)
+			{
+				const T* components = someComponents + step * stepSize;
+				Unroll<packCount>([&](auto aPack)
+				{
+					const Pack values = Pack::Load(components + aPack * Pack::Width);
+					Unroll<operationCount>([&](auto anOperation)
+					{
+						accumulators[anOperation][aPack] = std::get<anOperation>(operations)(accumulators[anOperation][aPack], values);
+					});
+				});
+			}
+
+			std::array<std::array<T, Count>, operationCount> results;
+			Unroll<operationCount>([&](auto anOperation)
+			{
+				const auto& operation = std::get<anOperation>(operations);
+
+				std::array<T, stepSize> lanes;
+				for (std::size_t i = 0; i < packCount; ++i)
+					accumulators[anOperation][i].Store(lanes.data() + i * Pack::Width);
+
+				std::array<Simd::ScalarPack<T>, Count> result = BroadcastPacks<Simd::ScalarPack<T>, Count>(someIdentities[anOperation]);
+
+				for (std::size_t i = 0; i < stepSize; ++i)
+					result[i % Count] = operation(result[i % Count], Simd::ScalarPack<T>(lanes[i]));
+
+				for (std::size_t i = stepCount * stepSize; i < aVectorCount * Count; ++i)
+					result[i % Count] = operation(result[i % Count], Simd::ScalarPack<T>(someComponents[i]));
+
+				for (std::size_t i = 0; i < Count; ++i)
+					result[i].Store(&results[anOperation][i]);
+			});
+
+			return results;
+		}
+
+		constexpr auto MinimumOperation = []<typename Pack>(const Pack& aPack1, const Pack& aPack2) { return Pack::Min(aPack1, aPack2); };
+		constexpr auto MaximumOperation = []<typename Pack>(const Pack& aPack1, const Pack& aPack2) { return Pack::Max(aPack1, aPack2); };
+		constexpr auto SumOperation = []<typename Pack>(const Pack& aPack1, const Pack& aPack2) { return aPack1 + aPack2; };
+
+		// Sum fixed-size blocks, in the same way as Sum(), for the offsets of the scans.
+		template <typename Vector>
+		Vector SumBlock(std::span<const Vector> someVectors)
+		{
+			using Traits = VectorTraits<Vector>;
+			return MakeVector<Vector>(FoldComponents<Traits::Count>(GetComponents(someVectors), someVectors.size(), { typename Traits::Component(0) }, SumOperation)[0]);
+		}
+
+		template <bool IsInclusive, typename Vector>
+		void Scan(std::span<const Vector> someVectors, std::span<Vector> outSums)
+		{
+			if (outSums.size() < someVectors.size())
+				throw std::invalid_argument("The output buffer needs to be at least as large as the input.");
+
+			const std::size_t count = someVectors.size();
+			const std::size_t blockCount = (count + ReductionBlockSize - 1) / ReductionBlockSize;
+			if (blockCount == 0)
+				return;
+
+			const auto scanBlock = [&](std::size_t aBlock, Vector aSum)
+			{
+				const std::size_t end = std::min((aBlock + 1) * ReductionBlockSize, count);
+				for (std::size_t i = aBlock * ReductionBlockSize; i < end; ++i)
+				{
+					// Read before writing, in case the output is the input.
+					const Vector value = someVectors[i];
+					if constexpr (IsInclusive)
+					{
+						aSum += value;
+						outSums[i] = aSum;
+					}
+					else
+					{
+						outSums[i] = aSum;
+						aSum += value;
+					}
+				}
+			};
+
+			if (blockCount == 1)
+			{
+				scanBlock(0, Vector());
+				return;
+			}
+
+			// Sum each block, turn those into the offset each block starts at, then scan the blocks from their offsets.
+			std::vector<Vector> blockOffsets(blockCount);
+			const std::size_t chunkCount = Parallel::GetChunkCount(blockCount, 4);
+
+			Parallel::ForEachChunk(blockCount, chunkCount, [&](std::size_t, std::size_t aBegin, std::size_t anEnd)
+			{
+				for (std::size_t i = aBegin; i < anEnd; ++i)
+					blockOffsets[i] = SumBlock(someVectors.subspan(i * ReductionBlockSize, std::min(ReductionBlockSize, count - i * ReductionBlockSize)));
+			});
+
+			Vector offset;
+			for (Vector& blockOffset : blockOffsets)
+			{
+				const Vector blockSum = blockOffset;
+				blockOffset = offset;
+				offset += blockSum;
+			}
+
+			Parallel::ForEachChunk(blockCount, chunkCount, [&](std::size_t, std::size_t aBegin, std::size_t anEnd)
+			{
+				for (std::size_t i = aBegin; i < anEnd; ++i)
+					scanBlock(i, blockOffsets[i]);
+			});
+		}
+	}
+
+	template <typename Vector>
+	Vector Minimum(std::span<const Vector> someVectors)
+	{
+		return Bounds(someVectors).first;
+	}
+
+	template <typename Vector>
+	Vector Maximum(std::span<const Vector> someVectors)
+	{
+		return Bounds(someVectors).second;
+	}
+
+	template <typename Vector>
+	std::pair<Vector, Vector> Bounds(std::span<const Vector> someVectors)
+	{
+		using Traits = _impl::VectorTraits<Vector>;
+		using T = typename Traits::Component;
+
+		const T* components = _impl::GetComponents(someVectors);
+		const auto bounds = _impl::ReduceBlocks<std::pair<Vector, Vector>>(someVectors.size(),
+			[&](std::size_t aBegin, std::size_t anEnd)
+			{
+				const auto result = _impl::FoldComponents<Traits::Count>(components + aBegin * Traits::Count, anEnd - aBegin,
+					{ std::numeric_limits<T>::max(), std::numeric_limits<T>::lowest() }, _impl::MinimumOperation, _impl::MaximumOperation);
+				return std::pair<Vector, Vector>(_impl::MakeVector<Vector>(result[0]), _impl::MakeVector<Vector>(result[1]));
+			},
+			[](const std::pair<Vector, Vector>& aBounds, const std::pair<Vector, Vector>& anOther)
+			{
+				std::pair<Vector, Vector> combined;
+				for (std::size_t i = 0; i < Traits::Count; ++i)
+				{
+					Traits::Set(combined.first, i, Math::Min<T>(Traits::Get(aBounds.first, i), Traits::Get(anOther.first, i)));
+					Traits::Set(combined.second, i, Math::Max<T>(Traits::Get(aBounds.second, i), Traits::Get(anOther.second, i)));
+				}
+				return combined;
+			}
+		);
+
+		return bounds;
+	}
+
+	template <typename Vector>
+	Vector Sum(std::span<const Vector> someVectors)
+	{
+		return _impl::ReduceBlocks<Vector>(someVectors.size(),
+			[&](std::size_t aBegin, std::size_t anEnd) { return _impl::SumBlock(someVectors.subspan(aBegin, anEnd - aBegin)); },
+			[](const Vector& aSum, const Vector& anOther) { return aSum + anOther; }
+		);
+	}
+
+	template <typename Vector>
+	Vector Mean(std::span<const Vector> someVectors)
+	{
+		if (someVectors.empty())
+			throw std::invalid_argument("The mean of no vectors is undefined.");
+
+		return Sum(someVectors) / Vector(static_cast<typename _impl::VectorTraits<Vector>::Component>(someVectors.size()));
+	}
+
+	template <typename Vector>
+	Vector WeightedMean(std::span<const Vector> someVectors, std::span<const typename _impl::VectorTraits<Vector>::Component> someWeights)
+	{
+		using T = typename _impl::VectorTraits<Vector>::Component;
+
+		if (someWeights.size() != someVectors.size())
+			throw std::invalid_argument("There needs to be one weight per vector.");
+
+		const auto [weightedSum, weightSum] = _impl::ReduceBlocks<std::pair<Vector, T>>(someVectors.size(),
+			[&](std::size_t aBegin, std::size_t anEnd)
+			{
+				std::pair<Vector, T> sums(Vector(), T(0));
+				for (std::size_t i = aBegin; i < anEnd; ++i)
+				{
+					sums.first += someVectors[i] * Vector(someWeights[i]);
+					sums.second += someWeights[i];
+				}
+				return sums;
+			},
+			[](const std::pair<Vector, T>& aSums, const std::pair<Vector, T>& anOther)
+			{
+				return std::pair<Vector, T>(aSums.first + anOther.first, aSums.second + anOther.second);
+			}
+		);
+
+		if (weightSum == T(0))
+			throw std::invalid_argument("The weights sum to zero.");
+
+		return weightedSum / Vector(weightSum);
+	}
+
+	template <typename Vector>
+	Matrix<_impl::VectorTraits<Vector>::Count, _impl::VectorTraits<Vector>::Count, typename _impl::VectorTraits<Vector>::Component> Covariance(std::span<const Vector> someVectors)
+	{
+		using Traits = _impl::VectorTraits<Vector>;
+		using T = typename Traits::Component;
+		constexpr std::size_t count = Traits::Count;
+
+		const Vector mean = Mean(someVectors);
+
+		// Only the upper triangle is summed, the rest mirrors it.
+		using Products = std::array<T, count * count>;
+		const Products products = _impl::ReduceBlocks<Products>(someVectors.size(),
+			[&](std::size_t aBegin, std::size_t anEnd)
+			{
+				Products sums{ };
+				for (std::size_t i = aBegin; i < anEnd; ++i)
+				{
+					const Vector offset = someVectors[i] - mean;
+					_impl::Unroll<count * count>([&](auto anIndex)
+					{
+						constexpr std::size_t row = anIndex / count;
+						constexpr std::size_t column = anIndex % count;
+						if constexpr (column >= row)
+							sums[anIndex] += Traits::Get(offset, row) * Traits::Get(offset, column);
+					});
+				}
+				return sums;
+			},
+			[](const Products& someSums, const Products& someOthers)
+			{
+				Products sums;
+				for (std::size_t i = 0; i < count * count; ++i)
+					sums[i] = someSums[i] + someOthers[i];
+				return sums;
+			}
+		);
+
+		Matrix<count, count, T> covariance;
+		for (std::size_t row = 0; row < count; ++row)
+		{
+			for (std::size_t column = row; column < count; ++column)
+			{
+				const T value = products[row * count + column] / static_cast<T>(someVectors.size());
+				covariance.GetCell(column, row) = value;
+				covariance.GetCell(row, column) = value;
+			}
+		}
+
+		return covariance;
+	}
+
+	template <typename Vector>
+	void InclusiveScan(std::span<const Vector> someVectors, std::span<Vector> outSums)
+	{
+		_impl::Scan<true>(someVectors, outSums);
+	}
+
+	template <typename Vector>
+	void ExclusiveScan(std::span<const Vector> someVectors, std::span<Vector> outSums)
+	{
+		_impl::Scan<false>(someVectors, outSums);
+	}
+}
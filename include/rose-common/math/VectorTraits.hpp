@@ -0,0 +1,22 @@
+#pragma once
+
+#include <cstddef>
+
+namespace RoseCommon::Math
+{
+	namespace _impl
+	{
+		/**
+		 * @brief Uniform access to the components of scalars and vectors by index, for algorithms written once for all of them.
+		 *        Scalars are treated as single-component vectors.
+		 */
+		template <typename V>
+		struct VectorTraits
+		{
+			using Component = V;
+			static constexpr std::size_t Count = 1;
+			static constexpr Component Get(const V& aValue, std::size_t) { return aValue; }
+			static constexpr void Set(V& aValue, std::size_t, Component aComponent) { aValue = aComponent; }
+		};
+	}
+}
@@ -0,0 +1,464 @@
+#include "../include/rose-common/JobSystem.hpp"
+
+#include "../include/rose-common/Debug.hpp"
+#include "../include/rose-common/Profiling.hpp"
+
+#include <algorithm>
+#include <string>
+#include <thread>
+
+#if defined(_WIN32)
+#include <Windows.h>
+#elif defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define ROSECOMMON_JOBSYSTEM_PAUSE() _mm_pause()
+#else
+#define ROSECOMMON_JOBSYSTEM_PAUSE() std::this_thread::yield()
+#endif
+
+namespace RoseCommon::Parallel
+{
+	namespace _impl
+	{
+		struct Job
+		{
+			std::function<void()> Function;
+			std::exception_ptr Exception;
+
+			// Keeps the job alive while it's queued, since the queues only hold plain pointers.
+			std::shared_ptr<Job> Self;
+
+			// One for each unfinished dependency, plus one held while scheduling so the job can't start before all of them are added.
+			std::atomic<std::uint32_t> PendingCount = 1;
+
+			std::mutex DependentsMutex;
+			std::vector<Job*> Dependents;
+			std::atomic_bool IsFinished = false;
+
+			// The number of threads sleeping in Wait() until the job finishes, which it wakes up when it does.
+			std::atomic<std::uint32_t> WaiterCount = 0;
+		};
+
+		/**
+		 * @brief A Chase-Lev work-stealing deque, as formulated for weak memory models by Le, Pop, Cohen and Zappa Nardelli.
+		 *        The owning worker pushes and pops at the bottom without locking, while other threads steal from the top.
+		 */
+		class WorkStealingQueue
+		{
+		public:
+			WorkStealingQueue()
+				: myTop(0)
+				, myBottom(0)
+			{
+				myBuffers.push_back(std::make_unique<Buffer>(256));
+				myBuffer.store(myBuffers.back().get(), std::memory_order_relaxed);
+			}
+
+			void Push(Job* aJob)
+			{
+				const std::int64_t bottom = myBottom.load(std::memory_order_relaxed);
+				const std::int64_t top = myTop.load(std::memory_order_acquire);
+				Buffer* buffer = myBuffer.load(std::memory_order_relaxed);
+
+				if (bottom - top > buffer->Mask)
+					buffer = Grow(buffer, top, bottom);
+
+				buffer->Put(bottom, aJob);
+				myBottom.store(bottom + 1, std::memory_order_release);
+			}
+
+			Job* Pop()
+			{
+				const std::int64_t bottom = myBottom.load(std::memory_order_relaxed) - 1;
+				Buffer* buffer = myBuffer.load(std::memory_order_relaxed);
+				myBottom.store(bottom, std::memory_order_relaxed);
+				std::atomic_thread_fence(std::memory_order_seq_cst);
+				std::int64_t top = myTop.load(std::memory_order_relaxed);
+
+				if (top > bottom)
+				{
+					myBottom.store(bottom + 1, std::memory_order_relaxed);
+					return nullptr;
+				}
+
+				Job* job = buffer->Get(bottom);
+				if (top == bottom)
+				{
+					// The last job, which a thief may be taking at the same time.
+					if (!myTop.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+						job = nullptr;
+
+					myBottom.store(bottom + 1, std::memory_order_relaxed);
+				}
+
+				return job;
+			}
+
+			Job* Steal()
+			{
+				std::int64_t top = myTop.load(std::memory_order_acquire);
+				std::atomic_thread_fence(std::memory_order_seq_cst);
+				const std::int64_t bottom = myBottom.load(std::memory_order_acquire);
+
+				if (top >= bottom)
+					return nullptr;
+
+				Job* job = myBuffer.load(std::memory_order_acquire)->Get(top);
+				if (!myTop.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+					return nullptr;
+
+				return job;
+			}
+
+		private:
+			struct Buffer
+			{
+				explicit Buffer(std::int64_t aCapacity)
+					: Mask(aCapacity - 1)
+					, Items(std::make_unique<std::atomic<Job*>[]>(static_cast<std::size_t>(aCapacity)))
+				{ }
+
+				Job* Get(std::int64_t anIndex) const { return Items[anIndex & Mask].load(std::memory_order_relaxed); }
+				void Put(std::int64_t anIndex, Job* aJob) { Items[anIndex & Mask].store(aJob, std::memory_order_relaxed); }
+
+				std::int64_t Mask;
+				std::unique_ptr<std::atomic<Job*>[]> Items;
+			};
+
+			Buffer* Grow(Buffer* aBuffer, std::int64_t aTop, std::int64_t aBottom)
+			{
+				// Thieves may still be reading the old buffer, so it's kept until the queue is destroyed.
+				std::unique_ptr<Buffer>& grown = myBuffers.emplace_back(std::make_unique<Buffer>((aBuffer->Mask + 1) * 2));
+				for (std::int64_t i = aTop; i < aBottom; ++i)
+					grown->Put(i, aBuffer->Get(i));
+
+				myBuffer.store(grown.get(), std::memory_order_release);
+				return grown.get();
+			}
+
+			alignas(64) std::atomic<std::int64_t> myTop;
+			alignas(64) std::atomic<std::int64_t> myBottom;
+			std::atomic<Buffer*> myBuffer;
+			std::vector<std::unique_ptr<Buffer>> myBuffers;
+		};
+
+		struct Worker
+		{
+			WorkStealingQueue Queue;
+			std::thread Thread;
+		};
+
+		// Spins with twice as many pause instructions each time, then yields to other threads.
+		class Backoff
+		{
+		public:
+			void Reset() { myRound = 0; }
+
+			bool IsExhausted() const { return myRound > ourYieldRounds; }
+
+			void Idle()
+			{
+				if (myRound <= ourSpinRounds)
+				{
+					for (std::uint32_t i = 0; i < (1u << myRound); ++i)
+						ROSECOMMON_JOBSYSTEM_PAUSE();
+				}
+				else
+				{
+					std::this_thread::yield();
+				}
+
+				++myRound;
+			}
+
+		private:
+			static constexpr std::uint32_t ourSpinRounds = 6;
+			static constexpr std::uint32_t ourYieldRounds = ourSpinRounds + 4;
+
+			std::uint32_t myRound = 0;
+		};
+
+		struct CurrentWorker
+		{
+			JobSystem* System = nullptr;
+			std::size_t Index = 0;
+			std::uint32_t RandomState = 0;
+		};
+
+		static thread_local CurrentWorker ourCurrentWorker;
+
+		static void PinCurrentThread(std::size_t aCoreIndex)
+		{
+			const std::size_t coreCount = std::max<std::size_t>(std::thread::hardware_concurrency(), 1);
+#if defined(_WIN32)
+			SetThreadAffinityMask(GetCurrentThread(), DWORD_PTR(1) << (aCoreIndex % std::min<std::size_t>(coreCount, sizeof(DWORD_PTR) * 8)));
+#elif defined(__linux__)
+			cpu_set_t cpuSet;
+			CPU_ZERO(&cpuSet);
+			CPU_SET(aCoreIndex % std::min<std::size_t>(coreCount, CPU_SETSIZE), &cpuSet);
+			pthread_setaffinity_np(pthread_self(), sizeof(cpuSet), &cpuSet);
+#else
+			(void)aCoreIndex;
+			(void)coreCount;
+#endif
+		}
+	}
+
+	bool JobHandle::IsDone() const
+	{
+		return !myJob || myJob->IsFinished.load(std::memory_order_acquire);
+	}
+
+	JobSystem::JobSystem(std::size_t aWorkerCount, bool aShouldPinWorkers)
+		: myInjectionCount(0)
+		, myWorkEpoch(0)
+		, mySleepingCount(0)
+		, myIsStopping(false)
+	{
+		for (std::size_t i = 0; i < aWorkerCount; ++i)
+			myWorkers.push_back(std::make_unique<_impl::Worker>());
+
+		// Start the threads only once every queue exists, since they steal from each other right away.
+		for (std::size_t i = 0; i < aWorkerCount; ++i)
+			myWorkers[i]->Thread = std::thread([this, i, aShouldPinWorkers]() { WorkerLoop(i, aShouldPinWorkers); });
+	}
+
+	JobSystem::~JobSystem()
+	{
+		{
+			std::lock_guard lock(mySleepMutex);
+			myIsStopping = true;
+		}
+		mySleepCondition.notify_all();
+
+		for (std::unique_ptr<_impl::Worker>& worker : myWorkers)
+			worker->Thread.join();
+	}
+
+	JobSystem& JobSystem::GetDefault()
+	{
+		static JobSystem ourDefault(std::max<std::size_t>(std::thread::hardware_concurrency(), 2) - 1);
+		return ourDefault;
+	}
+
+	JobHandle JobSystem::Schedule(std::function<void()> aFunction, std::span<const JobHandle> someDependencies)
+	{
+		std::shared_ptr<_impl::Job> job = std::make_shared<_impl::Job>();
+		job->Function = std::move(aFunction);
+		job->Self = job;
+
+		for (const JobHandle& dependency : someDependencies)
+		{
+			if (!dependency.myJob)
+				continue;
+
+			_impl::Job& dependencyJob = *dependency.myJob;
+			std::lock_guard lock(dependencyJob.DependentsMutex);
+			if (!dependencyJob.IsFinished.load(std::memory_order_relaxed))
+			{
+				job->PendingCount.fetch_add(1, std::memory_order_relaxed);
+				dependencyJob.Dependents.push_back(job.get());
+			}
+		}
+
+		if (job->PendingCount.fetch_sub(1, std::memory_order_acq_rel) == 1)
+			Enqueue(job.get());
+
+		return JobHandle(std::move(job));
+	}
+
+	void JobSystem::Wait(const JobHandle& aJob)
+	{
+		if (!aJob.myJob)
+			return;
+
+		_impl::Job& waitedJob = *aJob.myJob;
+		_impl::Backoff backoff;
+		while (!aJob.IsDone())
+		{
+			const std::uint64_t epoch = myWorkEpoch.load();
+			if (_impl::Job* job = FindJob())
+			{
+				Execute(job);
+				backoff.Reset();
+				continue;
+			}
+
+			if (!backoff.IsExhausted())
+			{
+				backoff.Idle();
+				continue;
+			}
+
+			// Sleep until the job finishes, or something is queued after the search above which can be helped with in the meantime.
+			std::unique_lock lock(mySleepMutex);
+			waitedJob.WaiterCount.fetch_add(1);
+			mySleepingCount.fetch_add(1);
+			mySleepCondition.wait(lock, [&]() { return myWorkEpoch.load() != epoch || waitedJob.IsFinished.load(); });
+			mySleepingCount.fetch_sub(1);
+			waitedJob.WaiterCount.fetch_sub(1);
+			backoff.Reset();
+		}
+
+		if (waitedJob.Exception)
+			std::rethrow_exception(waitedJob.Exception);
+	}
+
+	void JobSystem::WorkerLoop(std::size_t aWorkerIndex, bool aShouldPin)
+	{
+		_impl::ourCurrentWorker.System = this;
+		_impl::ourCurrentWorker.Index = aWorkerIndex;
+		_impl::ourCurrentWorker.RandomState = static_cast<std::uint32_t>(aWorkerIndex) * 2654435761u + 1;
+
+		Debug::SetThreadName(("Job worker " + std::to_string(aWorkerIndex)).c_str());
+		if (aShouldPin)
+			_impl::PinCurrentThread(aWorkerIndex + 1);
+
+		_impl::Backoff backoff;
+		while (true)
+		{
+			const std::uint64_t epoch = myWorkEpoch.load();
+			if (_impl::Job* job = FindJob())
+			{
+				Execute(job);
+				backoff.Reset();
+				continue;
+			}
+
+			if (myIsStopping)
+				break;
+
+			if (!backoff.IsExhausted())
+			{
+				backoff.Idle();
+				continue;
+			}
+
+			// Sleep until something is queued after the search above, which Enqueue() signals by changing the epoch.
+			std::unique_lock lock(mySleepMutex);
+			mySleepingCount.fetch_add(1);
+			mySleepCondition.wait(lock, [&]() { return myWorkEpoch.load() != epoch || myIsStopping; });
+			mySleepingCount.fetch_sub(1);
+			backoff.Reset();
+		}
+
+		_impl::ourCurrentWorker = _impl::CurrentWorker();
+	}
+
+	void JobSystem::Enqueue(_impl::Job* aJob)
+	{
+		if (_impl::ourCurrentWorker.System == this)
+		{
+			myWorkers[_impl::ourCurrentWorker.Index]->Queue.Push(aJob);
+		}
+		else
+		{
+			std::lock_guard lock(myInjectionMutex);
+			myInjectionQueue.push_back(aJob);
+			myInjectionCount.fetch_add(1, std::memory_order_release);
+		}
+
+		myWorkEpoch.fetch_add(1);
+		if (mySleepingCount.load() > 0)
+		{
+			std::lock_guard lock(mySleepMutex);
+			mySleepCondition.notify_one();
+		}
+	}
+
+	_impl::Job* JobSystem::FindJob()
+	{
+		_impl::CurrentWorker& current = _impl::ourCurrentWorker;
+		const bool isWorker = current.System == this;
+
+		if (isWorker)
+		{
+			if (_impl::Job* job = myWorkers[current.Index]->Queue.Pop())
+				return job;
+		}
+
+		// Workers take the oldest injected job, while other threads only get here while waiting and take the newest like a worker does from its own queue.
+		// Otherwise a thread waiting on a small job it just scheduled would start on a large one, and nest deeper into waiting for every job it helps with.
+		if (myInjectionCount.load(std::memory_order_acquire) > 0)
+		{
+			std::lock_guard lock(myInjectionMutex);
+			if (!myInjectionQueue.empty())
+			{
+				_impl::Job* job = isWorker ? myInjectionQueue.front() : myInjectionQueue.back();
+				if (isWorker)
+					myInjectionQueue.pop_front();
+				else
+					myInjectionQueue.pop_back();
+				myInjectionCount.fetch_sub(1, std::memory_order_relaxed);
+				return job;
+			}
+		}
+
+		if (myWorkers.empty())
+			return nullptr;
+
+		// Start at a random victim, so thieves don't all go for the same one.
+		if (current.RandomState == 0)
+			current.RandomState = 0x9E3779B9u;
+		current.RandomState ^= current.RandomState << 13;
+		current.RandomState ^= current.RandomState >> 17;
+		current.RandomState ^= current.RandomState << 5;
+		const std::size_t firstVictim = (current.RandomState | 1) % myWorkers.size();
+		for (std::size_t i = 0; i < myWorkers.size(); ++i)
+		{
+			const std::size_t victim = (firstVictim + i) % myWorkers.size();
+			if (isWorker && victim == current.Index)
+				continue;
+
+			if (_impl::Job* job = myWorkers[victim]->Queue.Steal())
+				return job;
+		}
+
+		return nullptr;
+	}
+
+	void JobSystem::Execute(_impl::Job* aJob)
+	{
+		const std::shared_ptr<_impl::Job> job = std::move(aJob->Self);
+
+		{
+			PROFILE_SCOPE_NAMED("Job");
+
+			try
+			{
+				job->Function();
+			}
+			catch (...)
+			{
+				job->Exception = std::current_exception();
+			}
+		}
+
+		job->Function = nullptr;
+
+		std::vector<_impl::Job*> dependents;
+		{
+			std::lock_guard lock(job->DependentsMutex);
+			job->IsFinished.store(true);
+			dependents.swap(job->Dependents);
+		}
+
+		// Checked after marking the job finished, while waiters check that after counting themselves, so one of them always sees the other.
+		if (job->WaiterCount.load() > 0)
+		{
+			std::lock_guard lock(mySleepMutex);
+			mySleepCondition.notify_all();
+		}
+
+		for (_impl::Job* dependent : dependents)
+		{
+			if (dependent->PendingCount.fetch_sub(1, std::memory_order_acq_rel) == 1)
+				Enqueue(dependent);
+		}
+	}
+}
@@ -2,8 +2,10 @@
 #include "../include/rose-common/Profiling_Formatting.hpp"
 
 #include <algorithm>
+#include <atomic>
 #include <functional>
 #include <map>
+#include <mutex>
 #include <vector>
 
 namespace RoseCommon::Profiling
@@ -16,39 +18,53 @@ namespace RoseCommon::Profiling
 			std::function<void(const ProfilingMarker&)> SubmitMarker;
 		};
 
+		// Frames and markers are submitted from any thread, while the nesting level is kept per thread.
+		// The profiler count lets scopes skip collecting anything without locking while nothing is being profiled.
+		static std::mutex ourMutex;
 		static std::map<Profiler*, ActiveProfiler> ourActiveProfilers;
-		static unsigned int ourProfilerLevel = 0;
+		static std::atomic<std::size_t> ourActiveProfilerCount = 0;
+		static thread_local unsigned int ourProfilerLevel = 0;
 
 		void Submit(const ProfilingFrame& aFrame)
 		{
+			std::lock_guard lock(ourMutex);
 			for (auto& activeProfiler : ourActiveProfilers)
 				activeProfiler.second.SubmitFrame(aFrame);
 		}
 
 		void Submit(const ProfilingMarker& aMarker)
 		{
+			std::lock_guard lock(ourMutex);
 			for (auto& activeProfiler : ourActiveProfilers)
 				activeProfiler.second.SubmitMarker(aMarker);
 		}
 	}
 
 	Profiler::FrameSubmitScope::FrameSubmitScope(size_t aUID, const char* aFileAndLine, const char* aFunctionName, const std::optional<std::string>& aLabel)
+		: myIsSubmitting(ProfilerInternal::ourActiveProfilerCount.load(std::memory_order_relaxed) > 0)
 	{
+		ProfilerInternal::ourProfilerLevel += 1;
+
+		if (!myIsSubmitting)
+			return;
+
 		myFrame.StartTime = std::chrono::high_resolution_clock::now();
 
 		myFrame.UID = aUID;
 		myFrame.FileAndLine = aFileAndLine;
 		myFrame.Function = aFunctionName;
+		myFrame.ThreadId = std::this_thread::get_id();
 		myFrame.Label = aLabel.value_or("");
-		myFrame.Level = ProfilerInternal::ourProfilerLevel;
-
-		ProfilerInternal::ourProfilerLevel += 1;
+		myFrame.Level = ProfilerInternal::ourProfilerLevel - 1;
 	}
 
 	Profiler::FrameSubmitScope::~FrameSubmitScope()
 	{
 		ProfilerInternal::ourProfilerLevel -= 1;
 
+		if (!myIsSubmitting)
+			return;
+
 		myFrame.EndTime = std::chrono::high_resolution_clock::now();
 
 		ProfilerInternal::Submit(myFrame);
@@ -56,11 +72,15 @@ namespace RoseCommon::Profiling
 
 	void Profiler::SubmitMarker(const char* aFileAndLine, const char* aFunctionName, const std::string& aLabel)
 	{
+		if (ProfilerInternal::ourActiveProfilerCount.load(std::memory_order_relaxed) == 0)
+			return;
+
 		ProfilingMarker marker;
 		marker.Time = std::chrono::high_resolution_clock::now();
 
 		marker.FileAndLine = aFileAndLine;
 		marker.Function = aFunctionName;
+		marker.ThreadId = std::this_thread::get_id();
 		marker.Label = aLabel;
 
 		ProfilerInternal::Submit(marker);
@@ -93,7 +113,10 @@ namespace RoseCommon::Profiling
 	void Profiler::EndProfile()
 	{
 		myIsProfiling = false;
+
+		std::lock_guard lock(ProfilerInternal::ourMutex);
 		ProfilerInternal::ourActiveProfilers.erase(this);
+		ProfilerInternal::ourActiveProfilerCount.store(ProfilerInternal::ourActiveProfilers.size(), std::memory_order_relaxed);
 		myProfilingDataTarget->EndTime = std::chrono::high_resolution_clock::now();
 	}
 
@@ -109,9 +132,11 @@ namespace RoseCommon::Profiling
 	{
 		myProfilingDataTarget->StartTime = std::chrono::high_resolution_clock::now();
 
+		std::lock_guard lock(ProfilerInternal::ourMutex);
 		ProfilerInternal::ActiveProfiler& activeProfiler = ProfilerInternal::ourActiveProfilers[this];
 		activeProfiler.SubmitFrame = [this](const ProfilingFrame& aFrame) {this->Submit(aFrame); };
 		activeProfiler.SubmitMarker = [this](const ProfilingMarker& aMarker) {this->Submit(aMarker); };
+		ProfilerInternal::ourActiveProfilerCount.store(ProfilerInternal::ourActiveProfilers.size(), std::memory_order_relaxed);
 
 		myIsProfiling = true;
 	}
@@ -161,8 +186,16 @@ namespace RoseCommon::Profiling
 		{
 			aStream << "Total: " << myProfilingData.GetDuration<std::chrono::milliseconds>().count() << " ms\n";
 
-			for (const ProfilingEntry& data : myData)
-				data.ToStream(aStream);
+			// Frames from other threads than the first are listed per thread, each in order of time.
+			const bool hasManyThreads = std::any_of(myData.begin(), myData.end(), [this](const ProfilingEntry& anEntry) { return anEntry.GetThreadId() != myData.front().GetThreadId(); });
+
+			for (std::size_t i = 0; i < myData.size(); ++i)
+			{
+				if (hasManyThreads && (i == 0 || myData[i].GetThreadId() != myData[i - 1].GetThreadId()))
+					aStream << "===[ Thread " << myData[i].GetThreadId() << " ]===============================================\n";
+
+				myData[i].ToStream(aStream);
+			}
 		}
 
 	private:
@@ -192,8 +225,16 @@ namespace RoseCommon::Profiling
 				}
 			}
 
+			std::thread::id GetThreadId() const
+			{
+				return Marker ? Marker->ThreadId : Frame->ThreadId;
+			}
+
 			bool operator<(const ProfilingEntry& aRHV) const
 			{
+				if (GetThreadId() != aRHV.GetThreadId())
+					return GetThreadId() < aRHV.GetThreadId();
+
 				std::chrono::high_resolution_clock::time_point lhvTimePoint;
 				std::chrono::high_resolution_clock::time_point rhvTimePoint;
 